@@ -0,0 +1,241 @@
+ /*
+ * rak3172_bench_classifier.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Microbenchmark for the RAK3172 line classifier.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../src/Parser/rak3172_classifier.h"
+#include "../../src/Parser/rak3172_rx.h"
+
+/** @brief Typical lines received from a module with RUI3 firmware.
+ */
+static const char* _RAK3172_Bench_Lines[] = {
+    "OK",
+    "AT+VER=4.0.5",
+    "AT_BUSY_ERROR",
+    "Restricted_Wait_3000_ms",
+    "+EVT:JOINED",
+    "+EVT:JOIN_FAILED_RX_TIMEOUT",
+    "+EVT:TX_DONE",
+    "+EVT:SEND_CONFIRMED_OK",
+    "+EVT:SEND_CONFIRMED_FAILED(4)",
+    "+EVT:RX_1:-89:4:UNICAST:2:0102030405060708090A0B0C0D0E0F10",
+    "+EVT:RX_B:-101:-3:MULCAST:10:A1B2C3D4",
+    "+EVT:RXP2P RECEIVE TIMEOUT",
+    "+EVT:RXP2P:-30:10:AABBCCDD",
+    "+EVT:LINKCHECK:0:8:1:-62:11",
+    "Current Work Mode: LoRaWAN.",
+};
+
+/** @brief Receive event and the expected result of the receive parser.
+ */
+typedef struct
+{
+    const char* p_Line;                     /**< Received line. */
+    uint8_t Port;                           /**< Expected port. */
+    bool isMulticast;                       /**< Expected cast type. */
+    uint16_t Length;                        /**< Expected payload length. */
+} RAK3172_Bench_Rx_t;
+
+/** @brief Receive events for the parser checks.
+ */
+static const RAK3172_Bench_Rx_t _RAK3172_Bench_Rx[] = {
+    {"+EVT:RX_1:-89:4:UNICAST:2:0102030405060708090A0B0C0D0E0F10",  2,      false,  16},
+    {"+EVT:RX_C:-39:13:MULCAST:200:A1B2",                           200,    true,   2},
+    {"+EVT:RX_B:-101:-3:MULTICAST:10:A1B2C3D4",                     10,     true,   4},
+};
+
+/** @brief Receive events that must be rejected by the receive parser.
+ */
+static const char* const _RAK3172_Bench_RxInvalid[] = {
+    "+EVT:RX_2:-70:8:UNICAST:1:48656",
+    "+EVT:RX_2:-70:8:UNICAST:1:4865XY",
+};
+
+/** @brief          Parse a receive event like the event task.
+ *  @param p_Line   Received line
+ *  @param p_Frame  Pointer to receive frame object
+ *  @return         #true when successful
+ */
+static bool RAK3172_Bench_Parse(const char* p_Line, RAK3172_RxFrame_t* const p_Frame)
+{
+    size_t Offset;
+    size_t Length;
+
+    Offset = 0;
+    Length = strlen(p_Line);
+    memset(&p_Frame->Info, 0, sizeof(RAK3172_RxInfo_t));
+    if(RAK3172_Classifier_Classify(p_Line, Length, &Offset) != RAK_EVENT_RX)
+    {
+        return false;
+    }
+
+    // Skip the receive window.
+    Offset++;
+
+    return RAK3172_Rx_ParseHeader(p_Line, Length, &Offset, &p_Frame->Info) &&
+           RAK3172_Rx_ParsePayload(p_Line, Length, Offset, true, p_Frame);
+}
+
+/** @brief          Classification with the substring cascade used by the event task before the line classifier.
+ *  @param Response Received line
+ *  @return         Line type
+ */
+static RAK3172_Event_t RAK3172_Bench_Cascade(const std::string& Response)
+{
+    if(Response.find("Restricted_Wait") != std::string::npos)
+    {
+        return RAK_EVENT_RESTRICTED;
+    }
+
+    if(Response.find("EVT") == std::string::npos)
+    {
+        return RAK_EVENT_NONE;
+    }
+
+    if(Response.find("JOINED") != std::string::npos)
+    {
+        return RAK_EVENT_JOINED;
+    }
+    else if(Response.find("JOIN_FAILED_RX_TIMEOUT") != std::string::npos)
+    {
+        return RAK_EVENT_JOIN_FAILED;
+    }
+    else if(Response.find("TX_DONE") != std::string::npos)
+    {
+        return RAK_EVENT_TX_DONE;
+    }
+    else if(Response.find("SEND_CONFIRMED_FAILED") != std::string::npos)
+    {
+        return RAK_EVENT_CONFIRMED_FAILED;
+    }
+    else if(Response.find("SEND_CONFIRMED_OK") != std::string::npos)
+    {
+        return RAK_EVENT_CONFIRMED_OK;
+    }
+    else if(Response.find("+EVT:RXP2P RECEIVE TIMEOUT") != std::string::npos)
+    {
+        return RAK_EVENT_P2P_RX_TIMEOUT;
+    }
+    else if(Response.find("RXP2P") != std::string::npos)
+    {
+        return RAK_EVENT_P2P_RX;
+    }
+    else if(Response.find("RX") != std::string::npos)
+    {
+        return RAK_EVENT_RX;
+    }
+
+    return RAK_EVENT_UNKNOWN;
+}
+
+int main(int argc, char** argv)
+{
+    size_t Iterations;
+    size_t Count;
+    size_t Errors;
+    uint32_t Checksum;
+    std::vector<std::string> Strings;
+
+    Iterations = 200000;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    Count = sizeof(_RAK3172_Bench_Lines) / sizeof(_RAK3172_Bench_Lines[0]);
+    for(size_t i = 0; i < Count; i++)
+    {
+        Strings.push_back(_RAK3172_Bench_Lines[i]);
+    }
+
+    // Both implementations must agree on the test lines.
+    Errors = 0;
+    for(size_t i = 0; i < Count; i++)
+    {
+        RAK3172_Event_t Expected = RAK3172_Bench_Cascade(Strings[i]);
+        RAK3172_Event_t Actual = RAK3172_Classifier_Classify(Strings[i].c_str(), Strings[i].length());
+
+        if(Expected != Actual)
+        {
+            printf("Mismatch for '%s': cascade %u, classifier %u\n", Strings[i].c_str(), Expected, Actual);
+            Errors++;
+        }
+    }
+
+    // The receive parser must decode the cast type, the port and the payload.
+    for(const RAK3172_Bench_Rx_t& Rx : _RAK3172_Bench_Rx)
+    {
+        RAK3172_RxFrame_t Frame;
+
+        if((RAK3172_Bench_Parse(Rx.p_Line, &Frame) == false) || (Frame.Info.Port != Rx.Port) ||
+           (Frame.Info.isMulticast != Rx.isMulticast) || (Frame.Info.Length != Rx.Length))
+        {
+            printf("Parser error for '%s'\n", Rx.p_Line);
+            Errors++;
+        }
+    }
+
+    // Odd-length or garbled payloads must not be accepted as a shorter frame.
+    for(const char* p_Line : _RAK3172_Bench_RxInvalid)
+    {
+        RAK3172_RxFrame_t Frame;
+
+        if(RAK3172_Bench_Parse(p_Line, &Frame))
+        {
+            printf("Parser accepted '%s'\n", p_Line);
+            Errors++;
+        }
+    }
+
+    Checksum = 0;
+    auto Start = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        for(size_t i = 0; i < Count; i++)
+        {
+            Checksum += RAK3172_Bench_Cascade(Strings[i]);
+        }
+    }
+    auto Middle = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        for(size_t i = 0; i < Count; i++)
+        {
+            Checksum += RAK3172_Classifier_Classify(Strings[i].c_str(), Strings[i].length());
+        }
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    double Lines = static_cast<double>(Iterations * Count);
+    double Cascade = std::chrono::duration<double, std::nano>(Middle - Start).count() / Lines;
+    double Classifier = std::chrono::duration<double, std::nano>(End - Middle).count() / Lines;
+
+    printf("Lines per run:  %zu\n", Count);
+    printf("Iterations:     %zu\n", Iterations);
+    printf("Cascade:        %.1f ns/line\n", Cascade);
+    printf("Classifier:     %.1f ns/line\n", Classifier);
+    printf("Speedup:        %.2fx\n", Cascade / Classifier);
+    printf("Checksum:       %u\n", static_cast<unsigned int>(Checksum));
+
+    return (Errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+ /*
+ * rak3172_bench_command.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Heap allocation and runtime benchmark for the command formatting.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <new>
+#include <chrono>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rak3172_command.h"
+
+/** @brief Number of heap allocations since the start of the program.
+ */
+static size_t _RAK3172_Bench_Allocations = 0;
+
+void* operator new(size_t Size)
+{
+    void* p_Memory;
+
+    _RAK3172_Bench_Allocations++;
+
+    p_Memory = malloc(Size);
+    if(p_Memory == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p_Memory;
+}
+
+void operator delete(void* p_Memory) noexcept
+{
+    free(p_Memory);
+}
+
+void operator delete(void* p_Memory, size_t) noexcept
+{
+    free(p_Memory);
+}
+
+/** @brief Sink for the formatted commands. Replaces the UART driver.
+ */
+static uint32_t _RAK3172_Bench_Checksum = 0;
+
+/** @brief          Consume a transmitted buffer like the UART driver.
+ *  @param p_Data   Pointer to data
+ *  @param Length   Length of data
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Write(const char* p_Data, size_t Length)
+{
+    _RAK3172_Bench_Checksum += Length + static_cast<uint8_t>(p_Data[0]);
+}
+
+/** @brief          Transmit a command like the previous implementation of the command interface (by value and two writes).
+ *  @param Command  Command string
+ */
+static void __attribute__((noinline)) RAK3172_Bench_SendString(std::string Command)
+{
+    RAK3172_Bench_Write(Command.c_str(), Command.length());
+    RAK3172_Bench_Write("\r\n", 2);
+}
+
+/** @brief          Transmit a command object with a single write.
+ *  @param Command  Command object
+ */
+template<size_t Size>
+static void __attribute__((noinline)) RAK3172_Bench_SendCommand(const RAK3172_CommandBuffer_t<Size>& Command)
+{
+    RAK3172_Bench_Write(Command.Buffer, Command.Length + 2);
+}
+
+/** @brief              Format typical commands with string concatenations.
+ *  @param Frequency    Frequency
+ *  @param p_Key        Pointer to 16 byte key
+ */
+static void RAK3172_Bench_String(uint32_t Frequency, const uint8_t* p_Key)
+{
+    std::string Key;
+    char Buffer[3];
+
+    RAK3172_Bench_SendString("AT+NJS=?");
+    RAK3172_Bench_SendString("AT+PFREQ=" + std::to_string(Frequency));
+    RAK3172_Bench_SendString("AT+JOIN=1:" + std::to_string(true) + ":" + std::to_string(10) + ":" + std::to_string(8));
+
+    for(uint8_t i = 0; i < 16; i++)
+    {
+        sprintf(Buffer, "%02X", p_Key[i]);
+        Key += std::string(Buffer);
+    }
+    RAK3172_Bench_SendString("AT+APPKEY=" + Key);
+}
+
+/** @brief              Format typical commands with the command builder.
+ *  @param Frequency    Frequency
+ *  @param p_Key        Pointer to 16 byte key
+ */
+static void RAK3172_Bench_Builder(uint32_t Frequency, const uint8_t* p_Key)
+{
+    RAK3172_Command_t Command;
+
+    RAK3172_Bench_SendCommand(RAK3172_Command_Build(Command, "AT+NJS=?"));
+    RAK3172_Bench_SendCommand(RAK3172_Command_Build(Command, "AT+PFREQ=", Frequency));
+    RAK3172_Bench_SendCommand(RAK3172_Command_Build(Command, "AT+JOIN=1:", true, ':', 10, ':', 8));
+    RAK3172_Bench_SendCommand(RAK3172_Command_Build(Command, "AT+APPKEY=", RAK3172_Command_Hex(p_Key, 16, true)));
+}
+
+int main(int argc, char** argv)
+{
+    size_t Iterations;
+    size_t Errors;
+    size_t Allocations;
+    double StringAllocations;
+    double BuilderAllocations;
+    RAK3172_Command_t Command;
+    const uint8_t Key[16] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+
+    Iterations = 200000;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    // The builder must produce the same commands.
+    Errors = 0;
+    RAK3172_Command_Build(Command, "AT+JOIN=1:", true, ':', 10, ':', -8);
+    if(RAK3172_Command_View(Command) != "AT+JOIN=1:1:10:-8")
+    {
+        Errors++;
+    }
+
+    RAK3172_Command_Build(Command, "AT+APPKEY=", RAK3172_Command_Hex(Key, 16, true));
+    if(RAK3172_Command_View(Command) != "AT+APPKEY=2B7E151628AED2A6ABF7158809CF4F3C")
+    {
+        Errors++;
+    }
+
+    if(memcmp(&Command.Buffer[Command.Length], "\r\n", 2) != 0)
+    {
+        Errors++;
+    }
+
+    Allocations = _RAK3172_Bench_Allocations;
+    auto Start = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        RAK3172_Bench_String(868100000 + n, Key);
+    }
+    auto Middle = std::chrono::steady_clock::now();
+    StringAllocations = static_cast<double>(_RAK3172_Bench_Allocations - Allocations) / (Iterations * 4);
+
+    Allocations = _RAK3172_Bench_Allocations;
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        RAK3172_Bench_Builder(868100000 + n, Key);
+    }
+    auto End = std::chrono::steady_clock::now();
+    BuilderAllocations = static_cast<double>(_RAK3172_Bench_Allocations - Allocations) / (Iterations * 4);
+
+    double Commands = static_cast<double>(Iterations * 4);
+    double String = std::chrono::duration<double, std::nano>(Middle - Start).count() / Commands;
+    double Builder = std::chrono::duration<double, std::nano>(End - Middle).count() / Commands;
+
+    printf("Iterations:         %zu\n", Iterations);
+    printf("String:             %.1f ns/command, %.2f allocations/command\n", String, StringAllocations);
+    printf("Builder:            %.1f ns/command, %.2f allocations/command\n", Builder, BuilderAllocations);
+    printf("Speedup:            %.2fx\n", String / Builder);
+    printf("Checksum:           %u\n", static_cast<unsigned int>(_RAK3172_Bench_Checksum));
+
+    return ((Errors == 0) && (BuilderAllocations == 0)) ? 0 : 1;
+}
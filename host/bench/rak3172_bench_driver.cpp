@@ -0,0 +1,255 @@
+ /*
+ * rak3172_bench_driver.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host benchmark for the command round trip of the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "rak3172.h"
+#include "rak3172_shim.h"
+
+/** @brief UART used by the benchmark.
+ */
+#define RAK3172_BENCH_UART                                      UART_NUM_1
+
+typedef std::chrono::steady_clock RAK3172_Bench_Clock_t;
+
+/** @brief Minimal RUI3 module on the module side of the shim UART.
+ */
+typedef struct
+{
+    int Fd;
+    std::atomic<bool> isRunning;
+    std::map<std::string, std::string> Values;
+} RAK3172_Bench_Module_t;
+
+/** @brief          Answer a single command like a RUI3 module without echo.
+ *  @param p_Module Pointer to module object
+ *  @param Command  Received command without line ending
+ */
+static void RAK3172_Bench_Answer(RAK3172_Bench_Module_t* p_Module, const std::string& Command)
+{
+    size_t Index;
+    std::string Response;
+
+    if((Command == "ATZ") || (Command == "ATR"))
+    {
+        Response = "RAKwireless RAK3172 Example\r\n------------------------------------------------------\r\nCurrent Work Mode: LoRaWAN.\r\n";
+    }
+    else if((Index = Command.find("=?")) != std::string::npos)
+    {
+        std::string Key = Command.substr(0, Index);
+        auto Value = p_Module->Values.find(Key);
+
+        if(Value == p_Module->Values.end())
+        {
+            Response = "AT_PARAM_ERROR\r\n";
+        }
+        else
+        {
+            Response = Key + "=" + Value->second + "\r\nOK\r\n";
+        }
+    }
+    else if((Index = Command.find('=')) != std::string::npos)
+    {
+        p_Module->Values[Command.substr(0, Index)] = Command.substr(Index + 1);
+        Response = "OK\r\n";
+    }
+    else
+    {
+        Response = "OK\r\n";
+    }
+
+    if(write(p_Module->Fd, Response.data(), Response.size()) < 0)
+    {
+        p_Module->isRunning = false;
+    }
+}
+
+/** @brief          Module task. Split the received data into commands and answer them.
+ *  @param p_Module Pointer to module object
+ */
+static void RAK3172_Bench_ModuleTask(RAK3172_Bench_Module_t* p_Module)
+{
+    char Buffer[512];
+    std::string Line;
+
+    while(p_Module->isRunning)
+    {
+        ssize_t Length;
+        struct pollfd Poll = {.fd = p_Module->Fd, .events = POLLIN, .revents = 0};
+
+        if(poll(&Poll, 1, 10) <= 0)
+        {
+            continue;
+        }
+
+        Length = read(p_Module->Fd, Buffer, sizeof(Buffer));
+        if(Length <= 0)
+        {
+            break;
+        }
+
+        for(ssize_t i = 0; i < Length; i++)
+        {
+            if(Buffer[i] == '\n')
+            {
+                if(!Line.empty() && (Line.back() == '\r'))
+                {
+                    Line.pop_back();
+                }
+
+                RAK3172_Bench_Answer(p_Module, Line);
+                Line.clear();
+            }
+            else
+            {
+                Line += Buffer[i];
+            }
+        }
+    }
+}
+
+/** @brief              Print the latency statistics.
+ *  @param p_Name       Name of the benchmark
+ *  @param p_Latency    Pointer to latency list in microseconds
+ *  @param Commands     Number of commands per sample
+ */
+static void RAK3172_Bench_Print(const char* p_Name, std::vector<double>* p_Latency, size_t Commands)
+{
+    double Sum = 0.0;
+
+    std::sort(p_Latency->begin(), p_Latency->end());
+
+    for(double Value : *p_Latency)
+    {
+        Sum += Value;
+    }
+
+    printf("%-10s mean %8.1f us, p50 %8.1f us, p99 %8.1f us, max %8.1f us, %8.1f us/command\n", p_Name, Sum / p_Latency->size(),
+           (*p_Latency)[p_Latency->size() / 2], (*p_Latency)[(p_Latency->size() * 99) / 100], p_Latency->back(),
+           Sum / p_Latency->size() / Commands);
+}
+
+/** @brief              Measure a function which transmits commands to the module.
+ *  @param Function     Benchmark function
+ *  @param Iterations   Number of samples
+ *  @param p_Latency    Pointer to latency list in microseconds
+ *  @return             true when all commands were successful
+ */
+template<typename T>
+static bool RAK3172_Bench_Run(T Function, size_t Iterations, std::vector<double>* p_Latency)
+{
+    for(size_t i = 0; i < Iterations; i++)
+    {
+        auto Start = RAK3172_Bench_Clock_t::now();
+
+        if(Function() != RAK3172_ERR_OK)
+        {
+            return false;
+        }
+
+        p_Latency->push_back(std::chrono::duration<double, std::micro>(RAK3172_Bench_Clock_t::now() - Start).count());
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int Result;
+    size_t Iterations;
+    std::string Value;
+    std::thread Task;
+    std::vector<double> Ping;
+    std::vector<double> Query;
+    std::vector<double> Set;
+    std::vector<double> Batch;
+    RAK3172_Bench_Module_t Module;
+    RAK3172_t Device = RAK3172_DEFAULT_CONFIG(RAK3172_BENCH_UART, 16, 17, RAK_BAUD_115200);
+    const std::vector<std::string> Commands = {"AT+DEVEUI=?", "AT+APPEUI=?", "AT+APPKEY=?", "AT+CLASS=?"};
+
+    Iterations = 1000;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    Module.Fd = RAK3172_Shim_UART_GetPeer(RAK3172_BENCH_UART);
+    if(Module.Fd < 0)
+    {
+        printf("Can not create the UART!\n");
+
+        return -1;
+    }
+
+    Module.isRunning = true;
+    Module.Values["AT+NWM"] = "1";
+    Module.Values["AT+DEVEUI"] = "AC1F09FFFE000001";
+    Module.Values["AT+APPEUI"] = "0000000000000000";
+    Module.Values["AT+APPKEY"] = "2B7E151628AED2A6ABF7158809CF4F3C";
+    Module.Values["AT+CLASS"] = "A";
+    Task = std::thread(RAK3172_Bench_ModuleTask, &Module);
+
+    if(RAK3172_Init(Device) != RAK3172_ERR_OK)
+    {
+        printf("Can not initialize the driver!\n");
+
+        Module.isRunning = false;
+        Task.join();
+
+        return -1;
+    }
+
+    printf("Iterations:     %zu\n", Iterations);
+
+    if(!RAK3172_Bench_Run([&Device]() { return RAK3172_SendCommand(Device, "AT"); }, Iterations, &Ping) ||
+       !RAK3172_Bench_Run([&Device, &Value]() { return RAK3172_SendCommand(Device, "AT+DEVEUI=?", &Value); }, Iterations, &Query) ||
+       !RAK3172_Bench_Run([&Device]() { return RAK3172_SendCommand(Device, "AT+CFM=1"); }, Iterations, &Set) ||
+       !RAK3172_Bench_Run([&Device, &Commands]() { return RAK3172_SendCommands(Device, Commands); }, Iterations, &Batch))
+    {
+        printf("Command failed!\n");
+
+        Result = -1;
+    }
+    else
+    {
+        RAK3172_Bench_Print("Ping", &Ping, 1);
+        RAK3172_Bench_Print("Query", &Query, 1);
+        RAK3172_Bench_Print("Set", &Set, 1);
+        RAK3172_Bench_Print("Pipeline", &Batch, Commands.size());
+
+        Result = 0;
+    }
+
+    RAK3172_Deinit(Device);
+
+    Module.isRunning = false;
+    Task.join();
+
+    return Result;
+}
@@ -0,0 +1,305 @@
+ /*
+ * rak3172_bench_emulator.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host benchmark for the RAK3172 driver against the AT firmware emulator.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_timer.h>
+
+#include "rak3172.h"
+#include "rak3172_emulator.h"
+
+/** @brief UART used by the benchmark.
+ */
+#define RAK3172_BENCH_UART                                      UART_NUM_1
+
+/** @brief Duration of the throughput measurements in milliseconds.
+ */
+#define RAK3172_BENCH_DURATION                                  1000
+
+/** @brief Number of received messages for the latency measurements.
+ */
+#define RAK3172_BENCH_MESSAGES                                  200
+
+typedef std::chrono::steady_clock RAK3172_Bench_Clock_t;
+
+/** @brief              Run a function until the benchmark duration has expired and print the throughput.
+ *  @param p_Name       Name of the benchmark
+ *  @param p_Unit       Unit of one call
+ *  @param Function     Benchmark function
+ *  @return             #true when all calls were successful
+ */
+template<typename T>
+static bool RAK3172_Bench_Throughput(const char* p_Name, const char* p_Unit, T Function)
+{
+    size_t Count;
+    double Elapsed;
+    RAK3172_Bench_Clock_t::time_point Start;
+
+    Count = 0;
+    Start = RAK3172_Bench_Clock_t::now();
+    do
+    {
+        RAK3172_Error_t Result;
+
+        Result = Function();
+        if(Result != RAK3172_ERR_OK)
+        {
+            printf("%-22s failed with 0x%X\n", p_Name, static_cast<unsigned int>(Result));
+
+            return false;
+        }
+
+        Count++;
+        Elapsed = std::chrono::duration<double>(RAK3172_Bench_Clock_t::now() - Start).count();
+    } while(Elapsed < (RAK3172_BENCH_DURATION / 1000.0));
+
+    printf("%-22s %10.1f %s/s (%zu in %.2f s)\n", p_Name, Count / Elapsed, p_Unit, Count, Elapsed);
+
+    return true;
+}
+
+/** @brief              Print the latency statistics.
+ *  @param p_Name       Name of the benchmark
+ *  @param p_Latency    Pointer to latency list in microseconds
+ */
+static void RAK3172_Bench_PrintLatency(const char* p_Name, std::vector<double>* p_Latency)
+{
+    double Sum = 0.0;
+
+    if(p_Latency->empty())
+    {
+        return;
+    }
+
+    std::sort(p_Latency->begin(), p_Latency->end());
+
+    for(double Value : *p_Latency)
+    {
+        Sum += Value;
+    }
+
+    printf("%-22s mean %8.1f us, p50 %8.1f us, p99 %8.1f us, max %8.1f us\n", p_Name, Sum / p_Latency->size(),
+           (*p_Latency)[p_Latency->size() / 2], (*p_Latency)[(p_Latency->size() * 99) / 100], p_Latency->back());
+}
+
+/** @brief              Measure the delivery latency of received messages. The latency is measured from the transmission
+ *                      of the receive event by the emulator to the line timestamp of the driver and to the return of the
+ *                      receive function.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Name       Name of the benchmark
+ *  @param Receive      Function which queues a message in the emulator and receives it with the driver
+ *  @return             #true when all messages were received
+ */
+template<typename T>
+static bool RAK3172_Bench_Latency(RAK3172_Emulator_t* p_Emulator, const char* p_Name, T Receive)
+{
+    std::string Name;
+    std::vector<double> Driver;
+    std::vector<double> Delivery;
+
+    for(size_t i = 0; i < RAK3172_BENCH_MESSAGES; i++)
+    {
+        int64_t Returned;
+        RAK3172_Error_t Result;
+        RAK3172_RxInfo_t Info;
+        RAK3172_EmulatorStats_t Stats;
+
+        Result = Receive(&Info);
+        Returned = esp_timer_get_time();
+        if(Result != RAK3172_ERR_OK)
+        {
+            printf("%-22s failed with 0x%X\n", p_Name, static_cast<unsigned int>(Result));
+
+            return false;
+        }
+
+        RAK3172_Emulator_GetStats(p_Emulator, &Stats);
+        Driver.push_back(static_cast<double>(Info.Timestamp - Stats.LastDownlink));
+        Delivery.push_back(static_cast<double>(Returned - Stats.LastDownlink));
+    }
+
+    Name = std::string(p_Name) + " (line)";
+    RAK3172_Bench_PrintLatency(Name.c_str(), &Driver);
+    Name = std::string(p_Name) + " (app)";
+    RAK3172_Bench_PrintLatency(Name.c_str(), &Delivery);
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int Result;
+    std::string Value;
+    RAK3172_Error_t Error;
+    RAK3172_Emulator_t* Emulator;
+    RAK3172_EmulatorStats_t Stats;
+    RAK3172_EmulatorConfig_t Config = RAK3172_EMULATOR_DEFAULT_CONFIG(RAK3172_BENCH_UART);
+    RAK3172_t Device = RAK3172_DEFAULT_CONFIG(RAK3172_BENCH_UART, 16, 17, RAK_BAUD_115200);
+    std::vector<uint8_t> Small(16, 0x5A);
+    std::vector<uint8_t> Large(1000, 0xA5);
+    const uint8_t Downlink[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+    #ifdef CONFIG_RAK3172_USE_RUI3
+        Config.Dialect = RAK_EMULATOR_RUI3;
+    #else
+        Config.Dialect = RAK_EMULATOR_LEGACY;
+    #endif
+
+    // Transmissions finish immediately, so the throughput is limited by the wire and the driver.
+    Config.TxTime = 0;
+    if(argc > 1)
+    {
+        Config.Baudrate = strtoul(argv[1], NULL, 10);
+    }
+
+    Emulator = RAK3172_Emulator_Start(&Config);
+    if(Emulator == NULL)
+    {
+        printf("Can not start the emulator!\n");
+
+        return -1;
+    }
+
+    if(argc > 2)
+    {
+        std::ifstream File(argv[2]);
+        std::stringstream Script;
+
+        Script << File.rdbuf();
+        if((File.is_open() == false) || (RAK3172_Emulator_RunScript(Emulator, Script.str().c_str()) == false))
+        {
+            printf("Invalid script %s!\n", argv[2]);
+
+            RAK3172_Emulator_Stop(Emulator);
+
+            return -1;
+        }
+    }
+
+    printf("Dialect:                %s\n", (Config.Dialect == RAK_EMULATOR_RUI3) ? "RUI3" : "Legacy");
+    printf("Wire baudrate:          %u\n", static_cast<unsigned int>(Config.Baudrate));
+
+    Result = -1;
+    if(RAK3172_Init(Device) != RAK3172_ERR_OK)
+    {
+        printf("Can not initialize the driver!\n");
+
+        goto RAK3172_Bench_Exit;
+    }
+
+    if(!RAK3172_Bench_Throughput("Commands", "commands", [&Device]() { return RAK3172_SendCommand(Device, "AT"); }) ||
+       !RAK3172_Bench_Throughput("Queries", "commands", [&Device, &Value]() { return RAK3172_SendCommand(Device, "AT+DEVEUI=?", &Value); }))
+    {
+        goto RAK3172_Bench_Exit;
+    }
+
+    if(RAK3172_LoRaWAN_StartJoin(Device, 8, 10, true, false, 7) != RAK3172_ERR_OK)
+    {
+        printf("Join failed!\n");
+
+        goto RAK3172_Bench_Exit;
+    }
+
+    if(!RAK3172_Bench_Throughput("Uplinks (16 bytes)", "uplinks", [&Device, &Small]() {
+            return RAK3172_LoRaWAN_Transmit(Device, 1, Small.data(), Small.size(), false, 0, true);
+        }) ||
+       !RAK3172_Bench_Throughput("Uplinks (1000 bytes)", "uplinks", [&Device, &Large]() {
+            return RAK3172_LoRaWAN_Transmit(Device, 1, Large.data(), Large.size(), false, 0, true);
+        }))
+    {
+        goto RAK3172_Bench_Exit;
+    }
+
+    if(!RAK3172_Bench_Latency(Emulator, "Downlink", [&Device, Emulator, &Small, &Downlink](RAK3172_RxInfo_t* p_Info) {
+            uint8_t Buffer[sizeof(Downlink)];
+
+            RAK3172_Emulator_QueueDownlink(Emulator, 2, Downlink, sizeof(Downlink));
+            RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_Transmit(Device, 1, Small.data(), Small.size(), false, 0, true));
+
+            return RAK3172_LoRaWAN_ReceiveBinary(Device, Buffer, sizeof(Buffer), p_Info, 1);
+        }))
+    {
+        goto RAK3172_Bench_Exit;
+    }
+
+    #ifdef CONFIG_RAK3172_USE_RUI3
+        // Multicast downlinks must be delivered with the cast type. Only RUI3 reports the cast type.
+        {
+            RAK3172_RxInfo_t Info;
+            uint8_t Buffer[sizeof(Downlink)];
+
+            RAK3172_Emulator_QueueDownlink(Emulator, 200, Downlink, sizeof(Downlink), -39, 13, true);
+            Error = RAK3172_LoRaWAN_Transmit(Device, 1, Small.data(), Small.size(), false, 0, true);
+            if(Error == RAK3172_ERR_OK)
+            {
+                Error = RAK3172_LoRaWAN_ReceiveBinary(Device, Buffer, sizeof(Buffer), &Info, 1);
+            }
+
+            if((Error != RAK3172_ERR_OK) || (Info.isMulticast == false) || (Info.Port != 200) || (Info.Length != sizeof(Downlink)) ||
+               (memcmp(Buffer, Downlink, sizeof(Downlink)) != 0))
+            {
+                printf("Multicast downlink not delivered! Error: 0x%X\n", static_cast<unsigned int>(Error));
+
+                goto RAK3172_Bench_Exit;
+            }
+        }
+    #endif
+
+    #ifdef CONFIG_RAK3172_MODE_WITH_P2P
+        Error = RAK3172_SetMode(Device, RAK_MODE_P2P);
+        if(Error != RAK3172_ERR_OK)
+        {
+            printf("Can not switch to P2P mode! Error: 0x%X\n", static_cast<unsigned int>(Error));
+
+            goto RAK3172_Bench_Exit;
+        }
+
+        if(!RAK3172_Bench_Latency(Emulator, "P2P", [&Device, Emulator, &Downlink](RAK3172_RxInfo_t* p_Info) {
+                uint8_t Buffer[sizeof(Downlink)];
+
+                RAK3172_Emulator_QueueP2P(Emulator, Downlink, sizeof(Downlink));
+
+                return RAK3172_P2P_ReceiveBinary(Device, Buffer, sizeof(Buffer), p_Info, 1000);
+            }))
+        {
+            goto RAK3172_Bench_Exit;
+        }
+    #endif
+
+    Result = 0;
+
+RAK3172_Bench_Exit:
+    RAK3172_Emulator_GetStats(Emulator, &Stats);
+    printf("Emulator:               %u commands, %u errors, %u joins, %u uplinks, %u downlinks, %u P2P packets\n",
+           static_cast<unsigned int>(Stats.Commands), static_cast<unsigned int>(Stats.Errors), static_cast<unsigned int>(Stats.Joins),
+           static_cast<unsigned int>(Stats.Uplinks), static_cast<unsigned int>(Stats.Downlinks), static_cast<unsigned int>(Stats.P2PReceived));
+
+    RAK3172_Deinit(Device);
+    RAK3172_Emulator_Stop(Emulator);
+
+    return Result;
+}
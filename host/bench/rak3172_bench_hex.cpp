@@ -0,0 +1,314 @@
+ /*
+ * rak3172_bench_hex.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Runtime benchmark for the hex encoding and decoding of payloads.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+
+#include "rak3172_command.h"
+#include "rak3172_tools.h"
+
+/** @brief Sink for the encoded commands. Replaces the UART driver.
+ */
+static uint32_t _RAK3172_Bench_Checksum = 0;
+
+/** @brief          Consume a transmitted buffer like the UART driver.
+ *  @param p_Data   Pointer to data
+ *  @param Length   Length of data
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Write(const char* p_Data, size_t Length)
+{
+    _RAK3172_Bench_Checksum += Length + static_cast<uint8_t>(p_Data[Length - 1]);
+}
+
+/** @brief          Encode a payload like the previous implementation of "AT+LPSEND" (sprintf and string concatenation per byte).
+ *  @param p_Data   Pointer to payload
+ *  @param Length   Length of the payload
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Sprintf(const uint8_t* p_Data, size_t Length)
+{
+    std::string Payload;
+    char Buffer[3];
+
+    Payload = "AT+LPSEND=" + std::to_string(2) + ":" + std::to_string(false) + ":";
+    for(size_t i = 0; i < Length; i++)
+    {
+        sprintf(Buffer, "%02x", p_Data[i]);
+        Payload += std::string(Buffer);
+    }
+
+    RAK3172_Bench_Write(Payload.c_str(), Payload.length());
+}
+
+/** @brief          Encode a payload with a nibble lookup per character into a command object.
+ *  @param p_Data   Pointer to payload
+ *  @param Length   Length of the payload
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Nibble(RAK3172_LongPayloadCommand_t& p_Command, const uint8_t* p_Data, size_t Length)
+{
+    const char* Digits = "0123456789abcdef";
+
+    RAK3172_Command_Build(p_Command, "AT+LPSEND=", 2, ':', false, ':');
+    for(size_t i = 0; i < Length; i++)
+    {
+        p_Command.Buffer[p_Command.Length++] = Digits[p_Data[i] >> 4];
+        p_Command.Buffer[p_Command.Length++] = Digits[p_Data[i] & 0x0F];
+    }
+
+    RAK3172_Bench_Write(p_Command.Buffer, p_Command.Length);
+}
+
+/** @brief          Encode a payload with the command builder.
+ *  @param p_Data   Pointer to payload
+ *  @param Length   Length of the payload
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Table(RAK3172_LongPayloadCommand_t& p_Command, const uint8_t* p_Data, size_t Length)
+{
+    RAK3172_Command_Build(p_Command, "AT+LPSEND=", 2, ':', false, ':', RAK3172_Command_Hex(p_Data, Length));
+
+    RAK3172_Bench_Write(p_Command.Buffer, p_Command.Length);
+}
+
+/** @brief          Decode a payload like the first implementation of the receive path (string by value, bounds checked access).
+ *  @param Hex      Hex string
+ *  @param p_Buffer Output buffer
+ */
+static void __attribute__((noinline)) RAK3172_Bench_Hex2ASCII(std::string Hex, uint8_t* const p_Buffer)
+{
+    size_t Offset;
+    uint8_t High = 0;
+
+    if((p_Buffer == NULL) || ((Hex.size() % 2) != 0))
+    {
+        return;
+    }
+
+    Offset = 0;
+    for(size_t i = 0; i < Hex.size(); i++)
+    {
+        uint8_t Temp = 0;
+
+        if((Hex.at(i) >= '0') && (Hex.at(i) <= '9'))
+        {
+            Temp = static_cast<uint8_t>(Hex.at(i)) - 48;
+        }
+        else if((Hex.at(i) >= 'a') && (Hex.at(i) <= 'f'))
+        {
+            Temp = static_cast<uint8_t>(Hex.at(i)) - 'a' + 10;
+        }
+        else if((Hex.at(i) >= 'A') && (Hex.at(i) <= 'F'))
+        {
+            Temp = static_cast<uint8_t>(Hex.at(i)) - 'A' + 10;
+        }
+        else
+        {
+            return;
+        }
+
+        if((i % 2) == 0)
+        {
+            High = Temp;
+        }
+        else
+        {
+            *(p_Buffer + (Offset++)) = static_cast<uint8_t>((High << 0x04) + Temp);
+        }
+    }
+}
+
+/** @brief          Convert a single hex character into a nibble with range checks like the previous decoder.
+ *  @param Hex      Hex character
+ *  @return         Nibble value or -1 when the character is invalid
+ */
+static inline int8_t RAK3172_Bench_Nibble(char Hex)
+{
+    if((Hex >= '0') && (Hex <= '9'))
+    {
+        return Hex - '0';
+    }
+    else if((Hex >= 'a') && (Hex <= 'f'))
+    {
+        return Hex - 'a' + 10;
+    }
+    else if((Hex >= 'A') && (Hex <= 'F'))
+    {
+        return Hex - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/** @brief          Decode a payload with range checks and an early exit per character like the previous decoder.
+ *  @param p_Hex    Pointer to hex characters
+ *  @param Length   Number of hex characters
+ *  @param p_Buffer Output buffer
+ *  @return         Number of bytes or -1 when the input is invalid
+ */
+static int __attribute__((noinline)) RAK3172_Bench_Branch(const char* p_Hex, size_t Length, uint8_t* const p_Buffer)
+{
+    for(size_t i = 0; i < (Length / 2); i++)
+    {
+        int8_t High = RAK3172_Bench_Nibble(p_Hex[2 * i]);
+        int8_t Low = RAK3172_Bench_Nibble(p_Hex[(2 * i) + 1]);
+
+        if((High < 0) || (Low < 0))
+        {
+            return -1;
+        }
+
+        p_Buffer[i] = static_cast<uint8_t>((High << 0x04) | Low);
+    }
+
+    return static_cast<int>(Length / 2);
+}
+
+/** @brief              Measure the runtime of an encoder or a decoder.
+ *  @param Iterations   Number of iterations
+ *  @param Function     Encoder or decoder
+ *  @return             Runtime per payload in ns
+ */
+template<typename F>
+static double RAK3172_Bench_Run(size_t Iterations, F Function)
+{
+    auto Start = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        Function();
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(End - Start).count() / Iterations;
+}
+
+int main(int argc, char** argv)
+{
+    size_t Errors;
+    size_t Iterations;
+    std::string Expected;
+    std::vector<uint8_t> Payload(1000);
+    static RAK3172_LongPayloadCommand_t Command;
+    const size_t Lengths[] = {8, 16, 51, 242, 1000};
+
+    Iterations = 100000;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    srand(1);
+    for(size_t i = 0; i < Payload.size(); i++)
+    {
+        Payload[i] = static_cast<uint8_t>(rand());
+    }
+
+    // The encoder must produce the same digits as sprintf for every byte value and every tail length.
+    Errors = 0;
+    for(size_t Length = 0; Length <= 256; Length++)
+    {
+        uint8_t Data[256];
+        char Buffer[3];
+
+        Expected.clear();
+        for(size_t i = 0; i < Length; i++)
+        {
+            Data[i] = static_cast<uint8_t>(i + (Length * 7));
+            sprintf(Buffer, "%02X", Data[i]);
+            Expected += Buffer;
+        }
+
+        RAK3172_Command_Build(Command, RAK3172_Command_Hex(Data, Length, true));
+        if((RAK3172_Command_View(Command) != Expected) || (memcmp(&Command.Buffer[Command.Length], "\r\n", 2) != 0))
+        {
+            Errors++;
+        }
+    }
+
+    RAK3172_Command_Build(Command, "AT+LPSEND=", 2, ':', false, ':', RAK3172_Command_Hex(Payload.data(), Payload.size()));
+    if(Command.isOverflow || (Command.Length != (strlen("AT+LPSEND=2:0:") + (2 * Payload.size()))))
+    {
+        Errors++;
+    }
+
+    printf("Iterations:         %zu\n", Iterations);
+    printf("Encoding:\n");
+    for(size_t Length : Lengths)
+    {
+        double Sprintf = RAK3172_Bench_Run(Iterations, [&]() { RAK3172_Bench_Sprintf(Payload.data(), Length); });
+        double Nibble = RAK3172_Bench_Run(Iterations, [&]() { RAK3172_Bench_Nibble(Command, Payload.data(), Length); });
+        double Table = RAK3172_Bench_Run(Iterations, [&]() { RAK3172_Bench_Table(Command, Payload.data(), Length); });
+
+        printf("%4zu bytes:         sprintf %9.1f ns, nibble %8.1f ns, table %8.1f ns, speedup %6.1fx (sprintf), %4.1fx (nibble)\n",
+               Length, Sprintf, Nibble, Table, Sprintf / Table, Nibble / Table);
+    }
+
+    printf("Decoding:\n");
+    RAK3172_Command_Build(Command, "AT+LPSEND=", 2, ':', false, ':', RAK3172_Command_Hex(Payload.data(), Payload.size()));
+
+    // The decoder must accept both cases, reject invalid characters and decode in place.
+    {
+        char Hex[] = "00017F80fFaBcDeF";
+        const uint8_t Decoded[] = {0x00, 0x01, 0x7F, 0x80, 0xFF, 0xAB, 0xCD, 0xEF};
+
+        if((RAK3172_Tools_Hex2Bin(Hex, strlen(Hex), reinterpret_cast<uint8_t*>(Hex), sizeof(Hex)) != sizeof(Decoded)) ||
+           (memcmp(Hex, Decoded, sizeof(Decoded)) != 0))
+        {
+            Errors++;
+        }
+
+        for(size_t i = 0; i < 256; i++)
+        {
+            uint8_t Byte;
+            char Invalid[2] = {'0', static_cast<char>(i)};
+
+            if((RAK3172_Tools_Hex2Bin(Invalid, 2, &Byte, 1) < 0) == (isxdigit(static_cast<int>(i)) != 0))
+            {
+                Errors++;
+            }
+        }
+    }
+
+    for(size_t Length : Lengths)
+    {
+        std::string Hex;
+        uint8_t Output[1000];
+
+        Hex.assign(&Command.Buffer[strlen("AT+LPSEND=2:0:")], 2 * Length);
+        if((RAK3172_Tools_Hex2Bin(Hex, Output, sizeof(Output)) != static_cast<int>(Length)) ||
+           (memcmp(Output, Payload.data(), Length) != 0))
+        {
+            Errors++;
+        }
+
+        double Copy = RAK3172_Bench_Run(Iterations, [&]() { RAK3172_Bench_Hex2ASCII(Hex, Output); _RAK3172_Bench_Checksum += Output[0]; });
+        double Branch = RAK3172_Bench_Run(Iterations, [&]() { _RAK3172_Bench_Checksum += RAK3172_Bench_Branch(Hex.c_str(), Hex.size(), Output) + Output[0]; });
+        double Table = RAK3172_Bench_Run(Iterations, [&]() { _RAK3172_Bench_Checksum += RAK3172_Tools_Hex2Bin(Hex.c_str(), Hex.size(), Output, sizeof(Output)) + Output[0]; });
+
+        printf("%4zu bytes:         by value %8.1f ns, branch %8.1f ns, table %8.1f ns, speedup %6.1fx (by value), %4.1fx (branch)\n",
+               Length, Copy, Branch, Table, Copy / Table, Branch / Table);
+    }
+
+    printf("Checksum:           %u\n", static_cast<unsigned int>(_RAK3172_Bench_Checksum));
+    printf("Errors:             %zu\n", Errors);
+
+    return (Errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+ /*
+ * rak3172_bench_line_parser.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host benchmark for the RAK3172 stream line parser.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/Parser/rak3172_line_parser.h"
+
+/** @brief Typical lines received from a module with RUI3 firmware.
+ */
+static const char* _RAK3172_Bench_Lines[] = {
+    "OK",
+    "AT+VER=4.0.5",
+    "AT_BUSY_ERROR",
+    "",
+    "+EVT:JOINED",
+    "+EVT:TX_DONE",
+    "+EVT:SEND_CONFIRMED_OK",
+    "+EVT:RX_1:-89:4:UNICAST:2:0102030405060708090A0B0C0D0E0F10",
+    "+EVT:RX_C:-39:13:MULCAST:200:A1B2C3D4",
+    "+EVT:RXP2P:-30:10:AABBCCDD",
+    "Current Work Mode: LoRaWAN.",
+};
+
+/** @brief Line statistics used to compare the parser output with the reference.
+ */
+typedef struct
+{
+    size_t Lines;
+    size_t Bytes;
+    uint32_t Hash;
+} RAK3172_Bench_Result_t;
+
+/** @brief          Line callback of the benchmark.
+ *  @param p_Arg    Pointer to result object
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ */
+static void RAK3172_Bench_OnLine(void* p_Arg, char* p_Line, size_t Length)
+{
+    RAK3172_Bench_Result_t* Result = static_cast<RAK3172_Bench_Result_t*>(p_Arg);
+
+    Result->Lines++;
+    Result->Bytes += Length;
+    for(size_t i = 0; i < Length; i++)
+    {
+        Result->Hash = (Result->Hash ^ static_cast<uint8_t>(p_Line[i])) * 16777619UL;
+    }
+    Result->Hash = (Result->Hash ^ '\n') * 16777619UL;
+}
+
+int main(int argc, char** argv)
+{
+    size_t Size;
+    size_t Errors;
+    std::string Stream;
+    RAK3172_Bench_Result_t Expected;
+    static const size_t Chunks[] = {1, 7, 64, 128, 4096};
+
+    Size = 8 * 1024 * 1024;
+    if(argc > 1)
+    {
+        Size = strtoul(argv[1], NULL, 10);
+    }
+
+    // Generate the traffic and the reference result.
+    Expected = {0, 0, 2166136261UL};
+    for(size_t i = 0; Stream.size() < Size; i++)
+    {
+        const char* Line = _RAK3172_Bench_Lines[i % (sizeof(_RAK3172_Bench_Lines) / sizeof(_RAK3172_Bench_Lines[0]))];
+        std::string Copy(Line);
+
+        RAK3172_Bench_OnLine(&Expected, &Copy[0], Copy.size());
+        Stream += Copy;
+        Stream += "\r\n";
+    }
+
+    printf("Stream size:    %zu bytes\n", Stream.size());
+    printf("Lines:          %zu\n", Expected.Lines);
+
+    Errors = 0;
+    for(size_t c = 0; c < (sizeof(Chunks) / sizeof(Chunks[0])); c++)
+    {
+        char Buffer[545];
+        RAK3172_LineParser_t Parser;
+        RAK3172_Bench_Result_t Result = {0, 0, 2166136261UL};
+
+        RAK3172_LineParser_Init(&Parser, Buffer, sizeof(Buffer), RAK3172_Bench_OnLine, &Result);
+
+        auto Start = std::chrono::steady_clock::now();
+        for(size_t Offset = 0; Offset < Stream.size(); Offset += Chunks[c])
+        {
+            size_t Length = Stream.size() - Offset;
+
+            RAK3172_LineParser_Feed(&Parser, &Stream[Offset], (Length < Chunks[c]) ? Length : Chunks[c]);
+        }
+        auto End = std::chrono::steady_clock::now();
+
+        double Seconds = std::chrono::duration<double>(End - Start).count();
+
+        if((Result.Lines != Expected.Lines) || (Result.Bytes != Expected.Bytes) || (Result.Hash != Expected.Hash))
+        {
+            printf("Mismatch for chunk size %zu\n", Chunks[c]);
+            Errors++;
+        }
+
+        printf("Chunk %4zu:     %.1f MB/s\n", Chunks[c], (Stream.size() / Seconds) / (1024.0 * 1024.0));
+    }
+
+    return (Errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+ /*
+ * rak3172_bench_number.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Runtime benchmark for the parsing of numeric module responses.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rak3172_number.h"
+
+/** @brief Typical numeric responses and a few garbled lines.
+ */
+static const std::string _RAK3172_Bench_Responses[] = {
+    "1", "0", "5", "868100000", "-87", "-7", "3", "115200", "12", "garbled", "", "99999999999", "-", "4"
+};
+
+/** @brief Number of responses in the test set.
+ */
+#define RAK3172_BENCH_RESPONSES                 (sizeof(_RAK3172_Bench_Responses) / sizeof(_RAK3172_Bench_Responses[0]))
+
+/** @brief          Parse a response like the previous implementation. Garbled responses are caught here, because the event task
+ *                  would otherwise be terminated.
+ *  @param Response Response string
+ *  @param p_Value  Pointer to value
+ *  @return         #true when successful
+ */
+static bool __attribute__((noinline)) RAK3172_Bench_Stoi(const std::string& Response, int32_t* p_Value)
+{
+    try
+    {
+        *p_Value = std::stoi(Response);
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/** @brief          Parse a response with the exception free parser.
+ *  @param Response Response string
+ *  @param p_Value  Pointer to value
+ *  @return         #true when successful
+ */
+static bool __attribute__((noinline)) RAK3172_Bench_Parser(const std::string& Response, int32_t* p_Value)
+{
+    return RAK3172_Number_To(Response, p_Value);
+}
+
+/** @brief          Run a parser over the test set.
+ *  @param Parse    Parser function
+ *  @param Iterations Number of passes over the test set
+ *  @param p_Sum    Pointer to checksum of all parsed values
+ *  @param p_Failed Pointer to number of rejected responses
+ *  @return         Time per response in ns
+ */
+static double RAK3172_Bench_Run(bool (*Parse)(const std::string&, int32_t*), size_t Iterations, int64_t* p_Sum, size_t* p_Failed)
+{
+    *p_Sum = 0;
+    *p_Failed = 0;
+
+    auto Start = std::chrono::steady_clock::now();
+    for(size_t n = 0; n < Iterations; n++)
+    {
+        for(size_t i = 0; i < RAK3172_BENCH_RESPONSES; i++)
+        {
+            int32_t Value;
+
+            if(Parse(_RAK3172_Bench_Responses[i], &Value))
+            {
+                *p_Sum += Value;
+            }
+            else
+            {
+                (*p_Failed)++;
+            }
+        }
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(End - Start).count() / (Iterations * RAK3172_BENCH_RESPONSES);
+}
+
+int main(int argc, char** argv)
+{
+    size_t Iterations;
+    size_t Errors;
+    size_t StoiFailed;
+    size_t ParserFailed;
+    int64_t StoiSum;
+    int64_t ParserSum;
+    int32_t Value;
+    uint32_t Mask;
+
+    Iterations = 200000;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    // The parser must reject garbled and out of range values without changing the output.
+    Errors = 0;
+    Value = 42;
+    if(RAK3172_Number_To("12a", &Value) || RAK3172_Number_To("2147483648", &Value) || (Value != 42))
+    {
+        Errors++;
+    }
+
+    if((RAK3172_Number_To("-2147483648", &Value) == false) || (Value != INT32_MIN))
+    {
+        Errors++;
+    }
+
+    if((RAK3172_Number_To("FF00", &Mask, 16) == false) || (Mask != 0xFF00))
+    {
+        Errors++;
+    }
+
+    double Stoi = RAK3172_Bench_Run(RAK3172_Bench_Stoi, Iterations, &StoiSum, &StoiFailed);
+    double Parser = RAK3172_Bench_Run(RAK3172_Bench_Parser, Iterations, &ParserSum, &ParserFailed);
+
+    // Both parsers must agree on the valid responses.
+    if((StoiSum != ParserSum) || (StoiFailed != ParserFailed))
+    {
+        Errors++;
+    }
+
+    printf("Iterations:         %zu\n", Iterations);
+    printf("std::stoi:          %.1f ns/response\n", Stoi);
+    printf("Parser:             %.1f ns/response\n", Parser);
+    printf("Speedup:            %.2fx\n", Stoi / Parser);
+    printf("Rejected:           %zu of %zu responses\n", ParserFailed / Iterations, RAK3172_BENCH_RESPONSES);
+
+    return (Errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+ /*
+ * rak3172_bench_replay.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replay of recorded RAK3172 UART captures.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rak3172_capture_types.h"
+
+#include "../../src/Parser/rak3172_classifier.h"
+#include "../../src/Parser/rak3172_line_parser.h"
+
+/** @brief Command and response pairs used to synthesize a capture when no capture file is given.
+ */
+static const struct
+{
+    const char* Command;
+    const char* Response;
+    uint32_t Latency;
+} _RAK3172_Replay_Script[] = {
+    {"AT+DR=?",                 "AT+DR=3\r\nOK\r\n",                                                    4200},
+    {"AT+ADR=1",                "OK\r\n",                                                               6100},
+    {"AT+SEND=2:0102030405",    "OK\r\n+EVT:TX_DONE\r\n",                                               9800},
+    {"AT+RETY=?",               "AT+RETY=3\r\nOK\r\n",                                                  3900},
+    {"AT+NJS=?",                "AT+NJS=1\r\nOK\r\n",                                                   4100},
+    {"AT+SEND=2:0102030405",    "OK\r\n+EVT:SEND_CONFIRMED_OK\r\n+EVT:RX_1:-89:4:UNICAST:2:A1B2\r\n",  10400},
+    {"AT+BAND=?",               "AT+BAND=4\r\nOK\r\n",                                                  4300},
+    {"AT+LINKCHECK=1",          "OK\r\n",                                                              12000},
+};
+
+/** @brief Latency statistics of a command.
+ */
+typedef struct
+{
+    uint32_t Count;
+    uint64_t Sum;
+    uint32_t Max;
+} RAK3172_Replay_Latency_t;
+
+/** @brief Replay state for the line callback.
+ */
+typedef struct
+{
+    uint32_t Timestamp;                                                 /**< Time of the record which is processed. */
+    std::deque<std::pair<std::string, uint32_t>> Pending;               /**< Transmitted commands without status. */
+    std::map<std::string, RAK3172_Replay_Latency_t> Latencies;          /**< Latency statistics for each command. */
+    size_t Events[RAK_EVENT_MAX];                                       /**< Number of lines for each line type. */
+    size_t Lines;                                                       /**< Number of received lines. */
+    bool isTiming;                                                      /**< #true when the command latencies are collected. */
+} RAK3172_Replay_State_t;
+
+/** @brief          Add a record to a capture.
+ *  @param p_Capture Pointer to capture
+ *  @param Timestamp Record time in microseconds
+ *  @param Type     Record type
+ *  @param Data     Record data
+ */
+static void RAK3172_Replay_Append(std::vector<uint8_t>* p_Capture, uint32_t Timestamp, RAK3172_CaptureType_t Type, const std::string& Data)
+{
+    uint8_t Header[RAK3172_CAPTURE_HEADER_SIZE];
+
+    RAK3172_Capture_EncodeHeader(Header, Timestamp, Type, static_cast<uint16_t>(Data.size()));
+    p_Capture->insert(p_Capture->end(), Header, Header + sizeof(Header));
+    p_Capture->insert(p_Capture->end(), Data.begin(), Data.end());
+}
+
+/** @brief          Synthesize a capture from the command script.
+ *  @param Count    Number of script runs
+ *  @return         Encoded capture
+ */
+static std::vector<uint8_t> RAK3172_Replay_Synthesize(size_t Count)
+{
+    uint32_t Timestamp;
+    std::vector<uint8_t> Capture;
+
+    Timestamp = 0;
+    for(size_t i = 0; i < Count; i++)
+    {
+        for(size_t j = 0; j < (sizeof(_RAK3172_Replay_Script) / sizeof(_RAK3172_Replay_Script[0])); j++)
+        {
+            std::string Response(_RAK3172_Replay_Script[j].Response);
+            size_t Split;
+
+            RAK3172_Replay_Append(&Capture, Timestamp, RAK_CAPTURE_TX, std::string(_RAK3172_Replay_Script[j].Command) + "\r\n");
+            Timestamp += _RAK3172_Replay_Script[j].Latency + ((i * 7919 + j * 104729) % 1500);
+
+            // The UART driver delivers a response in multiple chunks.
+            Split = Response.size() / 3;
+            RAK3172_Replay_Append(&Capture, Timestamp, RAK_CAPTURE_RX, Response.substr(0, Split));
+            RAK3172_Replay_Append(&Capture, Timestamp + 120, RAK_CAPTURE_RX, Response.substr(Split));
+            Timestamp += 20000;
+        }
+
+        // Simulate a FIFO overflow with a lost partial line from time to time.
+        if((i % 97) == 96)
+        {
+            RAK3172_Replay_Append(&Capture, Timestamp, RAK_CAPTURE_RX, "+EVT:RX_1:-9");
+            RAK3172_Replay_Append(&Capture, Timestamp + 10, RAK_CAPTURE_LOST, "");
+            RAK3172_Replay_Append(&Capture, Timestamp + 20, RAK_CAPTURE_RX, "B2\r\n");
+        }
+    }
+
+    return Capture;
+}
+
+/** @brief          Get the name of a command without the value.
+ *  @param Command  Command without line ending
+ *  @return         Command name
+ */
+static std::string RAK3172_Replay_GetName(const std::string& Command)
+{
+    size_t Index;
+
+    Index = Command.find('=');
+    if(Index == std::string::npos)
+    {
+        return Command;
+    }
+
+    return Command.substr(0, Index + ((Command.compare(Index, std::string::npos, "=?") == 0) ? 2 : 1));
+}
+
+/** @brief          Line callback of the replay.
+ *  @param p_Arg    Pointer to replay state
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ */
+static void RAK3172_Replay_OnLine(void* p_Arg, char* p_Line, size_t Length)
+{
+    RAK3172_Event_t Event;
+    RAK3172_Replay_State_t* State = static_cast<RAK3172_Replay_State_t*>(p_Arg);
+
+    State->Lines++;
+
+    Event = RAK3172_Classifier_Classify(p_Line, Length);
+    State->Events[Event]++;
+
+    if((State->isTiming == false) || (Event != RAK_EVENT_NONE) || State->Pending.empty())
+    {
+        return;
+    }
+
+    // Same status detection as the command layer of the driver.
+    if((strcmp(p_Line, "OK") == 0) || (strncmp(p_Line, "AT_", 3) == 0) || (strstr(p_Line, "ERROR") != NULL) ||
+       (strstr(p_Line, "Command not found") != NULL))
+    {
+        uint32_t Latency;
+        RAK3172_Replay_Latency_t* Statistic;
+
+        Latency = State->Timestamp - State->Pending.front().second;
+        Statistic = &State->Latencies[State->Pending.front().first];
+        Statistic->Count++;
+        Statistic->Sum += Latency;
+        if(Latency > Statistic->Max)
+        {
+            Statistic->Max = Latency;
+        }
+
+        State->Pending.pop_front();
+    }
+}
+
+/** @brief          Replay a capture through the line parser and the line classifier.
+ *  @param Capture  Encoded capture
+ *  @param p_State  Pointer to replay state
+ *  @return         Number of received bytes
+ */
+static size_t RAK3172_Replay_Run(const std::vector<uint8_t>& Capture, RAK3172_Replay_State_t* p_State)
+{
+    size_t Offset;
+    size_t Received;
+    size_t Length;
+    std::string Transmit;
+    char Buffer[545];
+    RAK3172_LineParser_t Parser;
+    RAK3172_CaptureRecord_t Record;
+
+    RAK3172_LineParser_Init(&Parser, Buffer, sizeof(Buffer), RAK3172_Replay_OnLine, p_State);
+
+    Offset = 0;
+    Received = 0;
+    while((Length = RAK3172_Capture_Decode(&Capture[Offset], Capture.size() - Offset, &Record)) > 0)
+    {
+        p_State->Timestamp = Record.Timestamp;
+
+        switch(Record.Type)
+        {
+            case RAK_CAPTURE_TX:
+            {
+                if(p_State->isTiming)
+                {
+                    size_t End;
+
+                    // Commands can be split across multiple writes.
+                    Transmit.append(reinterpret_cast<const char*>(Record.Data), Record.Length);
+                    while((End = Transmit.find("\r\n")) != std::string::npos)
+                    {
+                        p_State->Pending.emplace_back(RAK3172_Replay_GetName(Transmit.substr(0, End)), Record.Timestamp);
+                        Transmit.erase(0, End + 2);
+                    }
+                }
+
+                break;
+            }
+            case RAK_CAPTURE_RX:
+            {
+                RAK3172_LineParser_Feed(&Parser, Record.Data, Record.Length);
+                Received += Record.Length;
+
+                break;
+            }
+            case RAK_CAPTURE_LOST:
+            {
+                // Same handling as the stream mode of the driver.
+                RAK3172_LineParser_Reset(&Parser, true);
+
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        Offset += Length;
+    }
+
+    if(Offset != Capture.size())
+    {
+        printf("Warning: %zu bytes of incomplete record at the end of the capture\n", Capture.size() - Offset);
+    }
+
+    return Received;
+}
+
+int main(int argc, char** argv)
+{
+    size_t Received;
+    size_t Runs;
+    size_t Records[3] = {0, 0, 0};
+    size_t Bytes[3] = {0, 0, 0};
+    uint32_t First;
+    uint32_t Last;
+    std::vector<uint8_t> Capture;
+    RAK3172_Replay_State_t State = {};
+    RAK3172_CaptureRecord_t Record;
+    static const char* Names[] = {"None", "Restricted", "Unknown", "Joined", "Join failed", "TX done", "Confirmed", "Not confirmed", "RX",
+                                  "P2P RX timeout", "P2P RX"};
+
+    static_assert((sizeof(Names) / sizeof(Names[0])) == RAK_EVENT_MAX, "Missing event name!");
+
+    if(argc > 1)
+    {
+        FILE* File;
+        uint8_t Chunk[4096];
+        size_t Length;
+
+        File = fopen(argv[1], "rb");
+        if(File == NULL)
+        {
+            printf("Cannot open %s\n", argv[1]);
+
+            return 1;
+        }
+
+        while((Length = fread(Chunk, 1, sizeof(Chunk), File)) > 0)
+        {
+            Capture.insert(Capture.end(), Chunk, Chunk + Length);
+        }
+        fclose(File);
+
+        printf("Capture:        %s\n", argv[1]);
+    }
+    else
+    {
+        Capture = RAK3172_Replay_Synthesize(10000);
+
+        printf("Capture:        synthetic\n");
+    }
+
+    // Capture summary.
+    First = 0;
+    Last = 0;
+    for(size_t Offset = 0, Length; (Length = RAK3172_Capture_Decode(&Capture[Offset], Capture.size() - Offset, &Record)) > 0; Offset += Length)
+    {
+        if(Record.Type > RAK_CAPTURE_LOST)
+        {
+            printf("Invalid record type %u at offset %zu\n", static_cast<unsigned int>(Record.Type), Offset);
+
+            return 1;
+        }
+
+        if((Records[0] + Records[1] + Records[2]) == 0)
+        {
+            First = Record.Timestamp;
+        }
+        Last = Record.Timestamp;
+
+        Records[Record.Type]++;
+        Bytes[Record.Type] += Record.Length;
+    }
+
+    printf("Size:           %zu bytes\n", Capture.size());
+    printf("Duration:       %.3f s\n", static_cast<uint32_t>(Last - First) / 1e6);
+    printf("Transmitted:    %zu records, %zu bytes\n", Records[RAK_CAPTURE_TX], Bytes[RAK_CAPTURE_TX]);
+    printf("Received:       %zu records, %zu bytes\n", Records[RAK_CAPTURE_RX], Bytes[RAK_CAPTURE_RX]);
+    printf("Lost:           %zu\n", Records[RAK_CAPTURE_LOST]);
+
+    // Analyze the recorded traffic.
+    State.isTiming = true;
+    RAK3172_Replay_Run(Capture, &State);
+
+    printf("\nLines:          %zu\n", State.Lines);
+    for(size_t i = 0; i < RAK_EVENT_MAX; i++)
+    {
+        if(State.Events[i] > 0)
+        {
+            printf("  %-14s %zu\n", Names[i], State.Events[i]);
+        }
+    }
+
+    printf("\n%-16s %8s %10s %10s\n", "Command", "Count", "Mean [us]", "Max [us]");
+    for(const auto& Entry : State.Latencies)
+    {
+        printf("%-16s %8u %10llu %10u\n", Entry.first.c_str(), Entry.second.Count,
+               static_cast<unsigned long long>(Entry.second.Sum / Entry.second.Count), Entry.second.Max);
+    }
+    if(State.Pending.empty() == false)
+    {
+        printf("%zu commands without status\n", State.Pending.size());
+    }
+
+    // Benchmark the receive path with the recorded chunks.
+    Runs = 0;
+    Received = 0;
+    auto Start = std::chrono::steady_clock::now();
+    auto End = Start;
+    do
+    {
+        RAK3172_Replay_State_t Bench = {};
+
+        Received += RAK3172_Replay_Run(Capture, &Bench);
+        Runs++;
+        End = std::chrono::steady_clock::now();
+    } while(std::chrono::duration<double>(End - Start).count() < 0.5);
+
+    double Seconds = std::chrono::duration<double>(End - Start).count();
+
+    printf("\nReplay:         %zu runs, %.1f MB/s, %.1f ns/line\n", Runs, (Received / Seconds) / (1024.0 * 1024.0),
+           (Seconds * 1e9) / (static_cast<double>(State.Lines) * Runs));
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+ /*
+ * rak3172_bench_wait.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host benchmark for the wake up latency of polling and event based waits.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <condition_variable>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** @brief Poll period of the old wait loops in milliseconds.
+ */
+#define RAK3172_BENCH_POLL_PERIOD                               20
+
+typedef std::chrono::steady_clock RAK3172_Bench_Clock_t;
+
+/** @brief Shared state between the simulated event task and the waiting task.
+ */
+typedef struct
+{
+    std::mutex Lock;
+    std::condition_variable Event;
+    std::atomic<bool> isBusy;
+    RAK3172_Bench_Clock_t::time_point Signaled;
+} RAK3172_Bench_State_t;
+
+/** @brief          Wait by polling the busy flag, like the previous implementation.
+ *  @param p_State  Pointer to shared state
+ */
+static void RAK3172_Bench_WaitPoll(RAK3172_Bench_State_t* p_State)
+{
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(RAK3172_BENCH_POLL_PERIOD));
+    } while(p_State->isBusy);
+}
+
+/** @brief          Wait by blocking until the busy flag is cleared, like the event group based implementation.
+ *  @param p_State  Pointer to shared state
+ */
+static void RAK3172_Bench_WaitEvent(RAK3172_Bench_State_t* p_State)
+{
+    std::unique_lock<std::mutex> Lock(p_State->Lock);
+
+    p_State->Event.wait(Lock, [p_State] { return p_State->isBusy == false; });
+}
+
+/** @brief              Run a number of busy / idle cycles and measure the latency between the state change and the wake up.
+ *  @param Wait         Wait function
+ *  @param Iterations   Number of cycles
+ *  @param p_Latency    Pointer to latency list in microseconds
+ */
+static void RAK3172_Bench_Run(void (*Wait)(RAK3172_Bench_State_t*), size_t Iterations, std::vector<double>* p_Latency)
+{
+    RAK3172_Bench_State_t State;
+    std::mt19937 Random(1234);
+    std::uniform_int_distribution<int> Delay(1, 50);
+
+    for(size_t i = 0; i < Iterations; i++)
+    {
+        State.isBusy = true;
+
+        // The event task finishes the operation after a random time.
+        std::thread Task([&State, &Random, &Delay]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(Delay(Random)));
+
+            {
+                std::lock_guard<std::mutex> Lock(State.Lock);
+
+                State.Signaled = RAK3172_Bench_Clock_t::now();
+                State.isBusy = false;
+            }
+
+            State.Event.notify_all();
+        });
+
+        Wait(&State);
+        auto Woken = RAK3172_Bench_Clock_t::now();
+
+        Task.join();
+
+        p_Latency->push_back(std::chrono::duration<double, std::micro>(Woken - State.Signaled).count());
+    }
+
+    std::sort(p_Latency->begin(), p_Latency->end());
+}
+
+/** @brief              Print the latency statistics.
+ *  @param p_Name       Name of the wait method
+ *  @param p_Latency    Pointer to sorted latency list in microseconds
+ */
+static void RAK3172_Bench_Print(const char* p_Name, const std::vector<double>* p_Latency)
+{
+    double Sum = 0.0;
+
+    for(double Value : *p_Latency)
+    {
+        Sum += Value;
+    }
+
+    printf("%-8s mean %9.1f us, p50 %9.1f us, p99 %9.1f us, max %9.1f us\n", p_Name, Sum / p_Latency->size(),
+           (*p_Latency)[p_Latency->size() / 2], (*p_Latency)[(p_Latency->size() * 99) / 100], p_Latency->back());
+}
+
+int main(int argc, char** argv)
+{
+    size_t Iterations;
+    std::vector<double> Poll;
+    std::vector<double> Event;
+
+    Iterations = 200;
+    if(argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 10);
+    }
+
+    printf("Iterations:     %zu\n", Iterations);
+
+    RAK3172_Bench_Run(RAK3172_Bench_WaitPoll, Iterations, &Poll);
+    RAK3172_Bench_Run(RAK3172_Bench_WaitEvent, Iterations, &Event);
+
+    RAK3172_Bench_Print("Poll", &Poll);
+    RAK3172_Bench_Print("Event", &Event);
+
+    return 0;
+}
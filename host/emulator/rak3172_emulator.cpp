@@ -0,0 +1,1098 @@
+ /*
+ * rak3172_emulator.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: AT firmware emulator of the RAK3172 for the host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <sstream>
+#include <poll.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_timer.h"
+
+#include "rak3172_shim.h"
+#include "rak3172_emulator.h"
+
+typedef std::chrono::steady_clock RAK3172_Emulator_Clock_t;
+typedef RAK3172_Emulator_Clock_t::time_point RAK3172_Emulator_Time_t;
+
+/** @brief Actions which are executed when an output of the emulator is transmitted.
+ */
+typedef enum
+{
+    RAK_EMULATOR_ACTION_NONE = 0,       /**< No action. */
+    RAK_EMULATOR_ACTION_JOINED,         /**< The network is joined. */
+    RAK_EMULATOR_ACTION_JOIN_FAILED,    /**< A join attempt has failed. */
+    RAK_EMULATOR_ACTION_TX_END,         /**< The LoRaWAN transmission is finished. */
+    RAK_EMULATOR_ACTION_RX,             /**< A receive event was transmitted. */
+    RAK_EMULATOR_ACTION_BAUDRATE,       /**< Switch to a new baudrate. */
+} RAK3172_EmulatorAction_t;
+
+/** @brief Output object of the emulator.
+ */
+typedef struct
+{
+    std::string Data;                   /**< Data with line endings. */
+    RAK3172_EmulatorAction_t Action;    /**< Action which is executed after the transmission. */
+    uint32_t Argument;                  /**< Argument of the action. */
+} RAK3172_EmulatorOutput_t;
+
+/** @brief Received LoRaWAN or P2P frame.
+ */
+typedef struct
+{
+    std::string Payload;                /**< Payload in hex notation. */
+    uint8_t Port;                       /**< LoRaWAN port. */
+    int8_t RSSI;                        /**< RSSI value. */
+    int8_t SNR;                         /**< SNR value. */
+    bool isMulticast;                   /**< #true for a multicast downlink. */
+} RAK3172_EmulatorFrame_t;
+
+/** @brief Emulator object.
+ */
+struct RAK3172_Emulator_s
+{
+    RAK3172_EmulatorConfig_t Config;                                        /**< Emulator configuration. */
+    int Fd;                                                                 /**< Module side of the shim UART. */
+    int Wake[2];                                                            /**< Pipe to wake up the emulator task. */
+    std::mutex Mutex;                                                       /**< Lock for the emulator state. */
+    std::atomic<bool> isRunning;                                            /**< #true while the emulator task is running. */
+    std::thread Task;                                                       /**< Emulator task. */
+    std::string Line;                                                       /**< Partially received command. */
+    std::deque<std::pair<RAK3172_Emulator_Time_t, std::string>> Input;      /**< Received commands with the time of the processing. */
+    RAK3172_Emulator_Time_t InputFree;                                      /**< End of the last command on the wire. */
+    RAK3172_Emulator_Time_t Processed;                                      /**< End of the processing of the last command. */
+    std::multimap<RAK3172_Emulator_Time_t, RAK3172_EmulatorOutput_t> Scheduled;    /**< Outputs which are not ready for transmission. */
+    std::deque<std::pair<RAK3172_Emulator_Time_t, RAK3172_EmulatorOutput_t>> Outgoing;     /**< Outputs with the end of the transmission on the wire. */
+    RAK3172_Emulator_Time_t WireFree;                                       /**< End of the last output on the wire. */
+    std::map<std::string, std::string> Values;                              /**< Settings of the module. */
+    bool isLoRaWAN;                                                         /**< #true in LoRaWAN mode. */
+    bool isJoined;                                                          /**< #true when the network is joined. */
+    bool isTxBusy;                                                          /**< #true during a LoRaWAN transmission. */
+    uint8_t JoinFailures;                                                   /**< Remaining failed join attempts. */
+    std::deque<RAK3172_EmulatorFrame_t> Downlinks;                          /**< Queued LoRaWAN downlinks. */
+    std::deque<RAK3172_EmulatorFrame_t> Packets;                            /**< Queued P2P packets. */
+    bool isP2PReceiving;                                                    /**< #true in P2P receive mode. */
+    bool isP2PContinuous;                                                   /**< #true when the P2P receive mode is kept after a packet. */
+    RAK3172_Emulator_Time_t P2PDeadline;                                    /**< End of the P2P receive window. */
+    RAK3172_EmulatorStats_t Stats;                                          /**< Emulator statistics. */
+};
+
+/** @brief Default settings of the emulated module.
+ */
+static const std::pair<const char*, const char*> _RAK3172_Emulator_Defaults[] = {
+    {"AT+VER",          "RUI_4.0.6_RAK3172-E"},
+    {"AT+CLIVER",       "1.5.14"},
+    {"AT+APIVER",       "3.2.8"},
+    {"AT+HWMODEL",      "rak3172"},
+    {"AT+HWID",         "stm32wle5xx"},
+    {"AT+BUILDTIME",    "Jan 1 2025-00:00:00"},
+    {"AT+REPOINFO",     "emulator"},
+    {"AT+SN",           "1234567890"},
+    {"AT+BAUD",         "115200"},
+    {"AT+DEVEUI",       "AC1F09FFFE000001"},
+    {"AT+APPEUI",       "0000000000000000"},
+    {"AT+APPKEY",       "2B7E151628AED2A6ABF7158809CF4F3C"},
+    {"AT+DEVADDR",      "26011B01"},
+    {"AT+APPSKEY",      "2B7E151628AED2A6ABF7158809CF4F3C"},
+    {"AT+NWKSKEY",      "2B7E151628AED2A6ABF7158809CF4F3C"},
+    {"AT+NETID",        "000000"},
+    {"AT+CLASS",        "A"},
+    {"AT+ADR",          "0"},
+    {"AT+BAND",         "4"},
+    {"AT+NJM",          "1"},
+    {"AT+MASK",         "0001"},
+    {"AT+TXP",          "0"},
+    {"AT+DR",           "0"},
+    {"AT+CFM",          "0"},
+    {"AT+RETY",         "0"},
+    {"AT+P2P",          "868000000:7:125:0:8:14"},
+    {"AT+ENCRY",        "0"},
+    {"AT+IQINVER",      "0"},
+    {"AT+LPMLVL",       "1"},
+};
+
+/** @brief              Get the time which is needed to transmit a number of bytes with the current baudrate.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Bytes        Number of bytes
+ *  @return             Wire time
+ */
+static RAK3172_Emulator_Clock_t::duration RAK3172_Emulator_WireTime(const RAK3172_Emulator_t* p_Emulator, size_t Bytes)
+{
+    if(p_Emulator->Config.Baudrate == 0)
+    {
+        return RAK3172_Emulator_Clock_t::duration::zero();
+    }
+
+    // One start bit, eight data bits and one stop bit per byte.
+    return std::chrono::duration_cast<RAK3172_Emulator_Clock_t::duration>(std::chrono::nanoseconds((Bytes * 10ULL * 1000000000ULL) / p_Emulator->Config.Baudrate));
+}
+
+/** @brief          Check if a string contains an even number of hex characters.
+ *  @param Hex      Hex string
+ *  @return         #true when the string is valid
+ */
+static bool RAK3172_Emulator_isHex(const std::string& Hex)
+{
+    if((Hex.size() % 2) != 0)
+    {
+        return false;
+    }
+
+    for(char Character : Hex)
+    {
+        if(isxdigit(static_cast<unsigned char>(Character)) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** @brief          Convert a binary buffer into an uppercase hex string.
+ *  @param p_Data   Pointer to data
+ *  @param Length   Data length
+ *  @return         Hex string
+ */
+static std::string RAK3172_Emulator_ToHex(const uint8_t* p_Data, size_t Length)
+{
+    static const char Digits[] = "0123456789ABCDEF";
+    std::string Hex;
+
+    Hex.reserve(2 * Length);
+    for(size_t i = 0; i < Length; i++)
+    {
+        Hex += Digits[p_Data[i] >> 4];
+        Hex += Digits[p_Data[i] & 0x0F];
+    }
+
+    return Hex;
+}
+
+/** @brief              Wake up the emulator task after a change from another thread.
+ *  @param p_Emulator   Pointer to emulator object
+ */
+static void RAK3172_Emulator_Wake(RAK3172_Emulator_t* p_Emulator)
+{
+    char Byte = 0;
+
+    if(write(p_Emulator->Wake[1], &Byte, 1) < 0)
+    {
+        // The pipe is full, so the emulator task wakes up anyway.
+    }
+}
+
+/** @brief              Schedule an output.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Due          Time when the output is ready for transmission
+ *  @param Data         Output data with line endings
+ *  @param Action       Action which is executed after the transmission
+ *  @param Argument     Argument of the action
+ */
+static void RAK3172_Emulator_Schedule(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Due, std::string Data,
+                                      RAK3172_EmulatorAction_t Action = RAK_EMULATOR_ACTION_NONE, uint32_t Argument = 0)
+{
+    // Outputs with the same time keep the order of scheduling.
+    p_Emulator->Scheduled.emplace(Due, RAK3172_EmulatorOutput_t{std::move(Data), Action, Argument});
+}
+
+/** @brief              Schedule a status response.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param p_Status     Status
+ *  @param Action       Action which is executed after the transmission
+ *  @param Argument     Argument of the action
+ */
+static void RAK3172_Emulator_Status(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, const char* p_Status,
+                                    RAK3172_EmulatorAction_t Action = RAK_EMULATOR_ACTION_NONE, uint32_t Argument = 0)
+{
+    std::string Data;
+
+    if(strcmp(p_Status, "OK") != 0)
+    {
+        p_Emulator->Stats.Errors++;
+    }
+
+    // Firmware without RUI3 transmits an empty line in front of the status.
+    if(p_Emulator->Config.Dialect == RAK_EMULATOR_LEGACY)
+    {
+        Data = "\r\n";
+    }
+
+    Data += p_Status;
+    Data += "\r\n";
+
+    RAK3172_Emulator_Schedule(p_Emulator, Now, std::move(Data), Action, Argument);
+}
+
+/** @brief              Schedule the response of a query.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param Command      Command without '=?'
+ *  @param Value        Returned value
+ */
+static void RAK3172_Emulator_Value(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, const std::string& Command, const std::string& Value)
+{
+    if(p_Emulator->Config.Dialect == RAK_EMULATOR_RUI3)
+    {
+        RAK3172_Emulator_Schedule(p_Emulator, Now, Command + "=" + Value + "\r\nOK\r\n");
+    }
+    else
+    {
+        RAK3172_Emulator_Schedule(p_Emulator, Now, Value + "\r\n\r\nOK\r\n");
+    }
+}
+
+/** @brief              Schedule the splash screen after a reset. The last line contains the work mode.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ */
+static void RAK3172_Emulator_Splash(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now)
+{
+    std::string Data;
+
+    if(p_Emulator->Config.Dialect == RAK_EMULATOR_RUI3)
+    {
+        Data = "RAKwireless RAK3172 Example\r\n------------------------------------------------------\r\n";
+    }
+    else
+    {
+        Data = "UART1 AT mode on\r\n";
+    }
+
+    Data += p_Emulator->isLoRaWAN ? "Current Work Mode: LoRaWAN.\r\n" : "Current Work Mode: LoRa P2P.\r\n";
+
+    RAK3172_Emulator_Schedule(p_Emulator, Now, std::move(Data));
+}
+
+/** @brief              Remove all scheduled join results.
+ *  @param p_Emulator   Pointer to emulator object
+ */
+static void RAK3172_Emulator_CancelJoin(RAK3172_Emulator_t* p_Emulator)
+{
+    for(auto it = p_Emulator->Scheduled.begin(); it != p_Emulator->Scheduled.end();)
+    {
+        if((it->second.Action == RAK_EMULATOR_ACTION_JOINED) || (it->second.Action == RAK_EMULATOR_ACTION_JOIN_FAILED))
+        {
+            it = p_Emulator->Scheduled.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+/** @brief              Reset the module state.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param isFactory    #true to restore the default settings
+ */
+static void RAK3172_Emulator_Reset(RAK3172_Emulator_t* p_Emulator, bool isFactory)
+{
+    p_Emulator->Scheduled.clear();
+    p_Emulator->isJoined = false;
+    p_Emulator->isTxBusy = false;
+    p_Emulator->isP2PReceiving = false;
+
+    if(isFactory)
+    {
+        for(const auto& Default : _RAK3172_Emulator_Defaults)
+        {
+            p_Emulator->Values[Default.first] = Default.second;
+        }
+    }
+}
+
+/** @brief              Schedule a LoRaWAN uplink and the following events.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param Port         LoRaWAN port
+ *  @param isConfirmed  #true for a confirmed uplink
+ *  @param Payload      Payload in hex notation
+ */
+static void RAK3172_Emulator_Uplink(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, long Port, bool isConfirmed, const std::string& Payload)
+{
+    RAK3172_Emulator_Time_t Done;
+    bool isLegacy = (p_Emulator->Config.Dialect == RAK_EMULATOR_LEGACY);
+
+    if(p_Emulator->isLoRaWAN == false)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_MODE_NO_SUPPORT");
+
+        return;
+    }
+    else if(p_Emulator->isJoined == false)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_NO_NETWORK_JOINED");
+
+        return;
+    }
+    else if(p_Emulator->isTxBusy)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_BUSY_ERROR");
+
+        return;
+    }
+    else if((Port < 1) || (Port > 233) || Payload.empty() || (RAK3172_Emulator_isHex(Payload) == false))
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+
+        return;
+    }
+
+    p_Emulator->isTxBusy = true;
+    p_Emulator->Stats.Uplinks++;
+    RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+
+    Done = Now + std::chrono::milliseconds(p_Emulator->Config.TxTime);
+    if(isConfirmed)
+    {
+        RAK3172_Emulator_Schedule(p_Emulator, Done, isLegacy ? "+EVT:SEND CONFIRMED OK\r\n" : "+EVT:SEND_CONFIRMED_OK\r\n");
+    }
+
+    // A queued downlink is received in the receive window after the uplink.
+    if(p_Emulator->Downlinks.empty() == false)
+    {
+        std::string Data;
+        RAK3172_EmulatorFrame_t& Frame = p_Emulator->Downlinks.front();
+
+        if(isLegacy)
+        {
+            //  +EVT:RX_1, RSSI -89, SNR 4
+            //  +EVT:2:1234
+            Data = "+EVT:RX_1, RSSI " + std::to_string(Frame.RSSI) + ", SNR " + std::to_string(Frame.SNR) + "\r\n+EVT:" +
+                   std::to_string(Frame.Port) + ":" + Frame.Payload + "\r\n";
+        }
+        else
+        {
+            //  +EVT:RX_1:-89:4:UNICAST:2:1234
+            //  +EVT:RX_C:-89:4:MULCAST:2:1234
+            Data = std::string(Frame.isMulticast ? "+EVT:RX_C:" : "+EVT:RX_1:") + std::to_string(Frame.RSSI) + ":" + std::to_string(Frame.SNR) +
+                   (Frame.isMulticast ? ":MULCAST:" : ":UNICAST:") + std::to_string(Frame.Port) + ":" + Frame.Payload + "\r\n";
+        }
+
+        RAK3172_Emulator_Schedule(p_Emulator, Done, std::move(Data), RAK_EMULATOR_ACTION_RX);
+        p_Emulator->Downlinks.pop_front();
+    }
+
+    if(isConfirmed == false)
+    {
+        RAK3172_Emulator_Schedule(p_Emulator, Done, "+EVT:TX_DONE\r\n");
+    }
+
+    RAK3172_Emulator_Schedule(p_Emulator, Done, "", RAK_EMULATOR_ACTION_TX_END);
+}
+
+/** @brief              Schedule the join attempts.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param Argument     Join arguments "<Join>:<Auto>:<Interval>:<Attempts>"
+ */
+static void RAK3172_Emulator_Join(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, const std::string& Argument)
+{
+    long Join;
+    long Attempts;
+    char* p_End;
+
+    if(p_Emulator->isLoRaWAN == false)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_MODE_NO_SUPPORT");
+
+        return;
+    }
+
+    Join = strtol(Argument.c_str(), &p_End, 10);
+    Attempts = 1;
+    for(uint8_t i = 0; (i < 3) && (*p_End == ':'); i++)
+    {
+        Attempts = strtol(p_End + 1, &p_End, 10);
+    }
+
+    RAK3172_Emulator_CancelJoin(p_Emulator);
+    RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+
+    if(Join == 0)
+    {
+        return;
+    }
+
+    // Firmware without RUI3 performs a single attempt per command.
+    if((p_Emulator->Config.Dialect == RAK_EMULATOR_LEGACY) || (Attempts < 1))
+    {
+        Attempts = 1;
+    }
+
+    p_Emulator->isJoined = false;
+    for(long i = 1; i <= Attempts; i++)
+    {
+        RAK3172_Emulator_Time_t Due = Now + (i * std::chrono::milliseconds(p_Emulator->Config.JoinTime));
+
+        p_Emulator->Stats.Joins++;
+
+        if(p_Emulator->JoinFailures > 0)
+        {
+            p_Emulator->JoinFailures--;
+            RAK3172_Emulator_Schedule(p_Emulator, Due, (p_Emulator->Config.Dialect == RAK_EMULATOR_LEGACY) ? "+EVT:JOIN FAILED\r\n" : "+EVT:JOIN_FAILED_RX_TIMEOUT\r\n",
+                                      RAK_EMULATOR_ACTION_JOIN_FAILED);
+        }
+        else
+        {
+            RAK3172_Emulator_Schedule(p_Emulator, Due, "+EVT:JOINED\r\n", RAK_EMULATOR_ACTION_JOINED);
+
+            break;
+        }
+    }
+}
+
+/** @brief              Start or stop the P2P receive mode.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param Timeout      Receive timeout in milliseconds or one of the special values of AT+PRECV
+ */
+static void RAK3172_Emulator_P2PReceive(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, long Timeout)
+{
+    if(p_Emulator->isLoRaWAN)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_MODE_NO_SUPPORT");
+
+        return;
+    }
+    else if((Timeout < 0) || (Timeout > 65535))
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+
+        return;
+    }
+
+    RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+
+    //  0           Stop the receive mode
+    //  65533       Receive until a packet is received
+    //  65534       Receive continuously
+    //  65535       Receive until a packet is received
+    p_Emulator->isP2PReceiving = (Timeout != 0);
+    p_Emulator->isP2PContinuous = (Timeout == 65534);
+    if(Timeout >= 65533)
+    {
+        p_Emulator->P2PDeadline = RAK3172_Emulator_Time_t::max();
+    }
+    else
+    {
+        p_Emulator->P2PDeadline = Now + std::chrono::milliseconds(Timeout);
+    }
+}
+
+/** @brief              Process a command from the driver.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param Command      Command without line ending
+ */
+static void RAK3172_Emulator_Process(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, const std::string& Command)
+{
+    size_t Index;
+    std::string Key;
+    std::string Argument;
+
+    p_Emulator->Stats.Commands++;
+
+    if((Command == "AT") || (Command == "ATE"))
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+
+        return;
+    }
+    else if((Command == "ATZ") || (Command == "ATR"))
+    {
+        RAK3172_Emulator_Reset(p_Emulator, Command == "ATR");
+        RAK3172_Emulator_Splash(p_Emulator, Now);
+
+        return;
+    }
+
+    Index = Command.find('=');
+    if(Index == std::string::npos)
+    {
+        RAK3172_Emulator_Status(p_Emulator, Now, "AT_COMMAND_NOT_FOUND");
+
+        return;
+    }
+
+    Key = Command.substr(0, Index);
+    Argument = Command.substr(Index + 1);
+
+    if(Argument == "?")
+    {
+        if(Key == "AT+NWM")
+        {
+            RAK3172_Emulator_Value(p_Emulator, Now, Key, p_Emulator->isLoRaWAN ? "1" : "0");
+        }
+        else if(Key == "AT+NJS")
+        {
+            RAK3172_Emulator_Value(p_Emulator, Now, Key, p_Emulator->isJoined ? "1" : "0");
+        }
+        else
+        {
+            auto Value = p_Emulator->Values.find(Key);
+
+            if(Value == p_Emulator->Values.end())
+            {
+                RAK3172_Emulator_Status(p_Emulator, Now, "AT_COMMAND_NOT_FOUND");
+            }
+            else
+            {
+                RAK3172_Emulator_Value(p_Emulator, Now, Key, Value->second);
+            }
+        }
+    }
+    else if(Key == "AT+NWM")
+    {
+        bool isLoRaWAN = (Argument == "1");
+
+        if((Argument != "0") && (Argument != "1"))
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+        }
+        else if(isLoRaWAN == p_Emulator->isLoRaWAN)
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+        }
+        else
+        {
+            // The module restarts with the new work mode.
+            RAK3172_Emulator_Reset(p_Emulator, false);
+            RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+            p_Emulator->isLoRaWAN = isLoRaWAN;
+            RAK3172_Emulator_Splash(p_Emulator, Now);
+        }
+    }
+    else if(Key == "AT+BAUD")
+    {
+        // The new baudrate is used after the status.
+        p_Emulator->Values[Key] = Argument;
+        RAK3172_Emulator_Status(p_Emulator, Now, "OK", RAK_EMULATOR_ACTION_BAUDRATE, strtoul(Argument.c_str(), NULL, 10));
+    }
+    else if(Key == "AT+JOIN")
+    {
+        RAK3172_Emulator_Join(p_Emulator, Now, Argument);
+    }
+    else if(Key == "AT+SEND")
+    {
+        //  AT+SEND=<Port>:<Payload>
+        Index = Argument.find(':');
+        if(Index == std::string::npos)
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+        }
+        else
+        {
+            RAK3172_Emulator_Uplink(p_Emulator, Now, strtol(Argument.c_str(), NULL, 10), p_Emulator->Values["AT+CFM"] == "1", Argument.substr(Index + 1));
+        }
+    }
+    else if(Key == "AT+LPSEND")
+    {
+        size_t Second;
+
+        //  AT+LPSEND=<Port>:<Ack>:<Payload>
+        Index = Argument.find(':');
+        Second = (Index == std::string::npos) ? std::string::npos : Argument.find(':', Index + 1);
+        if(Second == std::string::npos)
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+        }
+        else
+        {
+            RAK3172_Emulator_Uplink(p_Emulator, Now, strtol(Argument.c_str(), NULL, 10), Argument[Index + 1] == '1', Argument.substr(Second + 1));
+        }
+    }
+    else if(Key == "AT+PSEND")
+    {
+        if(p_Emulator->isLoRaWAN)
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "AT_MODE_NO_SUPPORT");
+        }
+        else if(Argument.empty() || (RAK3172_Emulator_isHex(Argument) == false))
+        {
+            RAK3172_Emulator_Status(p_Emulator, Now, "AT_PARAM_ERROR");
+        }
+        else
+        {
+            p_Emulator->Stats.P2PTransmits++;
+            RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+            RAK3172_Emulator_Schedule(p_Emulator, Now + std::chrono::milliseconds(p_Emulator->Config.TxTime), "+EVT:TXP2P DONE\r\n");
+        }
+    }
+    else if(Key == "AT+PRECV")
+    {
+        RAK3172_Emulator_P2PReceive(p_Emulator, Now, strtol(Argument.c_str(), NULL, 10));
+    }
+    else
+    {
+        // All other settings are accepted without a check.
+        p_Emulator->Values[Key] = Argument;
+        RAK3172_Emulator_Status(p_Emulator, Now, "OK");
+    }
+}
+
+/** @brief              Handle the P2P receive mode.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ */
+static void RAK3172_Emulator_UpdateP2P(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now)
+{
+    if(p_Emulator->isP2PReceiving == false)
+    {
+        return;
+    }
+
+    if(p_Emulator->Packets.empty() == false)
+    {
+        RAK3172_EmulatorFrame_t& Frame = p_Emulator->Packets.front();
+
+        // Both dialects use the RUI3 format, because the driver handles only this format.
+        //  +EVT:RXP2P:-50:10:4865
+        RAK3172_Emulator_Schedule(p_Emulator, Now, "+EVT:RXP2P:" + std::to_string(Frame.RSSI) + ":" + std::to_string(Frame.SNR) + ":" + Frame.Payload + "\r\n",
+                                  RAK_EMULATOR_ACTION_RX);
+        p_Emulator->Packets.pop_front();
+
+        p_Emulator->isP2PReceiving = p_Emulator->isP2PContinuous;
+    }
+    else if(Now >= p_Emulator->P2PDeadline)
+    {
+        RAK3172_Emulator_Schedule(p_Emulator, Now, "+EVT:RXP2P_RECEIVE_TIMEOUT\r\n");
+        p_Emulator->isP2PReceiving = false;
+    }
+}
+
+/** @brief              Transmit an output to the driver and execute the action of the output.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Output     Pointer to output object
+ */
+static void RAK3172_Emulator_Transmit(RAK3172_Emulator_t* p_Emulator, const RAK3172_EmulatorOutput_t* p_Output)
+{
+    size_t Written;
+
+    // The time of a receive event is taken before the transmission, because the driver can process the event before
+    // the write returns.
+    if(p_Output->Action == RAK_EMULATOR_ACTION_RX)
+    {
+        p_Emulator->Stats.LastDownlink = esp_timer_get_time();
+    }
+
+    Written = 0;
+    while(Written < p_Output->Data.size())
+    {
+        ssize_t Length;
+
+        Length = write(p_Emulator->Fd, p_Output->Data.data() + Written, p_Output->Data.size() - Written);
+        if(Length <= 0)
+        {
+            break;
+        }
+
+        Written += Length;
+    }
+
+    p_Emulator->Stats.BytesSent += Written;
+
+    switch(p_Output->Action)
+    {
+        case RAK_EMULATOR_ACTION_JOINED:
+        {
+            p_Emulator->isJoined = true;
+
+            break;
+        }
+        case RAK_EMULATOR_ACTION_JOIN_FAILED:
+        {
+            p_Emulator->isJoined = false;
+
+            break;
+        }
+        case RAK_EMULATOR_ACTION_TX_END:
+        {
+            p_Emulator->isTxBusy = false;
+
+            break;
+        }
+        case RAK_EMULATOR_ACTION_RX:
+        {
+            if(p_Emulator->isLoRaWAN)
+            {
+                p_Emulator->Stats.Downlinks++;
+            }
+            else
+            {
+                p_Emulator->Stats.P2PReceived++;
+            }
+
+            break;
+        }
+        case RAK_EMULATOR_ACTION_BAUDRATE:
+        {
+            if(p_Output->Argument != 0)
+            {
+                p_Emulator->Config.Baudrate = p_Output->Argument;
+            }
+
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/** @brief              Split the received data into commands. Each command is processed when it was received completely
+ *                      on the emulated wire and the module has finished the previous command.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Now          Current time
+ *  @param p_Data       Pointer to received data
+ *  @param Length       Length of the received data
+ */
+static void RAK3172_Emulator_Receive(RAK3172_Emulator_t* p_Emulator, RAK3172_Emulator_Time_t Now, const char* p_Data, size_t Length)
+{
+    p_Emulator->Stats.BytesReceived += Length;
+
+    for(size_t i = 0; i < Length; i++)
+    {
+        if(p_Data[i] == '\n')
+        {
+            RAK3172_Emulator_Time_t Process;
+
+            if((p_Emulator->Line.empty() == false) && (p_Emulator->Line.back() == '\r'))
+            {
+                p_Emulator->Line.pop_back();
+            }
+
+            p_Emulator->InputFree = std::max(Now, p_Emulator->InputFree) + RAK3172_Emulator_WireTime(p_Emulator, p_Emulator->Line.size() + 2);
+            Process = std::max(p_Emulator->InputFree, p_Emulator->Processed) + std::chrono::microseconds(p_Emulator->Config.CommandTime);
+            p_Emulator->Processed = Process;
+
+            if(p_Emulator->Line.empty() == false)
+            {
+                p_Emulator->Input.emplace_back(Process, std::move(p_Emulator->Line));
+            }
+
+            p_Emulator->Line.clear();
+        }
+        else
+        {
+            p_Emulator->Line += p_Data[i];
+        }
+    }
+}
+
+/** @brief              Emulator task.
+ *  @param p_Emulator   Pointer to emulator object
+ */
+static void RAK3172_Emulator_Task(RAK3172_Emulator_t* p_Emulator)
+{
+    std::unique_lock<std::mutex> Lock(p_Emulator->Mutex);
+
+    while(p_Emulator->isRunning)
+    {
+        char Buffer[512];
+        RAK3172_Emulator_Time_t Now;
+        RAK3172_Emulator_Time_t Next;
+        struct timespec Timeout;
+        struct pollfd Poll[2];
+
+        Now = RAK3172_Emulator_Clock_t::now();
+
+        while((p_Emulator->Input.empty() == false) && (p_Emulator->Input.front().first <= Now))
+        {
+            RAK3172_Emulator_Process(p_Emulator, p_Emulator->Input.front().first, p_Emulator->Input.front().second);
+            p_Emulator->Input.pop_front();
+        }
+
+        RAK3172_Emulator_UpdateP2P(p_Emulator, Now);
+
+        // Put the outputs on the wire. Outputs on the wire are transmitted one after another.
+        while((p_Emulator->Scheduled.empty() == false) && (p_Emulator->Scheduled.begin()->first <= Now))
+        {
+            auto Output = p_Emulator->Scheduled.begin();
+
+            p_Emulator->WireFree = std::max(Output->first, p_Emulator->WireFree) + RAK3172_Emulator_WireTime(p_Emulator, Output->second.Data.size());
+            p_Emulator->Outgoing.emplace_back(p_Emulator->WireFree, std::move(Output->second));
+            p_Emulator->Scheduled.erase(Output);
+        }
+
+        while((p_Emulator->Outgoing.empty() == false) && (p_Emulator->Outgoing.front().first <= Now))
+        {
+            RAK3172_Emulator_Transmit(p_Emulator, &p_Emulator->Outgoing.front().second);
+            p_Emulator->Outgoing.pop_front();
+        }
+
+        // Sleep until the next action is due.
+        Next = Now + std::chrono::milliseconds(100);
+        if(p_Emulator->Input.empty() == false)
+        {
+            Next = std::min(Next, p_Emulator->Input.front().first);
+        }
+
+        if(p_Emulator->Scheduled.empty() == false)
+        {
+            Next = std::min(Next, p_Emulator->Scheduled.begin()->first);
+        }
+
+        if(p_Emulator->Outgoing.empty() == false)
+        {
+            Next = std::min(Next, p_Emulator->Outgoing.front().first);
+        }
+
+        if(p_Emulator->isP2PReceiving)
+        {
+            Next = std::min(Next, p_Emulator->P2PDeadline);
+        }
+
+        auto Delay = std::chrono::duration_cast<std::chrono::nanoseconds>(std::max(Next - Now, RAK3172_Emulator_Clock_t::duration::zero()));
+        Timeout.tv_sec = Delay.count() / 1000000000LL;
+        Timeout.tv_nsec = Delay.count() % 1000000000LL;
+
+        Poll[0] = {.fd = p_Emulator->Fd, .events = POLLIN, .revents = 0};
+        Poll[1] = {.fd = p_Emulator->Wake[0], .events = POLLIN, .revents = 0};
+
+        Lock.unlock();
+        if(ppoll(Poll, 2, &Timeout, NULL) <= 0)
+        {
+            Lock.lock();
+
+            continue;
+        }
+        Lock.lock();
+
+        if(Poll[0].revents & POLLIN)
+        {
+            ssize_t Length;
+
+            Length = read(p_Emulator->Fd, Buffer, sizeof(Buffer));
+            if(Length > 0)
+            {
+                RAK3172_Emulator_Receive(p_Emulator, RAK3172_Emulator_Clock_t::now(), Buffer, Length);
+            }
+        }
+
+        if(Poll[1].revents & POLLIN)
+        {
+            if(read(p_Emulator->Wake[0], Buffer, sizeof(Buffer)) < 0)
+            {
+                // Nothing to do. The pipe is only used to wake up the task.
+            }
+        }
+    }
+}
+
+RAK3172_Emulator_t* RAK3172_Emulator_Start(const RAK3172_EmulatorConfig_t* p_Config)
+{
+    RAK3172_Emulator_t* Emulator;
+
+    if(p_Config == NULL)
+    {
+        return NULL;
+    }
+
+    Emulator = new RAK3172_Emulator_t();
+    Emulator->Config = *p_Config;
+    Emulator->Fd = RAK3172_Shim_UART_GetPeer(p_Config->Port);
+    if((Emulator->Fd < 0) || (pipe2(Emulator->Wake, O_NONBLOCK) != 0))
+    {
+        delete Emulator;
+
+        return NULL;
+    }
+
+    Emulator->isLoRaWAN = p_Config->isLoRaWAN;
+    Emulator->JoinFailures = p_Config->JoinFailures;
+    Emulator->P2PDeadline = RAK3172_Emulator_Time_t::max();
+    RAK3172_Emulator_Reset(Emulator, true);
+
+    Emulator->isRunning = true;
+    Emulator->Task = std::thread(RAK3172_Emulator_Task, Emulator);
+
+    return Emulator;
+}
+
+void RAK3172_Emulator_Stop(RAK3172_Emulator_t* p_Emulator)
+{
+    if(p_Emulator == NULL)
+    {
+        return;
+    }
+
+    p_Emulator->isRunning = false;
+    RAK3172_Emulator_Wake(p_Emulator);
+    p_Emulator->Task.join();
+
+    close(p_Emulator->Wake[0]);
+    close(p_Emulator->Wake[1]);
+
+    delete p_Emulator;
+}
+
+void RAK3172_Emulator_SetValue(RAK3172_Emulator_t* p_Emulator, const char* p_Command, const char* p_Value)
+{
+    std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+
+    p_Emulator->Values[p_Command] = p_Value;
+}
+
+void RAK3172_Emulator_QueueDownlink(RAK3172_Emulator_t* p_Emulator, uint8_t Port, const uint8_t* p_Payload, size_t Length, int8_t RSSI, int8_t SNR, bool isMulticast)
+{
+    std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+
+    p_Emulator->Downlinks.push_back({RAK3172_Emulator_ToHex(p_Payload, Length), Port, RSSI, SNR, isMulticast});
+}
+
+void RAK3172_Emulator_QueueP2P(RAK3172_Emulator_t* p_Emulator, const uint8_t* p_Payload, size_t Length, int8_t RSSI, int8_t SNR)
+{
+    {
+        std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+
+        p_Emulator->Packets.push_back({RAK3172_Emulator_ToHex(p_Payload, Length), 0, RSSI, SNR, false});
+    }
+
+    RAK3172_Emulator_Wake(p_Emulator);
+}
+
+void RAK3172_Emulator_Inject(RAK3172_Emulator_t* p_Emulator, const char* p_Line)
+{
+    {
+        std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+
+        RAK3172_Emulator_Schedule(p_Emulator, RAK3172_Emulator_Clock_t::now(), std::string(p_Line) + "\r\n");
+    }
+
+    RAK3172_Emulator_Wake(p_Emulator);
+}
+
+bool RAK3172_Emulator_RunScript(RAK3172_Emulator_t* p_Emulator, const char* p_Script)
+{
+    bool Result;
+    std::string Line;
+    std::istringstream Script(p_Script);
+
+    Result = true;
+    while(std::getline(Script, Line))
+    {
+        std::string Statement;
+        std::istringstream Stream(Line);
+
+        if((Stream >> Statement).fail())
+        {
+            continue;
+        }
+        else if(Statement[0] == '#')
+        {
+            continue;
+        }
+        else if(Statement == "set")
+        {
+            std::string Command;
+            std::string Value;
+
+            if((Stream >> Command >> Value).fail())
+            {
+                Result = false;
+
+                continue;
+            }
+
+            RAK3172_Emulator_SetValue(p_Emulator, Command.c_str(), Value.c_str());
+        }
+        else if(Statement == "join_failures")
+        {
+            unsigned int Count;
+
+            if((Stream >> Count).fail())
+            {
+                Result = false;
+
+                continue;
+            }
+
+            std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+            p_Emulator->JoinFailures = static_cast<uint8_t>(Count);
+        }
+        else if((Statement == "downlink") || (Statement == "p2p"))
+        {
+            unsigned int Port;
+            int RSSI;
+            int SNR;
+            std::string Hex;
+            std::string Flag;
+            std::vector<uint8_t> Payload;
+
+            Port = 0;
+            if(((Statement == "downlink") && (Stream >> Port).fail()) || (Stream >> Hex).fail() || (RAK3172_Emulator_isHex(Hex) == false))
+            {
+                Result = false;
+
+                continue;
+            }
+
+            RSSI = (Statement == "p2p") ? -50 : -89;
+            SNR = (Statement == "p2p") ? 10 : 4;
+            Stream >> RSSI >> SNR >> Flag;
+
+            for(size_t i = 0; i < Hex.size(); i += 2)
+            {
+                Payload.push_back(static_cast<uint8_t>(strtoul(Hex.substr(i, 2).c_str(), NULL, 16)));
+            }
+
+            if(Statement == "downlink")
+            {
+                RAK3172_Emulator_QueueDownlink(p_Emulator, static_cast<uint8_t>(Port), Payload.data(), Payload.size(), RSSI, SNR, Flag == "m");
+            }
+            else
+            {
+                RAK3172_Emulator_QueueP2P(p_Emulator, Payload.data(), Payload.size(), RSSI, SNR);
+            }
+        }
+        else if(Statement == "line")
+        {
+            std::string Text;
+
+            std::getline(Stream >> std::ws, Text);
+            RAK3172_Emulator_Inject(p_Emulator, Text.c_str());
+        }
+        else
+        {
+            Result = false;
+        }
+    }
+
+    return Result;
+}
+
+void RAK3172_Emulator_GetStats(RAK3172_Emulator_t* p_Emulator, RAK3172_EmulatorStats_t* p_Stats)
+{
+    std::lock_guard<std::mutex> Lock(p_Emulator->Mutex);
+
+    *p_Stats = p_Emulator->Stats;
+}
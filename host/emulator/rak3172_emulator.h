@@ -0,0 +1,149 @@
+ /*
+ * rak3172_emulator.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: AT firmware emulator of the RAK3172 for the host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_EMULATOR_H_
+#define RAK3172_EMULATOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "driver/uart.h"
+
+/** @brief AT dialects of the emulator.
+ */
+typedef enum
+{
+    RAK_EMULATOR_RUI3 = 0,              /**< RUI3 firmware. Values are returned with the command as prefix. */
+    RAK_EMULATOR_LEGACY,                /**< Firmware 1.x. The status follows an empty line and receive events use two lines. */
+} RAK3172_EmulatorDialect_t;
+
+/** @brief Emulator configuration object.
+ */
+typedef struct
+{
+    RAK3172_EmulatorDialect_t Dialect;  /**< AT dialect. */
+    uart_port_t Port;                   /**< Shim UART which is connected to the emulator. */
+    uint32_t Baudrate;                  /**< Baudrate for the wire latency. Changed with AT+BAUD. Set to 0 to disable the wire latency. */
+    uint32_t CommandTime;               /**< Processing time of a command in microseconds. */
+    uint32_t JoinTime;                  /**< Duration of a join attempt in milliseconds. */
+    uint8_t JoinFailures;               /**< Number of failed join attempts before the network is joined. */
+    uint32_t TxTime;                    /**< Duration of a LoRaWAN or P2P transmission in milliseconds. */
+    bool isLoRaWAN;                     /**< #true when the emulator starts in LoRaWAN mode, otherwise in P2P mode. */
+} RAK3172_EmulatorConfig_t;
+
+/** @brief Emulator statistics object.
+ */
+typedef struct
+{
+    uint32_t Commands;                  /**< Number of processed commands. */
+    uint32_t Errors;                    /**< Number of commands answered with an error status. */
+    uint32_t Joins;                     /**< Number of join attempts. */
+    uint32_t Uplinks;                   /**< Number of LoRaWAN uplinks. */
+    uint32_t Downlinks;                 /**< Number of transmitted LoRaWAN receive events. */
+    uint32_t P2PTransmits;              /**< Number of P2P transmissions. */
+    uint32_t P2PReceived;               /**< Number of transmitted P2P receive events. */
+    uint64_t BytesReceived;             /**< Number of bytes received from the driver. */
+    uint64_t BytesSent;                 /**< Number of bytes transmitted to the driver. */
+    int64_t LastDownlink;               /**< Time of the last LoRaWAN or P2P receive event in microseconds (esp_timer_get_time). */
+} RAK3172_EmulatorStats_t;
+
+/** @brief Emulator object.
+ */
+typedef struct RAK3172_Emulator_s RAK3172_Emulator_t;
+
+/** @brief              Default emulator configuration.
+ *  @param UART_Port    Shim UART
+ */
+#define RAK3172_EMULATOR_DEFAULT_CONFIG(UART_Port)      {                                       \
+                                                            .Dialect = RAK_EMULATOR_RUI3,       \
+                                                            .Port = UART_Port,                  \
+                                                            .Baudrate = 115200,                 \
+                                                            .CommandTime = 0,                   \
+                                                            .JoinTime = 10,                     \
+                                                            .JoinFailures = 0,                  \
+                                                            .TxTime = 10,                       \
+                                                            .isLoRaWAN = true,                  \
+                                                        }
+
+/** @brief          Start an emulator on the module side of a shim UART.
+ *  @param p_Config Pointer to emulator configuration
+ *  @return         Emulator object or NULL when the emulator can not be started
+ */
+RAK3172_Emulator_t* RAK3172_Emulator_Start(const RAK3172_EmulatorConfig_t* p_Config);
+
+/** @brief              Stop an emulator and release the emulator object.
+ *  @param p_Emulator   Pointer to emulator object
+ */
+void RAK3172_Emulator_Stop(RAK3172_Emulator_t* p_Emulator);
+
+/** @brief              Set the value of a setting, i. e. for a query.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Command    Command without '=', i. e. "AT+DEVEUI"
+ *  @param p_Value      Value
+ */
+void RAK3172_Emulator_SetValue(RAK3172_Emulator_t* p_Emulator, const char* p_Command, const char* p_Value);
+
+/** @brief              Queue a LoRaWAN downlink. The downlink is transmitted after the next uplink.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param Port         LoRaWAN port
+ *  @param p_Payload    Pointer to payload
+ *  @param Length       Payload length
+ *  @param RSSI         RSSI value
+ *  @param SNR          SNR value
+ *  @param isMulticast  #true for a multicast downlink
+ */
+void RAK3172_Emulator_QueueDownlink(RAK3172_Emulator_t* p_Emulator, uint8_t Port, const uint8_t* p_Payload, size_t Length, int8_t RSSI = -89, int8_t SNR = 4,
+                                    bool isMulticast = false);
+
+/** @brief              Queue a LoRa P2P packet. The packet is transmitted when the emulator is in receive mode.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Payload    Pointer to payload
+ *  @param Length       Payload length
+ *  @param RSSI         RSSI value
+ *  @param SNR          SNR value
+ */
+void RAK3172_Emulator_QueueP2P(RAK3172_Emulator_t* p_Emulator, const uint8_t* p_Payload, size_t Length, int8_t RSSI = -50, int8_t SNR = 10);
+
+/** @brief              Transmit a line to the driver, i. e. an unsolicited event.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Line       Line without line ending
+ */
+void RAK3172_Emulator_Inject(RAK3172_Emulator_t* p_Emulator, const char* p_Line);
+
+/** @brief              Run an emulator script. Each line of the script contains one statement:
+ *                          set <Command> <Value>                       Set the value of a setting
+ *                          join_failures <Count>                       Set the number of failed join attempts
+ *                          downlink <Port> <Hex> [RSSI] [SNR] [m]      Queue a LoRaWAN downlink ('m' for multicast)
+ *                          p2p <Hex> [RSSI] [SNR]                      Queue a LoRa P2P packet
+ *                          line <Text>                                 Transmit a line to the driver
+ *                      Empty lines and lines starting with '#' are ignored.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Script     Script text
+ *  @return             #true when all statements are valid
+ */
+bool RAK3172_Emulator_RunScript(RAK3172_Emulator_t* p_Emulator, const char* p_Script);
+
+/** @brief              Get the emulator statistics.
+ *  @param p_Emulator   Pointer to emulator object
+ *  @param p_Stats      Pointer to statistics object
+ */
+void RAK3172_Emulator_GetStats(RAK3172_Emulator_t* p_Emulator, RAK3172_EmulatorStats_t* p_Stats);
+
+#endif /* RAK3172_EMULATOR_H_ */
@@ -0,0 +1,84 @@
+ /*
+ * sdkconfig.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Driver configuration for the RUI3 host build of the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef SDKCONFIG_H_
+#define SDKCONFIG_H_
+
+/* Firmware and modes */
+#define CONFIG_RAK3172_USE_RUI3                                     1
+#define CONFIG_RAK3172_FACTORY_RESET                                1
+#define CONFIG_RAK3172_PWRMGMT_ENABLE                               1
+#define CONFIG_RAK3172_MODE_WITH_LORAWAN                            1
+#define CONFIG_RAK3172_MODE_WITH_LORAWAN_CLASS_B                    1
+#define CONFIG_RAK3172_MODE_WITH_LORAWAN_MULTICAST                  1
+#define CONFIG_RAK3172_MODE_WITH_LORAWAN_FUOTA                      1
+#define CONFIG_RAK3172_MODE_LORAWAN_FUOTA_PACKAGE_VERSION           1
+#define CONFIG_RAK3172_MODE_LORAWAN_FUOTA_PORT                      201
+#define CONFIG_RAK3172_MODE_LORAWAN_FUOTA_FRAG_MAX_NB               21
+#define CONFIG_RAK3172_MODE_LORAWAN_FUOTA_FRAG_MAX_SIZE             50
+#define CONFIG_RAK3172_MODE_LORAWAN_FUOTA_FRAG_MAX_REDUNDANCY       5
+#define CONFIG_RAK3172_MODE_WITH_LORAWAN_CLOCK_SYNC                 1
+#define CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PACKAGE_VERSION      1
+#define CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PORT                 202
+#define CONFIG_RAK3172_MODE_WITH_P2P                                1
+
+/* UART */
+#define CONFIG_RAK3172_UART_RX_STREAM                               1
+#define CONFIG_RAK3172_UART_BUFFER_SIZE                             512
+#define CONFIG_RAK3172_UART_QUEUE_LENGTH                            8
+#define CONFIG_RAK3172_QUEUE_OVERFLOW_DROP_NEWEST                   1
+#define CONFIG_RAK3172_QUEUE_BLOCK_TIMEOUT                          10
+#define CONFIG_RAK3172_UART_LINE_SIZE                               544
+#define CONFIG_RAK3172_UART_LINE_POOL_SIZE                          12
+#define CONFIG_RAK3172_UART_RX_PAYLOAD_SIZE                         256
+#define CONFIG_RAK3172_UART_CAPTURE                                 1
+#define CONFIG_RAK3172_UART_CAPTURE_SIZE                            4096
+
+/* Commands */
+#define CONFIG_RAK3172_COMMAND_PIPELINE_DEPTH                       4
+#define CONFIG_RAK3172_COMMAND_ASYNC                                1
+#define CONFIG_RAK3172_COMMAND_ASYNC_QUEUE_LENGTH                   4
+#define CONFIG_RAK3172_COMMAND_ASYNC_SIZE                           128
+#define CONFIG_RAK3172_COMMAND_ASYNC_PRIO                           5
+#define CONFIG_RAK3172_COMMAND_ASYNC_STACK_SIZE                     4096
+#define CONFIG_RAK3172_LOCK_TIMEOUT                                 10000
+#define CONFIG_RAK3172_LOCK_URGENT_PRIO                             10
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_QUERY                        200
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_SET                          500
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_SLOW                         3000
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE                     1
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_MIN                          20
+#define CONFIG_RAK3172_COMMAND_TIMEOUT_MAX                          10000
+#define CONFIG_RAK3172_TRACE                                        1
+#define CONFIG_RAK3172_TRACE_SIZE                                   32
+#define CONFIG_RAK3172_TRACE_COMMANDS                               16
+
+/* Task */
+#define CONFIG_RAK3172_TASK_MAX_DEVICES                             2
+#define CONFIG_RAK3172_TASK_PRIO                                    12
+#define CONFIG_RAK3172_TASK_BUFFER_SIZE                             1024
+#define CONFIG_RAK3172_TASK_STACK_SIZE                              4096
+#define CONFIG_RAK3172_TASK_CORE                                    1
+#define CONFIG_RAK3172_EVENT_SUBSCRIPTIONS                          4
+
+/* Misc */
+#define CONFIG_RAK3172_MISC_ERROR_BASE                              0xA000
+#define CONFIG_RAK3172_MISC_ENABLE_LOG                              1
+
+#endif /* SDKCONFIG_H_ */
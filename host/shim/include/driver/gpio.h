@@ -0,0 +1,80 @@
+ /*
+ * gpio.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: ESP-IDF shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef DRIVER_GPIO_H_
+#define DRIVER_GPIO_H_
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum
+{
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0 = 0,
+    GPIO_NUM_MAX = 49,
+} gpio_num_t;
+
+typedef enum
+{
+    GPIO_MODE_DISABLE = 0,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+} gpio_mode_t;
+
+typedef enum
+{
+    GPIO_PULLUP_DISABLE = 0,
+    GPIO_PULLUP_ENABLE,
+} gpio_pullup_t;
+
+typedef enum
+{
+    GPIO_PULLDOWN_DISABLE = 0,
+    GPIO_PULLDOWN_ENABLE,
+} gpio_pulldown_t;
+
+typedef enum
+{
+    GPIO_PULLUP_ONLY = 0,
+    GPIO_PULLDOWN_ONLY,
+    GPIO_FLOATING,
+} gpio_pull_mode_t;
+
+typedef enum
+{
+    GPIO_INTR_DISABLE = 0,
+} gpio_int_type_t;
+
+typedef struct
+{
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    gpio_pullup_t pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+esp_err_t gpio_config(const gpio_config_t* p_Config);
+
+esp_err_t gpio_set_level(gpio_num_t Pin, uint32_t Level);
+
+esp_err_t gpio_reset_pin(gpio_num_t Pin);
+
+#endif /* DRIVER_GPIO_H_ */
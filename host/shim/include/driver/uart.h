@@ -0,0 +1,143 @@
+ /*
+ * uart.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: ESP-IDF shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef DRIVER_UART_H_
+#define DRIVER_UART_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+#include "freertos/FreeRTOS.h"
+
+#define UART_NUM_0                              0
+#define UART_NUM_1                              1
+#define UART_NUM_2                              2
+#define UART_NUM_MAX                            3
+#define UART_PIN_NO_CHANGE                      (-1)
+
+typedef int uart_port_t;
+
+typedef enum
+{
+    UART_DATA_5_BITS = 0,
+    UART_DATA_6_BITS,
+    UART_DATA_7_BITS,
+    UART_DATA_8_BITS,
+} uart_word_length_t;
+
+typedef enum
+{
+    UART_PARITY_DISABLE = 0,
+    UART_PARITY_EVEN = 2,
+    UART_PARITY_ODD = 3,
+} uart_parity_t;
+
+typedef enum
+{
+    UART_STOP_BITS_1 = 1,
+    UART_STOP_BITS_1_5,
+    UART_STOP_BITS_2,
+} uart_stop_bits_t;
+
+typedef enum
+{
+    UART_HW_FLOWCTRL_DISABLE = 0,
+    UART_HW_FLOWCTRL_RTS,
+    UART_HW_FLOWCTRL_CTS,
+    UART_HW_FLOWCTRL_CTS_RTS,
+} uart_hw_flowcontrol_t;
+
+typedef enum
+{
+    UART_SCLK_DEFAULT = 0,
+    UART_SCLK_REF_TICK,
+    UART_SCLK_RTC,
+} uart_sclk_t;
+
+typedef struct
+{
+    int baud_rate;
+    uart_word_length_t data_bits;
+    uart_parity_t parity;
+    uart_stop_bits_t stop_bits;
+    uart_hw_flowcontrol_t flow_ctrl;
+    uint8_t rx_flow_ctrl_thresh;
+    uart_sclk_t source_clk;
+    struct
+    {
+        uint32_t allow_pd:1;
+        uint32_t backup_before_sleep:1;
+    } flags;
+} uart_config_t;
+
+typedef enum
+{
+    UART_DATA = 0,
+    UART_BREAK,
+    UART_BUFFER_FULL,
+    UART_FIFO_OVF,
+    UART_FRAME_ERR,
+    UART_PARITY_ERR,
+    UART_DATA_BREAK,
+    UART_PATTERN_DET,
+    UART_EVENT_MAX,
+} uart_event_type_t;
+
+typedef struct
+{
+    uart_event_type_t type;
+    size_t size;
+    bool timeout_flag;
+} uart_event_t;
+
+esp_err_t uart_driver_install(uart_port_t Port, int RxBufferSize, int TxBufferSize, int QueueSize, QueueHandle_t* p_Queue, int Flags);
+
+esp_err_t uart_driver_delete(uart_port_t Port);
+
+bool uart_is_driver_installed(uart_port_t Port);
+
+esp_err_t uart_param_config(uart_port_t Port, const uart_config_t* p_Config);
+
+esp_err_t uart_set_pin(uart_port_t Port, int Tx, int Rx, int RTS, int CTS);
+
+esp_err_t uart_enable_pattern_det_baud_intr(uart_port_t Port, char Pattern, uint8_t Count, int Gap, int PreIdle, int PostIdle);
+
+esp_err_t uart_disable_pattern_det_intr(uart_port_t Port);
+
+esp_err_t uart_pattern_queue_reset(uart_port_t Port, int Length);
+
+int uart_pattern_pop_pos(uart_port_t Port);
+
+esp_err_t uart_get_buffered_data_len(uart_port_t Port, size_t* p_Size);
+
+int uart_read_bytes(uart_port_t Port, void* p_Buffer, uint32_t Length, TickType_t Ticks);
+
+int uart_write_bytes(uart_port_t Port, const void* p_Buffer, size_t Length);
+
+esp_err_t uart_flush(uart_port_t Port);
+
+esp_err_t uart_flush_input(uart_port_t Port);
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t Port, int Threshold);
+
+#endif /* DRIVER_UART_H_ */
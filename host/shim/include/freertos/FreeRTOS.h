@@ -0,0 +1,51 @@
+ /*
+ * FreeRTOS.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef FREERTOS_H_
+#define FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                                 ((BaseType_t)0)
+#define pdTRUE                                  ((BaseType_t)1)
+#define pdPASS                                  pdTRUE
+#define pdFAIL                                  pdFALSE
+
+#define portMAX_DELAY                           ((TickType_t)0xFFFFFFFFUL)
+#define configTICK_RATE_HZ                      1000
+#define portTICK_PERIOD_MS                      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(Ms)                       ((TickType_t)(((TickType_t)(Ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#define configMAX_PRIORITIES                    25
+#define configUSE_QUEUE_SETS                    1
+#define tskNO_AFFINITY                          0x7FFFFFFF
+
+typedef struct QueueDefinition* QueueHandle_t;
+typedef struct QueueDefinition* QueueSetHandle_t;
+typedef struct QueueDefinition* QueueSetMemberHandle_t;
+typedef struct QueueDefinition* SemaphoreHandle_t;
+typedef struct EventGroupDef_t* EventGroupHandle_t;
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef uint32_t EventBits_t;
+
+#endif /* FREERTOS_H_ */
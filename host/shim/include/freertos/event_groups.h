@@ -0,0 +1,37 @@
+ /*
+ * event_groups.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef FREERTOS_EVENT_GROUPS_H_
+#define FREERTOS_EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+EventGroupHandle_t xEventGroupCreate(void);
+
+void vEventGroupDelete(EventGroupHandle_t Group);
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t Group, const EventBits_t Bits);
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t Group, const EventBits_t Bits);
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t Group);
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t Group, const EventBits_t Bits, const BaseType_t ClearOnExit, const BaseType_t WaitForAll, TickType_t Ticks);
+
+#endif /* FREERTOS_EVENT_GROUPS_H_ */
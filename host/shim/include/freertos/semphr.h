@@ -0,0 +1,43 @@
+ /*
+ * semphr.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef FREERTOS_SEMPHR_H_
+#define FREERTOS_SEMPHR_H_
+
+#include "queue.h"
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+
+void vSemaphoreDelete(SemaphoreHandle_t Semaphore);
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Semaphore, TickType_t Ticks);
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Semaphore);
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t Semaphore, TickType_t Ticks);
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t Semaphore);
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t Semaphore);
+
+#endif /* FREERTOS_SEMPHR_H_ */
@@ -0,0 +1,33 @@
+ /*
+ * rak3172_shim.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_SHIM_H_
+#define RAK3172_SHIM_H_
+
+#include "driver/uart.h"
+
+/** @brief          Get the module side of a shim UART. The driver side is used by the UART functions of the shim.
+ *                  NOTE: The socket pair of a UART is created with the first call and is kept when the UART driver is
+ *                  deleted and installed again, i. e. for a new baudrate.
+ *  @param Port     UART port
+ *  @return         File descriptor of the module side or -1 when the socket pair cannot be created
+ */
+int RAK3172_Shim_UART_GetPeer(uart_port_t Port);
+
+#endif /* RAK3172_SHIM_H_ */
@@ -0,0 +1,114 @@
+ /*
+ * rak3172_shim_esp.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: ESP-IDF shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+
+#include "rak3172_shim_private.h"
+
+/** @brief          Get the log level of the host build. The level can be set with the environment variable RAK3172_LOG_LEVEL
+ *                  (0 = none, 1 = error, 2 = warning, 3 = info, 4 = debug, 5 = verbose).
+ *  @return         Log level
+ */
+static esp_log_level_t RAK3172_Shim_GetLogLevel(void)
+{
+    static esp_log_level_t Level = ESP_LOG_NONE;
+    static bool isInitialized = false;
+
+    if(isInitialized == false)
+    {
+        const char* Value = getenv("RAK3172_LOG_LEVEL");
+
+        Level = (Value == NULL) ? ESP_LOG_WARN : static_cast<esp_log_level_t>(atoi(Value));
+        isInitialized = true;
+    }
+
+    return Level;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return RAK3172_Shim_GetMicroseconds();
+}
+
+void esp_log_level_set(const char* p_Tag, esp_log_level_t Level)
+{
+    (void)p_Tag;
+    (void)Level;
+}
+
+void esp_log_write(esp_log_level_t Level, const char* p_Tag, const char* p_Format, ...)
+{
+    va_list Arguments;
+    static const char Levels[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+
+    if((Level == ESP_LOG_NONE) || (Level > RAK3172_Shim_GetLogLevel()))
+    {
+        return;
+    }
+
+    fprintf(stderr, "%c (%lld) %s: ", Levels[Level], static_cast<long long>(RAK3172_Shim_GetMicroseconds() / 1000), p_Tag);
+    va_start(Arguments, p_Format);
+    vfprintf(stderr, p_Format, Arguments);
+    va_end(Arguments);
+    fputc('\n', stderr);
+}
+
+void esp_log_buffer_hex(const char* p_Tag, const void* p_Buffer, size_t Length)
+{
+    if(RAK3172_Shim_GetLogLevel() < ESP_LOG_INFO)
+    {
+        return;
+    }
+
+    fprintf(stderr, "I %s: ", p_Tag);
+    for(size_t i = 0; i < Length; i++)
+    {
+        fprintf(stderr, "%02X ", static_cast<const uint8_t*>(p_Buffer)[i]);
+    }
+    fputc('\n', stderr);
+}
+
+esp_err_t gpio_config(const gpio_config_t* p_Config)
+{
+    (void)p_Config;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t Pin, uint32_t Level)
+{
+    (void)Pin;
+    (void)Level;
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t Pin)
+{
+    (void)Pin;
+
+    return ESP_OK;
+}
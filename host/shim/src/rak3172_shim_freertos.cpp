@@ -0,0 +1,680 @@
+ /*
+ * rak3172_shim_freertos.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <thread>
+#include <vector>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+#include "rak3172_shim_private.h"
+
+/** @brief Queue types.
+ */
+typedef enum
+{
+    RAK3172_SHIM_QUEUE = 0,             /**< Queue, queue set or binary semaphore. */
+    RAK3172_SHIM_MUTEX,                 /**< Mutex. */
+    RAK3172_SHIM_RECURSIVE_MUTEX,       /**< Recursive mutex. */
+} RAK3172_Shim_QueueType_t;
+
+/** @brief Task object. Tasks are executed as detached threads.
+ */
+struct tskTaskControlBlock
+{
+    std::mutex Mutex;                   /**< Lock for the task state. */
+    std::condition_variable Condition;  /**< Signaled when the task state changes. */
+    TaskFunction_t Function;            /**< Task function. */
+    void* Arg;                          /**< Task argument. */
+    UBaseType_t Priority;               /**< Task priority. It is only stored, the host scheduler decides. */
+    bool isSuspended;                   /**< #true when the task should be suspended. */
+    bool isParked;                      /**< #true when the task has stopped because of a suspend request. */
+    bool isDeleted;                     /**< #true when the task should be deleted by another task. */
+    bool isSelfDeleted;                 /**< #true when the task has deleted itself. */
+    bool isFinished;                    /**< #true when the thread of the task has ended. */
+};
+
+/** @brief Queue object. Semaphores and queue sets are queues, too.
+ */
+struct QueueDefinition
+{
+    std::mutex Mutex;                   /**< Lock for the queue. */
+    std::condition_variable Condition;  /**< Signaled when an item is added or removed. */
+    RAK3172_Shim_QueueType_t Type;      /**< Queue type. */
+    std::vector<uint8_t> Items;         /**< Item storage. */
+    UBaseType_t Length;                 /**< Maximum number of items. */
+    UBaseType_t ItemSize;               /**< Size of an item in bytes. */
+    UBaseType_t Count;                  /**< Number of items in the queue. */
+    UBaseType_t Head;                   /**< Index of the first item. */
+    QueueDefinition* Set;               /**< Queue set of the queue or NULL. */
+    TaskHandle_t Holder;                /**< Holder of a mutex. */
+    UBaseType_t Depth;                  /**< Recursion depth of a recursive mutex. */
+};
+
+/** @brief Event group object.
+ */
+struct EventGroupDef_t
+{
+    std::mutex Mutex;                   /**< Lock for the event bits. */
+    std::condition_variable Condition;  /**< Signaled when bits are set. */
+    EventBits_t Bits;                   /**< Event bits. */
+};
+
+/** @brief Exception which unwinds the thread of a deleted task.
+ */
+struct RAK3172_Shim_TaskExit
+{
+};
+
+/** @brief Task object of the calling thread.
+ */
+static thread_local tskTaskControlBlock* _RAK3172_Shim_Current = NULL;
+
+/** @brief          Get the start time of the shim.
+ *  @return         Start time
+ */
+static RAK3172_Shim_Clock_t::time_point RAK3172_Shim_GetStart(void)
+{
+    static const RAK3172_Shim_Clock_t::time_point Start = RAK3172_Shim_Clock_t::now();
+
+    return Start;
+}
+
+/** @brief          Get the task object of the calling thread. Threads which aren´t created by the shim (i. e. the main
+ *                  thread) get a task object with the first call.
+ *  @return         Task object
+ */
+static tskTaskControlBlock* RAK3172_Shim_GetCurrent(void)
+{
+    if(_RAK3172_Shim_Current == NULL)
+    {
+        _RAK3172_Shim_Current = new tskTaskControlBlock();
+    }
+
+    return _RAK3172_Shim_Current;
+}
+
+int64_t RAK3172_Shim_GetMicroseconds(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(RAK3172_Shim_Clock_t::now() - RAK3172_Shim_GetStart()).count();
+}
+
+void RAK3172_Shim_Checkpoint(void)
+{
+    tskTaskControlBlock* Task = RAK3172_Shim_GetCurrent();
+    std::unique_lock<std::mutex> Lock(Task->Mutex);
+
+    while(true)
+    {
+        if(Task->isDeleted)
+        {
+            Lock.unlock();
+
+            throw RAK3172_Shim_TaskExit();
+        }
+
+        if(Task->isSuspended == false)
+        {
+            break;
+        }
+
+        Task->isParked = true;
+        Task->Condition.notify_all();
+        Task->Condition.wait(Lock);
+    }
+
+    Task->isParked = false;
+}
+
+bool RAK3172_Shim_isInterrupted(void)
+{
+    tskTaskControlBlock* Task = RAK3172_Shim_GetCurrent();
+    std::lock_guard<std::mutex> Lock(Task->Mutex);
+
+    return Task->isSuspended || Task->isDeleted;
+}
+
+/** @brief          Create a queue object.
+ *  @param Length   Maximum number of items
+ *  @param ItemSize Size of an item in bytes
+ *  @param Type     Queue type
+ *  @return         Queue object
+ */
+static QueueHandle_t RAK3172_Shim_CreateQueue(UBaseType_t Length, UBaseType_t ItemSize, RAK3172_Shim_QueueType_t Type)
+{
+    QueueDefinition* Queue = new QueueDefinition();
+
+    Queue->Type = Type;
+    Queue->Items.resize(Length * ItemSize);
+    Queue->Length = Length;
+    Queue->ItemSize = ItemSize;
+    Queue->Count = 0;
+    Queue->Head = 0;
+    Queue->Set = NULL;
+    Queue->Holder = NULL;
+    Queue->Depth = 0;
+
+    return Queue;
+}
+
+/** @brief          Add an item to a queue.
+ *  @param Queue    Queue object
+ *  @param p_Item   Pointer to item
+ *  @param Ticks    Timeout in ticks
+ *  @param isFront  #true when the item should be added to the front of the queue
+ *  @return         pdPASS when successful
+ */
+static BaseType_t RAK3172_Shim_Send(QueueHandle_t Queue, const void* p_Item, TickType_t Ticks, bool isFront)
+{
+    QueueDefinition* Set;
+    std::unique_lock<std::mutex> Lock(Queue->Mutex);
+
+    if(RAK3172_Shim_Wait(Lock, Queue->Condition, Ticks, [Queue]() { return Queue->Count < Queue->Length; }) == false)
+    {
+        return pdFAIL;
+    }
+
+    if(isFront)
+    {
+        Queue->Head = (Queue->Head + Queue->Length - 1) % Queue->Length;
+        if(Queue->ItemSize > 0)
+        {
+            memcpy(&Queue->Items[Queue->Head * Queue->ItemSize], p_Item, Queue->ItemSize);
+        }
+    }
+    else if(Queue->ItemSize > 0)
+    {
+        memcpy(&Queue->Items[((Queue->Head + Queue->Count) % Queue->Length) * Queue->ItemSize], p_Item, Queue->ItemSize);
+    }
+    Queue->Count++;
+    Queue->Condition.notify_all();
+
+    Set = Queue->Set;
+    Lock.unlock();
+
+    // Announce the new item to the queue set like FreeRTOS does.
+    if(Set != NULL)
+    {
+        RAK3172_Shim_Send(Set, &Queue, 0, false);
+    }
+
+    return pdPASS;
+}
+
+/** @brief          Get an item from a queue.
+ *  @param Queue    Queue object
+ *  @param p_Item   Pointer to item
+ *  @param Ticks    Timeout in ticks
+ *  @param isPeek   #true when the item should stay in the queue
+ *  @return         pdPASS when successful
+ */
+static BaseType_t RAK3172_Shim_Receive(QueueHandle_t Queue, void* p_Item, TickType_t Ticks, bool isPeek)
+{
+    std::unique_lock<std::mutex> Lock(Queue->Mutex);
+
+    if(RAK3172_Shim_Wait(Lock, Queue->Condition, Ticks, [Queue]() { return Queue->Count > 0; }) == false)
+    {
+        return pdFAIL;
+    }
+
+    if(Queue->ItemSize > 0)
+    {
+        memcpy(p_Item, &Queue->Items[Queue->Head * Queue->ItemSize], Queue->ItemSize);
+    }
+
+    if(isPeek == false)
+    {
+        Queue->Head = (Queue->Head + 1) % Queue->Length;
+        Queue->Count--;
+        Queue->Condition.notify_all();
+    }
+
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t Length, UBaseType_t ItemSize)
+{
+    return RAK3172_Shim_CreateQueue(Length, ItemSize, RAK3172_SHIM_QUEUE);
+}
+
+void vQueueDelete(QueueHandle_t Queue)
+{
+    delete Queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t Queue, const void* p_Item, TickType_t Ticks)
+{
+    return RAK3172_Shim_Send(Queue, p_Item, Ticks, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t Queue, const void* p_Item, TickType_t Ticks)
+{
+    return RAK3172_Shim_Send(Queue, p_Item, Ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t Queue, const void* p_Item, TickType_t Ticks)
+{
+    return RAK3172_Shim_Send(Queue, p_Item, Ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t Queue, void* p_Item, TickType_t Ticks)
+{
+    return RAK3172_Shim_Receive(Queue, p_Item, Ticks, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t Queue, void* p_Item, TickType_t Ticks)
+{
+    return RAK3172_Shim_Receive(Queue, p_Item, Ticks, true);
+}
+
+BaseType_t xQueueReset(QueueHandle_t Queue)
+{
+    std::lock_guard<std::mutex> Lock(Queue->Mutex);
+
+    Queue->Count = 0;
+    Queue->Head = 0;
+    Queue->Condition.notify_all();
+
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t Queue)
+{
+    std::lock_guard<std::mutex> Lock(Queue->Mutex);
+
+    return Queue->Count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t Queue)
+{
+    std::lock_guard<std::mutex> Lock(Queue->Mutex);
+
+    return Queue->Length - Queue->Count;
+}
+
+QueueSetHandle_t xQueueCreateSet(UBaseType_t Length)
+{
+    return RAK3172_Shim_CreateQueue(Length, sizeof(QueueHandle_t), RAK3172_SHIM_QUEUE);
+}
+
+BaseType_t xQueueAddToSet(QueueSetMemberHandle_t Member, QueueSetHandle_t Set)
+{
+    std::lock_guard<std::mutex> Lock(Member->Mutex);
+
+    if((Member->Set != NULL) || (Member->Count > 0))
+    {
+        return pdFAIL;
+    }
+
+    Member->Set = Set;
+
+    return pdPASS;
+}
+
+BaseType_t xQueueRemoveFromSet(QueueSetMemberHandle_t Member, QueueSetHandle_t Set)
+{
+    std::lock_guard<std::mutex> Lock(Member->Mutex);
+
+    if((Member->Set != Set) || (Member->Count > 0))
+    {
+        return pdFAIL;
+    }
+
+    Member->Set = NULL;
+
+    return pdPASS;
+}
+
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t Set, TickType_t Ticks)
+{
+    QueueSetMemberHandle_t Member;
+
+    if(RAK3172_Shim_Receive(Set, &Member, Ticks, false) != pdPASS)
+    {
+        return NULL;
+    }
+
+    return Member;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return RAK3172_Shim_CreateQueue(1, 0, RAK3172_SHIM_QUEUE);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    QueueHandle_t Mutex = RAK3172_Shim_CreateQueue(1, 0, RAK3172_SHIM_MUTEX);
+
+    Mutex->Count = 1;
+
+    return Mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    QueueHandle_t Mutex = RAK3172_Shim_CreateQueue(1, 0, RAK3172_SHIM_RECURSIVE_MUTEX);
+
+    Mutex->Count = 1;
+
+    return Mutex;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t Semaphore)
+{
+    delete Semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Semaphore, TickType_t Ticks)
+{
+    TaskHandle_t Task;
+
+    if(Semaphore->Type == RAK3172_SHIM_QUEUE)
+    {
+        return RAK3172_Shim_Receive(Semaphore, NULL, Ticks, false);
+    }
+
+    Task = RAK3172_Shim_GetCurrent();
+    std::unique_lock<std::mutex> Lock(Semaphore->Mutex);
+
+    if((Semaphore->Type == RAK3172_SHIM_RECURSIVE_MUTEX) && (Semaphore->Holder == Task))
+    {
+        Semaphore->Depth++;
+
+        return pdPASS;
+    }
+
+    if(RAK3172_Shim_Wait(Lock, Semaphore->Condition, Ticks, [Semaphore]() { return Semaphore->Count > 0; }) == false)
+    {
+        return pdFAIL;
+    }
+
+    Semaphore->Count = 0;
+    Semaphore->Holder = Task;
+    Semaphore->Depth = 1;
+
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Semaphore)
+{
+    if(Semaphore->Type == RAK3172_SHIM_QUEUE)
+    {
+        return RAK3172_Shim_Send(Semaphore, NULL, 0, false);
+    }
+
+    std::lock_guard<std::mutex> Lock(Semaphore->Mutex);
+
+    if(Semaphore->Holder != RAK3172_Shim_GetCurrent())
+    {
+        return pdFAIL;
+    }
+
+    Semaphore->Depth--;
+    if(Semaphore->Depth == 0)
+    {
+        Semaphore->Holder = NULL;
+        Semaphore->Count = 1;
+        Semaphore->Condition.notify_all();
+    }
+
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t Semaphore, TickType_t Ticks)
+{
+    return xSemaphoreTake(Semaphore, Ticks);
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t Semaphore)
+{
+    return xSemaphoreGive(Semaphore);
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t Semaphore)
+{
+    std::lock_guard<std::mutex> Lock(Semaphore->Mutex);
+
+    return Semaphore->Holder;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t Function, const char* const p_Name, uint32_t StackDepth, void* const p_Arg, UBaseType_t Priority, TaskHandle_t* const p_Handle)
+{
+    tskTaskControlBlock* Task = new tskTaskControlBlock();
+
+    (void)p_Name;
+    (void)StackDepth;
+
+    Task->Function = Function;
+    Task->Arg = p_Arg;
+    Task->Priority = Priority;
+
+    if(p_Handle != NULL)
+    {
+        *p_Handle = Task;
+    }
+
+    std::thread([Task]()
+    {
+        bool isSelfDeleted;
+
+        _RAK3172_Shim_Current = Task;
+
+        try
+        {
+            Task->Function(Task->Arg);
+        }
+        catch(const RAK3172_Shim_TaskExit&)
+        {
+        }
+
+        std::unique_lock<std::mutex> Lock(Task->Mutex);
+        Task->isFinished = true;
+        isSelfDeleted = Task->isSelfDeleted;
+        Task->Condition.notify_all();
+        Lock.unlock();
+
+        // The task object of a task which is deleted by another task is freed by the other task.
+        if(isSelfDeleted)
+        {
+            delete Task;
+        }
+    }).detach();
+
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t Function, const char* const p_Name, uint32_t StackDepth, void* const p_Arg, UBaseType_t Priority, TaskHandle_t* const p_Handle, BaseType_t CoreID)
+{
+    (void)CoreID;
+
+    return xTaskCreate(Function, p_Name, StackDepth, p_Arg, Priority, p_Handle);
+}
+
+void vTaskDelete(TaskHandle_t Handle)
+{
+    if((Handle == NULL) || (Handle == RAK3172_Shim_GetCurrent()))
+    {
+        tskTaskControlBlock* Task = RAK3172_Shim_GetCurrent();
+
+        std::unique_lock<std::mutex> Lock(Task->Mutex);
+        Task->isSelfDeleted = true;
+        Lock.unlock();
+
+        throw RAK3172_Shim_TaskExit();
+    }
+
+    // The task ends with the next blocking call. Wait for it, because the caller usually frees the objects used by the task.
+    std::unique_lock<std::mutex> Lock(Handle->Mutex);
+    Handle->isDeleted = true;
+    Handle->Condition.notify_all();
+    Handle->Condition.wait(Lock, [Handle]() { return Handle->isFinished; });
+    Lock.unlock();
+
+    delete Handle;
+}
+
+void vTaskSuspend(TaskHandle_t Handle)
+{
+    if((Handle == NULL) || (Handle == RAK3172_Shim_GetCurrent()))
+    {
+        tskTaskControlBlock* Task = RAK3172_Shim_GetCurrent();
+
+        std::unique_lock<std::mutex> Lock(Task->Mutex);
+        Task->isSuspended = true;
+        Lock.unlock();
+
+        RAK3172_Shim_Checkpoint();
+
+        return;
+    }
+
+    // The task stops with the next blocking call.
+    std::unique_lock<std::mutex> Lock(Handle->Mutex);
+    Handle->isSuspended = true;
+    Handle->Condition.wait(Lock, [Handle]() { return Handle->isParked || Handle->isFinished; });
+}
+
+void vTaskResume(TaskHandle_t Handle)
+{
+    std::lock_guard<std::mutex> Lock(Handle->Mutex);
+
+    Handle->isSuspended = false;
+    Handle->Condition.notify_all();
+}
+
+void vTaskDelay(const TickType_t Ticks)
+{
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::unique_lock<std::mutex> Lock(Mutex);
+
+    RAK3172_Shim_Checkpoint();
+
+    if(Ticks == 0)
+    {
+        std::this_thread::yield();
+
+        return;
+    }
+
+    RAK3172_Shim_Wait(Lock, Condition, Ticks, []() { return false; });
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return static_cast<TickType_t>(RAK3172_Shim_GetMicroseconds() / (1000 * portTICK_PERIOD_MS));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return RAK3172_Shim_GetCurrent();
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t Handle)
+{
+    if(Handle == NULL)
+    {
+        Handle = RAK3172_Shim_GetCurrent();
+    }
+
+    std::lock_guard<std::mutex> Lock(Handle->Mutex);
+
+    return Handle->Priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t Handle, UBaseType_t Priority)
+{
+    if(Handle == NULL)
+    {
+        Handle = RAK3172_Shim_GetCurrent();
+    }
+
+    std::lock_guard<std::mutex> Lock(Handle->Mutex);
+
+    Handle->Priority = Priority;
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    EventGroupDef_t* Group = new EventGroupDef_t();
+
+    Group->Bits = 0;
+
+    return Group;
+}
+
+void vEventGroupDelete(EventGroupHandle_t Group)
+{
+    delete Group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t Group, const EventBits_t Bits)
+{
+    std::lock_guard<std::mutex> Lock(Group->Mutex);
+
+    Group->Bits |= Bits;
+    Group->Condition.notify_all();
+
+    return Group->Bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t Group, const EventBits_t Bits)
+{
+    EventBits_t Previous;
+    std::lock_guard<std::mutex> Lock(Group->Mutex);
+
+    Previous = Group->Bits;
+    Group->Bits &= ~Bits;
+
+    return Previous;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t Group)
+{
+    std::lock_guard<std::mutex> Lock(Group->Mutex);
+
+    return Group->Bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t Group, const EventBits_t Bits, const BaseType_t ClearOnExit, const BaseType_t WaitForAll, TickType_t Ticks)
+{
+    EventBits_t Result;
+    std::unique_lock<std::mutex> Lock(Group->Mutex);
+
+    if(RAK3172_Shim_Wait(Lock, Group->Condition, Ticks, [Group, Bits, WaitForAll]()
+    {
+        return WaitForAll ? ((Group->Bits & Bits) == Bits) : ((Group->Bits & Bits) != 0);
+    }) == false)
+    {
+        return Group->Bits;
+    }
+
+    Result = Group->Bits;
+    if(ClearOnExit)
+    {
+        Group->Bits &= ~Bits;
+    }
+
+    return Result;
+}
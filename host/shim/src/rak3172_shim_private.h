@@ -0,0 +1,94 @@
+ /*
+ * rak3172_shim_private.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Private helpers of the FreeRTOS shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_SHIM_PRIVATE_H_
+#define RAK3172_SHIM_PRIVATE_H_
+
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+#include "freertos/FreeRTOS.h"
+
+/** @brief Clock of the shim. All ticks and timestamps are derived from it.
+ */
+typedef std::chrono::steady_clock RAK3172_Shim_Clock_t;
+
+/** @brief          Get the time since the start of the shim.
+ *  @return         Time in microseconds
+ */
+int64_t RAK3172_Shim_GetMicroseconds(void);
+
+/** @brief          Handle pending suspend and delete requests of the calling task.
+ *                  NOTE: A deleted task is unwound with an exception and never returns from this function.
+ */
+void RAK3172_Shim_Checkpoint(void);
+
+/** @brief          Check if a suspend or delete request for the calling task is pending.
+ *  @return         #true when a request is pending
+ */
+bool RAK3172_Shim_isInterrupted(void);
+
+/** @brief          Wait until a condition is true or the timeout has expired. Suspend and delete requests of the calling
+ *                  task are handled while waiting, so a task can be stopped while it is blocked.
+ *  @param Lock     Lock of the object which is protected by the condition variable
+ *  @param Condition Condition variable of the object
+ *  @param Ticks    Timeout in ticks
+ *  @param isReady  Predicate which is evaluated with the lock
+ *  @return         #true when the predicate is true
+ */
+template<typename Predicate>
+static inline bool RAK3172_Shim_Wait(std::unique_lock<std::mutex>& Lock, std::condition_variable& Condition, TickType_t Ticks, Predicate isReady)
+{
+    RAK3172_Shim_Clock_t::time_point Deadline;
+
+    if(Ticks == portMAX_DELAY)
+    {
+        Deadline = RAK3172_Shim_Clock_t::time_point::max();
+    }
+    else
+    {
+        Deadline = RAK3172_Shim_Clock_t::now() + std::chrono::milliseconds(Ticks * portTICK_PERIOD_MS);
+    }
+
+    while(isReady() == false)
+    {
+        RAK3172_Shim_Clock_t::time_point Now;
+
+        Now = RAK3172_Shim_Clock_t::now();
+        if((Ticks == 0) || (Now >= Deadline))
+        {
+            return false;
+        }
+
+        // Wake up periodically to handle suspend and delete requests from other tasks.
+        Condition.wait_until(Lock, std::min(Deadline, Now + std::chrono::milliseconds(5)));
+
+        if(RAK3172_Shim_isInterrupted())
+        {
+            Lock.unlock();
+            RAK3172_Shim_Checkpoint();
+            Lock.lock();
+        }
+    }
+
+    return true;
+}
+
+#endif /* RAK3172_SHIM_PRIVATE_H_ */
@@ -0,0 +1,448 @@
+ /*
+ * rak3172_shim_uart.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: ESP-IDF UART shim for the RAK3172 host build.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "driver/uart.h"
+#include "freertos/queue.h"
+
+#include "rak3172_shim.h"
+#include "rak3172_shim_private.h"
+
+/** @brief Maximum number of bytes which are read from the socket at once.
+ */
+#define RAK3172_SHIM_UART_CHUNK_SIZE                            256
+
+/** @brief Shim UART object. The driver side of a socket pair replaces the UART peripheral.
+ */
+typedef struct
+{
+    std::mutex Mutex;                   /**< Lock for the receive buffer and the pattern queue. */
+    std::condition_variable Condition;  /**< Signaled when data is received. */
+    int Fd[2];                          /**< Socket pair. Index 0 is the driver side and index 1 the module side. */
+    bool isOpen;                        /**< #true when the socket pair is created. */
+    bool isInstalled;                   /**< #true when the driver is installed. */
+    std::deque<uint8_t> Buffer;         /**< Receive buffer. */
+    size_t Size;                        /**< Size of the receive buffer in bytes. */
+    QueueHandle_t EventQueue;           /**< UART event queue of the driver. */
+    bool isPatternEnabled;              /**< #true when the pattern detection is enabled. */
+    char Pattern;                       /**< Pattern character. */
+    size_t PatternQueueLength;          /**< Maximum number of stored pattern positions. */
+    std::deque<uint64_t> Patterns;      /**< Absolute positions of the detected patterns. */
+    uint64_t Received;                  /**< Number of bytes added to the receive buffer. */
+    uint64_t Read;                      /**< Number of bytes removed from the receive buffer. */
+    std::atomic<bool> isRunning;        /**< #true while the receive thread is running. */
+    std::thread Receiver;               /**< Receive thread. */
+} RAK3172_Shim_UART_t;
+
+static std::mutex _RAK3172_Shim_UART_Lock;
+static RAK3172_Shim_UART_t _RAK3172_Shim_UART[UART_NUM_MAX];
+
+/** @brief          Get the shim UART object of a port.
+ *  @param Port     UART port
+ *  @return         UART object or NULL when the port is invalid
+ */
+static RAK3172_Shim_UART_t* RAK3172_Shim_UART_Get(uart_port_t Port)
+{
+    if((Port < 0) || (Port >= UART_NUM_MAX))
+    {
+        return NULL;
+    }
+
+    return &_RAK3172_Shim_UART[Port];
+}
+
+/** @brief          Create the socket pair of a port when it doesn´t exist.
+ *  @param p_UART   Pointer to UART object
+ *  @return         #true when successful
+ */
+static bool RAK3172_Shim_UART_Open(RAK3172_Shim_UART_t* p_UART)
+{
+    std::lock_guard<std::mutex> Lock(_RAK3172_Shim_UART_Lock);
+
+    if(p_UART->isOpen == false)
+    {
+        p_UART->isOpen = (socketpair(AF_UNIX, SOCK_STREAM, 0, p_UART->Fd) == 0);
+    }
+
+    return p_UART->isOpen;
+}
+
+/** @brief          Post an event to the event queue of the driver. Events are dropped when the queue is full.
+ *  @param p_UART   Pointer to UART object
+ *  @param Type     Event type
+ *  @param Size     Data size of the event
+ */
+static void RAK3172_Shim_UART_Post(RAK3172_Shim_UART_t* p_UART, uart_event_type_t Type, size_t Size)
+{
+    uart_event_t Event;
+
+    if(p_UART->EventQueue == NULL)
+    {
+        return;
+    }
+
+    Event.type = Type;
+    Event.size = Size;
+    Event.timeout_flag = false;
+    xQueueSendToBack(p_UART->EventQueue, &Event, 0);
+}
+
+/** @brief          Receive thread of a shim UART. The thread moves the data from the socket into the receive buffer and
+ *                  generates the UART events like the ESP-IDF UART driver.
+ *  @param p_UART   Pointer to UART object
+ */
+static void RAK3172_Shim_UART_Receive(RAK3172_Shim_UART_t* p_UART)
+{
+    while(p_UART->isRunning)
+    {
+        ssize_t Length;
+        size_t Accepted;
+        size_t Patterns;
+        struct pollfd Poll;
+        uint8_t Chunk[RAK3172_SHIM_UART_CHUNK_SIZE];
+
+        Poll.fd = p_UART->Fd[0];
+        Poll.events = POLLIN;
+        if((poll(&Poll, 1, 10) <= 0) || ((Poll.revents & POLLIN) == 0))
+        {
+            continue;
+        }
+
+        Length = read(p_UART->Fd[0], Chunk, sizeof(Chunk));
+        if(Length <= 0)
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> Lock(p_UART->Mutex);
+
+        Accepted = 0;
+        Patterns = 0;
+        for(ssize_t i = 0; (i < Length) && (p_UART->Buffer.size() < p_UART->Size); i++)
+        {
+            p_UART->Buffer.push_back(Chunk[i]);
+
+            if(p_UART->isPatternEnabled && (static_cast<char>(Chunk[i]) == p_UART->Pattern))
+            {
+                // The position is lost when the pattern queue is full.
+                if(p_UART->Patterns.size() < p_UART->PatternQueueLength)
+                {
+                    p_UART->Patterns.push_back(p_UART->Received);
+                }
+
+                Patterns++;
+            }
+
+            p_UART->Received++;
+            Accepted++;
+        }
+
+        p_UART->Condition.notify_all();
+        Lock.unlock();
+
+        // Only pattern events are generated in pattern mode to keep the event queue free for them.
+        if(p_UART->isPatternEnabled)
+        {
+            for(size_t i = 0; i < Patterns; i++)
+            {
+                RAK3172_Shim_UART_Post(p_UART, UART_PATTERN_DET, 0);
+            }
+        }
+        else if(Accepted > 0)
+        {
+            RAK3172_Shim_UART_Post(p_UART, UART_DATA, Accepted);
+        }
+
+        if(Accepted < static_cast<size_t>(Length))
+        {
+            RAK3172_Shim_UART_Post(p_UART, UART_BUFFER_FULL, 0);
+        }
+    }
+}
+
+int RAK3172_Shim_UART_GetPeer(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if((UART == NULL) || (RAK3172_Shim_UART_Open(UART) == false))
+    {
+        return -1;
+    }
+
+    return UART->Fd[1];
+}
+
+esp_err_t uart_driver_install(uart_port_t Port, int RxBufferSize, int TxBufferSize, int QueueSize, QueueHandle_t* p_Queue, int Flags)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    (void)TxBufferSize;
+    (void)Flags;
+
+    if((UART == NULL) || UART->isInstalled || (RAK3172_Shim_UART_Open(UART) == false))
+    {
+        return ESP_FAIL;
+    }
+
+    UART->Size = RxBufferSize;
+    UART->Buffer.clear();
+    UART->Patterns.clear();
+    UART->isPatternEnabled = false;
+    UART->PatternQueueLength = 0;
+    UART->EventQueue = NULL;
+
+    if(p_Queue != NULL)
+    {
+        UART->EventQueue = xQueueCreate(QueueSize, sizeof(uart_event_t));
+        *p_Queue = UART->EventQueue;
+    }
+
+    UART->isRunning = true;
+    UART->Receiver = std::thread(RAK3172_Shim_UART_Receive, UART);
+    UART->isInstalled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if((UART == NULL) || (UART->isInstalled == false))
+    {
+        return ESP_FAIL;
+    }
+
+    UART->isRunning = false;
+    UART->Receiver.join();
+
+    if(UART->EventQueue != NULL)
+    {
+        vQueueDelete(UART->EventQueue);
+        UART->EventQueue = NULL;
+    }
+
+    UART->isInstalled = false;
+
+    return ESP_OK;
+}
+
+bool uart_is_driver_installed(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    return (UART != NULL) && UART->isInstalled;
+}
+
+esp_err_t uart_param_config(uart_port_t Port, const uart_config_t* p_Config)
+{
+    (void)p_Config;
+
+    return (RAK3172_Shim_UART_Get(Port) == NULL) ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t Port, int Tx, int Rx, int RTS, int CTS)
+{
+    (void)Tx;
+    (void)Rx;
+    (void)RTS;
+    (void)CTS;
+
+    return (RAK3172_Shim_UART_Get(Port) == NULL) ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t uart_enable_pattern_det_baud_intr(uart_port_t Port, char Pattern, uint8_t Count, int Gap, int PreIdle, int PostIdle)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    (void)Count;
+    (void)Gap;
+    (void)PreIdle;
+    (void)PostIdle;
+
+    if(UART == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+    UART->Pattern = Pattern;
+    UART->isPatternEnabled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t uart_disable_pattern_det_intr(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if(UART == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+    UART->isPatternEnabled = false;
+
+    return ESP_OK;
+}
+
+esp_err_t uart_pattern_queue_reset(uart_port_t Port, int Length)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if(UART == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+    UART->PatternQueueLength = Length;
+    UART->Patterns.clear();
+
+    return ESP_OK;
+}
+
+int uart_pattern_pop_pos(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if(UART == NULL)
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+
+    // The positions are relative to the first byte in the receive buffer. Patterns which were already read are skipped.
+    while(UART->Patterns.empty() == false)
+    {
+        uint64_t Position;
+
+        Position = UART->Patterns.front();
+        UART->Patterns.pop_front();
+
+        if(Position >= UART->Read)
+        {
+            return static_cast<int>(Position - UART->Read);
+        }
+    }
+
+    return -1;
+}
+
+esp_err_t uart_get_buffered_data_len(uart_port_t Port, size_t* p_Size)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if(UART == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+    *p_Size = UART->Buffer.size();
+
+    return ESP_OK;
+}
+
+int uart_read_bytes(uart_port_t Port, void* p_Buffer, uint32_t Length, TickType_t Ticks)
+{
+    size_t Count;
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if((UART == NULL) || (UART->isInstalled == false))
+    {
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> Lock(UART->Mutex);
+
+    RAK3172_Shim_Wait(Lock, UART->Condition, Ticks, [UART, Length]() { return UART->Buffer.size() >= Length; });
+
+    Count = std::min(static_cast<size_t>(Length), UART->Buffer.size());
+    std::copy(UART->Buffer.begin(), UART->Buffer.begin() + Count, static_cast<uint8_t*>(p_Buffer));
+    UART->Buffer.erase(UART->Buffer.begin(), UART->Buffer.begin() + Count);
+    UART->Read += Count;
+
+    return static_cast<int>(Count);
+}
+
+int uart_write_bytes(uart_port_t Port, const void* p_Buffer, size_t Length)
+{
+    size_t Written;
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if((UART == NULL) || (UART->isInstalled == false))
+    {
+        return -1;
+    }
+
+    Written = 0;
+    while(Written < Length)
+    {
+        ssize_t Result;
+
+        Result = write(UART->Fd[0], static_cast<const uint8_t*>(p_Buffer) + Written, Length - Written);
+        if(Result <= 0)
+        {
+            return -1;
+        }
+
+        Written += Result;
+    }
+
+    return static_cast<int>(Length);
+}
+
+esp_err_t uart_flush(uart_port_t Port)
+{
+    return uart_flush_input(Port);
+}
+
+esp_err_t uart_flush_input(uart_port_t Port)
+{
+    RAK3172_Shim_UART_t* UART = RAK3172_Shim_UART_Get(Port);
+
+    if(UART == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> Lock(UART->Mutex);
+    UART->Read += UART->Buffer.size();
+    UART->Buffer.clear();
+    UART->Patterns.clear();
+
+    return ESP_OK;
+}
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t Port, int Threshold)
+{
+    (void)Threshold;
+
+    return (RAK3172_Shim_UART_Get(Port) == NULL) ? ESP_FAIL : ESP_OK;
+}
@@ -0,0 +1,108 @@
+ /*
+ * rak3172_capture_types.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Binary format of the RAK3172 UART capture.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_CAPTURE_TYPES_H_
+#define RAK3172_CAPTURE_TYPES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Size of an encoded capture record header in bytes.
+ *         The header contains the timestamp (4 bytes), the record type (1 byte) and the data length (2 bytes) in little endian byte order.
+ *         The data of the record follows the header.
+ */
+#define RAK3172_CAPTURE_HEADER_SIZE                             7
+
+/** @brief Maximum data length of a single capture record.
+ */
+#define RAK3172_CAPTURE_MAX_LENGTH                              0xFFFF
+
+/** @brief RAK3172 capture record types.
+ */
+typedef enum
+{
+    RAK_CAPTURE_TX          = 0,        /**< Bytes written to the module. */
+    RAK_CAPTURE_RX,                     /**< Bytes read from the module. */
+    RAK_CAPTURE_LOST,                   /**< Received bytes were dropped by the UART driver. The record has no data. */
+} RAK3172_CaptureType_t;
+
+/** @brief RAK3172 decoded capture record.
+ */
+typedef struct
+{
+    uint32_t Timestamp;                 /**< Lower 32 bit of the record time in microseconds since boot. */
+    RAK3172_CaptureType_t Type;         /**< Record type. */
+    uint16_t Length;                    /**< Data length in bytes. */
+    const uint8_t* Data;                /**< Pointer to the record data. */
+} RAK3172_CaptureRecord_t;
+
+/** @brief          Encode a capture record header.
+ *  @param p_Header Pointer to header buffer with RAK3172_CAPTURE_HEADER_SIZE bytes
+ *  @param Timestamp Record time in microseconds
+ *  @param Type     Record type
+ *  @param Length   Data length in bytes
+ */
+static inline void RAK3172_Capture_EncodeHeader(uint8_t* p_Header, uint32_t Timestamp, RAK3172_CaptureType_t Type, uint16_t Length)
+{
+    p_Header[0] = static_cast<uint8_t>(Timestamp);
+    p_Header[1] = static_cast<uint8_t>(Timestamp >> 8);
+    p_Header[2] = static_cast<uint8_t>(Timestamp >> 16);
+    p_Header[3] = static_cast<uint8_t>(Timestamp >> 24);
+    p_Header[4] = static_cast<uint8_t>(Type);
+    p_Header[5] = static_cast<uint8_t>(Length);
+    p_Header[6] = static_cast<uint8_t>(Length >> 8);
+}
+
+/** @brief          Decode the next record of a capture.
+ *  @param p_Data   Pointer to capture data
+ *  @param Length   Length of the capture data
+ *  @param p_Record Pointer to decoded record. The data pointer of the record points into the capture data
+ *  @return         Size of the record in bytes or 0 when the capture doesn´t contain a complete record
+ */
+static inline size_t RAK3172_Capture_Decode(const uint8_t* p_Data, size_t Length, RAK3172_CaptureRecord_t* const p_Record)
+{
+    if(Length < RAK3172_CAPTURE_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    p_Record->Timestamp = static_cast<uint32_t>(p_Data[0]) | (static_cast<uint32_t>(p_Data[1]) << 8) | (static_cast<uint32_t>(p_Data[2]) << 16) |
+                          (static_cast<uint32_t>(p_Data[3]) << 24);
+    p_Record->Type = static_cast<RAK3172_CaptureType_t>(p_Data[4]);
+    p_Record->Length = static_cast<uint16_t>(p_Data[5] | (p_Data[6] << 8));
+    p_Record->Data = p_Data + RAK3172_CAPTURE_HEADER_SIZE;
+
+    if((Length - RAK3172_CAPTURE_HEADER_SIZE) < p_Record->Length)
+    {
+        return 0;
+    }
+
+    return RAK3172_CAPTURE_HEADER_SIZE + p_Record->Length;
+}
+
+/** @brief          Capture sink definition. The sink receives the encoded capture as byte stream in arbitrary chunks.
+ *                  NOTE: The sink is called from the UART event task and from the tasks which transmit commands. It must not block
+ *                  and must not call driver functions.
+ *  @param p_Data   Pointer to capture data
+ *  @param Length   Length of the capture data
+ *  @param p_Arg    User argument of the sink
+ */
+typedef void (*RAK3172_Capture_Sink_t)(const uint8_t* p_Data, size_t Length, void* p_Arg);
+
+#endif /* RAK3172_CAPTURE_TYPES_H_ */
@@ -0,0 +1,313 @@
+ /*
+ * rak3172_command.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Allocation free AT command builder for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_COMMAND_H_
+#define RAK3172_COMMAND_H_
+
+#include <string_view>
+#include <type_traits>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/** @brief Maximum length of a command without the line ending that can be stored in a #RAK3172_Command_t object.
+ */
+#define RAK3172_COMMAND_SIZE                                    128
+
+/** @brief Maximum length of a command with a payload in hex notation (i. e. "AT+PSEND=" with 255 bytes).
+ */
+#define RAK3172_COMMAND_PAYLOAD_SIZE                            544
+
+/** @brief Maximum length of a command with a long payload in hex notation (i. e. "AT+LPSEND=" with 1000 bytes).
+ */
+#define RAK3172_COMMAND_LONG_PAYLOAD_SIZE                       2016
+
+/** @brief RAK3172 command buffer. The command is stored together with the line ending so that it can be written with a
+ *         single UART transfer.
+ */
+template<size_t Size>
+struct RAK3172_CommandBuffer_t
+{
+    char Buffer[Size + 2];                  /**< Command followed by "\r\n". The buffer isn´t zero terminated. */
+    size_t Length;                          /**< Length of the command without the line ending. */
+    bool isOverflow;                        /**< #true when the command didn´t fit into the buffer. */
+};
+
+/** @brief RAK3172 command object for commands without payload.
+ */
+typedef RAK3172_CommandBuffer_t<RAK3172_COMMAND_SIZE> RAK3172_Command_t;
+
+/** @brief RAK3172 command object for commands with a payload.
+ */
+typedef RAK3172_CommandBuffer_t<RAK3172_COMMAND_PAYLOAD_SIZE> RAK3172_PayloadCommand_t;
+
+/** @brief RAK3172 command object for commands with a long payload. The object is too large for the stack of most tasks.
+ */
+typedef RAK3172_CommandBuffer_t<RAK3172_COMMAND_LONG_PAYLOAD_SIZE> RAK3172_LongPayloadCommand_t;
+
+/** @brief Binary data which is appended in hex notation to a command.
+ */
+typedef struct
+{
+    const uint8_t* p_Data;                  /**< Pointer to data. */
+    size_t Length;                          /**< Length of the data in bytes. */
+    bool isUpperCase;                       /**< #true when upper case hex digits should be used. */
+} RAK3172_CommandHex_t;
+
+/** @brief Lookup table with the two hex digits of each byte value.
+ */
+typedef struct
+{
+    char Digits[256 * 2];                   /**< Hex digits of the byte values 0x00 to 0xFF. */
+} RAK3172_HexTable_t;
+
+/** @brief          Create the lookup table for the hex notation.
+ *  @param p_Digits Hex digits in ascending order
+ *  @return         Lookup table
+ */
+constexpr RAK3172_HexTable_t RAK3172_Command_HexTable(const char* p_Digits)
+{
+    RAK3172_HexTable_t Table = {};
+
+    for(size_t i = 0; i < 256; i++)
+    {
+        Table.Digits[2 * i] = p_Digits[i >> 4];
+        Table.Digits[(2 * i) + 1] = p_Digits[i & 0x0F];
+    }
+
+    return Table;
+}
+
+inline constexpr RAK3172_HexTable_t _RAK3172_Command_HexLower = RAK3172_Command_HexTable("0123456789abcdef");
+inline constexpr RAK3172_HexTable_t _RAK3172_Command_HexUpper = RAK3172_Command_HexTable("0123456789ABCDEF");
+
+/** @brief              Encode binary data in hex notation. Four bytes are encoded into a single 8 byte word.
+ *                      NOTE: The output isn´t zero terminated.
+ *  @param p_Hex        Output buffer with at least 2 * Length characters
+ *  @param p_Data       Pointer to data
+ *  @param Length       Length of the data in bytes
+ *  @param isUpperCase  (Optional) Use upper case hex digits
+ */
+inline void RAK3172_Command_EncodeHex(char* p_Hex, const uint8_t* p_Data, size_t Length, bool isUpperCase = false)
+{
+    char Word[8];
+    const char* Table;
+    const uint8_t* p_End;
+
+    Table = isUpperCase ? _RAK3172_Command_HexUpper.Digits : _RAK3172_Command_HexLower.Digits;
+    p_End = p_Data + Length;
+
+    while((p_End - p_Data) >= 4)
+    {
+        memcpy(&Word[0], &Table[2 * p_Data[0]], 2);
+        memcpy(&Word[2], &Table[2 * p_Data[1]], 2);
+        memcpy(&Word[4], &Table[2 * p_Data[2]], 2);
+        memcpy(&Word[6], &Table[2 * p_Data[3]], 2);
+        memcpy(p_Hex, Word, sizeof(Word));
+
+        p_Data += 4;
+        p_Hex += sizeof(Word);
+    }
+
+    while(p_Data < p_End)
+    {
+        memcpy(p_Hex, &Table[2 * *p_Data++], 2);
+        p_Hex += 2;
+    }
+}
+
+/** @brief              Wrap binary data for the hex notation in a command.
+ *  @param p_Data       Pointer to data
+ *  @param Length       Length of the data in bytes
+ *  @param isUpperCase  (Optional) Use upper case hex digits
+ *  @return             Hex object for #RAK3172_Command_Build
+ */
+inline RAK3172_CommandHex_t RAK3172_Command_Hex(const void* p_Data, size_t Length, bool isUpperCase = false)
+{
+    return RAK3172_CommandHex_t{static_cast<const uint8_t*>(p_Data), Length, isUpperCase};
+}
+
+/** @brief              Append a string to a command.
+ *  @param p_Command    Command object
+ *  @param Text         String
+ */
+template<size_t Size>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, std::string_view Text)
+{
+    if((p_Command.Length + Text.size()) > Size)
+    {
+        p_Command.isOverflow = true;
+
+        return;
+    }
+
+    Text.copy(&p_Command.Buffer[p_Command.Length], Text.size());
+    p_Command.Length += Text.size();
+}
+
+/** @brief              Append a zero terminated string to a command.
+ *                      NOTE: This overload prevents the conversion of string literals to #bool.
+ *  @param p_Command    Command object
+ *  @param p_Text       Pointer to zero terminated string
+ */
+template<size_t Size>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, const char* p_Text)
+{
+    RAK3172_Command_Append(p_Command, std::string_view(p_Text));
+}
+
+/** @brief              Append a single character to a command.
+ *  @param p_Command    Command object
+ *  @param Character    Character
+ */
+template<size_t Size>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, char Character)
+{
+    if(p_Command.Length >= Size)
+    {
+        p_Command.isOverflow = true;
+
+        return;
+    }
+
+    p_Command.Buffer[p_Command.Length++] = Character;
+}
+
+/** @brief              Append a boolean as '1' or '0' to a command.
+ *  @param p_Command    Command object
+ *  @param Value        Value
+ */
+template<size_t Size>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, bool Value)
+{
+    RAK3172_Command_Append(p_Command, Value ? '1' : '0');
+}
+
+/** @brief              Append binary data in hex notation to a command.
+ *  @param p_Command    Command object
+ *  @param Hex          Hex object from #RAK3172_Command_Hex
+ */
+template<size_t Size>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, const RAK3172_CommandHex_t& Hex)
+{
+    if((p_Command.Length + (Hex.Length * 2)) > Size)
+    {
+        p_Command.isOverflow = true;
+
+        return;
+    }
+
+    RAK3172_Command_EncodeHex(&p_Command.Buffer[p_Command.Length], Hex.p_Data, Hex.Length, Hex.isUpperCase);
+    p_Command.Length += Hex.Length * 2;
+}
+
+/** @brief              Append an integer or an enum value in decimal notation to a command.
+ *  @param p_Command    Command object
+ *  @param Value        Value
+ */
+template<size_t Size, typename T, typename std::enable_if<(std::is_integral<T>::value || std::is_enum<T>::value) &&
+                                                          !std::is_same<T, bool>::value && !std::is_same<T, char>::value, int>::type = 0>
+inline void RAK3172_Command_Append(RAK3172_CommandBuffer_t<Size>& p_Command, T Value)
+{
+    char Digits[20];
+    uint8_t Count;
+    uint64_t Magnitude;
+    int64_t Signed;
+
+    Signed = static_cast<int64_t>(Value);
+    if(std::is_signed<T>::value && (Signed < 0))
+    {
+        RAK3172_Command_Append(p_Command, '-');
+        Magnitude = static_cast<uint64_t>(-(Signed + 1)) + 1;
+    }
+    else
+    {
+        Magnitude = static_cast<uint64_t>(Value);
+    }
+
+    Count = 0;
+    do
+    {
+        Digits[Count++] = '0' + (Magnitude % 10);
+        Magnitude /= 10;
+    } while(Magnitude > 0);
+
+    while(Count > 0)
+    {
+        RAK3172_Command_Append(p_Command, Digits[--Count]);
+    }
+}
+
+/** @brief              Build a command from a list of strings, characters and numbers and append the line ending.
+ *                      Example: RAK3172_Command_Build(Command, "AT+JOIN=1:", EnableAutoJoin, ':', Interval)
+ *  @param p_Command    Command object
+ *  @param Parts        Parts of the command
+ *  @return             Command object
+ */
+template<size_t Size, typename... Args>
+inline const RAK3172_CommandBuffer_t<Size>& RAK3172_Command_Build(RAK3172_CommandBuffer_t<Size>& p_Command, const Args&... Parts)
+{
+    p_Command.Length = 0;
+    p_Command.isOverflow = false;
+
+    (RAK3172_Command_Append(p_Command, Parts), ...);
+
+    p_Command.Buffer[p_Command.Length] = '\r';
+    p_Command.Buffer[p_Command.Length + 1] = '\n';
+
+    return p_Command;
+}
+
+/** @brief          Create a command object for commands without payload from a list of strings, characters and numbers.
+ *                  Example: RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PFREQ=", Frequency))
+ *  @param Parts    Parts of the command
+ *  @return         Command object
+ */
+template<typename... Args>
+inline RAK3172_Command_t RAK3172_Command_Create(const Args&... Parts)
+{
+    RAK3172_Command_t Command;
+
+    RAK3172_Command_Build(Command, Parts...);
+
+    return Command;
+}
+
+/** @brief              Get the command without the line ending.
+ *  @param p_Command    Command object
+ *  @return             Command string
+ */
+template<size_t Size>
+inline std::string_view RAK3172_Command_View(const RAK3172_CommandBuffer_t<Size>& p_Command)
+{
+    return std::string_view(p_Command.Buffer, p_Command.Length);
+}
+
+/** @brief              Get the command with the line ending.
+ *  @param p_Command    Command object
+ *  @return             Command string with line ending
+ */
+template<size_t Size>
+inline std::string_view RAK3172_Command_Line(const RAK3172_CommandBuffer_t<Size>& p_Command)
+{
+    return std::string_view(p_Command.Buffer, p_Command.Length + 2);
+}
+
+#endif /* RAK3172_COMMAND_H_ */
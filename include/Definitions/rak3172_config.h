@@ -37,12 +37,26 @@
         .Handle = NULL,                                                 \
         .RxBuffer = NULL,                                               \
         .MessageQueue = NULL,                                           \
+        .LinePool = NULL,                                               \
+        .LineFreeQueue = NULL,                                          \
+        .Stats = {},                                                    \
         .EventQueue = NULL,                                             \
         .ReceiveQueue = NULL,                                           \
+        .EventGroup = NULL,                                             \
         .isJoinEvent = false,                                           \
         .isInitialized = false,                                         \
         .isBusy = false,                                                \
         .isRestricted = false,                                          \
+        .isRxPending = false,                                           \
+        .PendingRx = {},                                                \
+        .Subscriptions = {},                                            \
+        .LineTimestamp = 0,                                             \
+        .EventTimestamps = {},                                          \
+        .Shadow = {},                                                   \
+        .Lock = NULL,                                                   \
+        .LockDepth = 0,                                                 \
+        .LockPriority = 0,                                              \
+        .isLockBoosted = false,                                         \
     },                                                                  \
     .LoRaWAN = {                                                        \
         .Join = RAK_JOIN_ABP,                                           \
@@ -27,7 +27,9 @@
 #include <freertos/task.h>
 #include <freertos/event_groups.h>
 #include <freertos/queue.h>
+#include <freertos/semphr.h>
 
+#include <atomic>
 #include <string>
 #include <stdint.h>
 #include <stdbool.h>
@@ -36,6 +38,8 @@
 
 #include "rak3172_errors.h"
 #include "rak3172_config.h"
+#include "rak3172_capture_types.h"
+#include "rak3172_event_types.h"
 
 /** @brief Timeout for UART receive queue.
  */
@@ -95,6 +99,24 @@ typedef enum
     RAK_BAUD_115200         = 115200,   /**< Baud rate 115200. */
 } RAK3172_Baud_t;
 
+/** @brief Device lock priorities.
+ */
+typedef enum
+{
+    RAK_PRIO_NORMAL         = 0,        /**< Wait for the lock with the priority of the calling task. */
+    RAK_PRIO_URGENT,                    /**< Wait for the lock with at least the priority CONFIG_RAK3172_LOCK_URGENT_PRIO. */
+} RAK3172_Priority_t;
+
+/** @brief Command timeout classes.
+ */
+typedef enum
+{
+    RAK_TIMEOUT_QUERY       = 0,        /**< Query commands, i. e. "AT+DR=?". */
+    RAK_TIMEOUT_SET,                    /**< Set and action commands. */
+    RAK_TIMEOUT_SLOW,                   /**< Commands which write the module flash or restart the LoRa stack, i. e. "AT+NWM=1". */
+    RAK_TIMEOUT_CLASS_MAX,              /**< Number of timeout classes. */
+} RAK3172_TimeoutClass_t;
+
 /** @brief LoRaWAN class definitions.
  */
 typedef enum
@@ -248,6 +270,255 @@ typedef struct
     std::string RepoInfo;               /**< Firmware repo information. */
 } RAK3172_Info_t;
 
+/** @brief RAK3172 line object used by the UART event task to pass received lines to the application.
+ */
+typedef struct
+{
+    uint16_t Length;                                    /**< Length of the line without line ending. */
+    int64_t Timestamp;                                  /**< Time of the UART event which has received the line in microseconds since boot. */
+    char Data[CONFIG_RAK3172_UART_LINE_SIZE + 1];       /**< Zero terminated line without line ending. */
+} RAK3172_Line_t;
+
+/** @brief RAK3172 receive information object for binary payloads.
+ */
+typedef struct
+{
+    int8_t RSSI;                        /**< Receiving RSSI value. */
+    int8_t SNR;                         /**< Receiving SNR value. */
+    bool isMulticast;                   /**< #true when a multicast message.
+                                             NOTE: Only used in LoRaWAN mode! */
+    uint8_t Port;                       /**< Port number.
+                                             NOTE: Only used in LoRaWAN mode! */
+    RAK3172_Rx_Group_t Group;           /**< Receive group.
+                                             NOTE: Only used in LoRaWAN mode! */
+    uint16_t Length;                    /**< Length of the payload in bytes. */
+    int64_t Timestamp;                  /**< Time of the UART event which has received the message in microseconds since boot. */
+} RAK3172_RxInfo_t;
+
+/** @brief RAK3172 binary receive message object.
+ */
+typedef struct
+{
+    RAK3172_RxInfo_t Info;                                  /**< Receive information. */
+    uint8_t Payload[CONFIG_RAK3172_UART_RX_PAYLOAD_SIZE];   /**< Decoded payload. */
+} RAK3172_RxFrame_t;
+
+/** @brief RAK3172 app time object.
+ */
+typedef struct
+{
+    uint32_t DeviceTime;                /**< Current end-device clock and is expressed as the time in seconds since 00:00:00,
+                                             Sunday 6th of January 1980 (start of the GPS epoch) modulo 2^32. */
+    union
+    {
+        struct
+        {
+            uint8_t TokenReq:4;         /**< 4 bits counter initially set to 0. TokenReq is incremented (modulo 16) each
+                                             time the end-device receives and processes successfully an AppTimeAns message. */
+            uint8_t AnsRequired:1;      /**< If set to 1 the end-device expects an answer whether its clock is well synchronized or not. */
+            uint8_t RFU:3;              /**< */
+        } __attribute__((packed)) Fields;
+        uint8_t Raw;
+    } Param;
+} __attribute__((packed)) RAK3172_AppTime_t;
+
+/** @brief RAK3172 driver statistics object.
+ */
+typedef struct
+{
+    uint8_t LinePoolHighWater;          /**< Maximum number of line buffers in use at the same time. */
+    uint32_t LinePoolExhausted;         /**< Number of lines dropped because no line buffer was available. */
+    uint32_t LinesTruncated;            /**< Number of lines which were truncated because they are longer than the line buffer. */
+    uint32_t MessageDropped;            /**< Number of lines dropped because the message queue was full. */
+    uint32_t ReceiveDropped;            /**< Number of messages dropped because the receive queue was full. */
+    uint32_t EventDropped;              /**< Number of events dropped because the queue of a subscriber was full. */
+    uint32_t EventUnhandled;            /**< Number of unknown events and events of the other mode which are passed on as regular lines. */
+    uint32_t FifoOverflows;             /**< Number of UART hardware FIFO overflows. */
+    uint32_t BufferFull;                /**< Number of UART ring buffer full events. */
+    uint32_t PatternMisses;             /**< Number of detected line endings without a position in the pattern queue. */
+    uint32_t ParseErrors;               /**< Number of receive events which cannot be parsed. */
+    uint32_t LockAcquired;              /**< Number of acquired device locks. */
+    uint32_t LockWaits;                 /**< Number of device locks which were acquired after waiting for another task. */
+    uint32_t LockTimeouts;              /**< Number of device lock requests which have timed out. */
+    uint64_t LockWaitTime;              /**< Total time spent waiting for the device lock in microseconds. */
+    uint32_t LockWaitMax;               /**< Maximum time spent waiting for the device lock in microseconds. */
+} RAK3172_Stats_t;
+
+/** @brief Settings which are stored in the configuration shadow of the device object.
+ */
+typedef enum
+{
+    RAK_SHADOW_BAND         = (0x01 << 0),      /**< LoRaWAN frequency band. */
+    RAK_SHADOW_SUB_BAND     = (0x01 << 1),      /**< LoRaWAN sub band. */
+    RAK_SHADOW_DATARATE     = (0x01 << 2),      /**< LoRaWAN data rate. */
+    RAK_SHADOW_ADR          = (0x01 << 3),      /**< LoRaWAN adaptive data rate. */
+    RAK_SHADOW_CLASS        = (0x01 << 4),      /**< LoRaWAN device class. */
+    RAK_SHADOW_TX_PWR       = (0x01 << 5),      /**< LoRaWAN transmit power index. */
+    RAK_SHADOW_JOIN1_DELAY  = (0x01 << 6),      /**< LoRaWAN join accept delay 1. */
+    RAK_SHADOW_JOIN2_DELAY  = (0x01 << 7),      /**< LoRaWAN join accept delay 2. */
+    RAK_SHADOW_RX1_DELAY    = (0x01 << 8),      /**< LoRaWAN receive window delay 1. */
+    RAK_SHADOW_RX2_DELAY    = (0x01 << 9),      /**< LoRaWAN receive window delay 2. */
+    RAK_SHADOW_RETRIES      = (0x01 << 10),     /**< LoRaWAN retransmissions for confirmed messages. */
+    RAK_SHADOW_CONFIRMATION = (0x01 << 11),     /**< LoRaWAN confirmation mode. */
+    RAK_SHADOW_FREQUENCY    = (0x01 << 12),     /**< P2P frequency. */
+    RAK_SHADOW_SPREADING    = (0x01 << 13),     /**< P2P spreading factor. */
+    RAK_SHADOW_BANDWIDTH    = (0x01 << 14),     /**< P2P bandwidth. */
+    RAK_SHADOW_CODERATE     = (0x01 << 15),     /**< P2P coding rate. */
+    RAK_SHADOW_PREAMBLE     = (0x01 << 16),     /**< P2P preamble length. */
+    RAK_SHADOW_POWER        = (0x01 << 17),     /**< P2P transmit power. */
+    RAK_SHADOW_JOIN_MODE    = (0x01 << 18),     /**< LoRaWAN join mode.
+                                                     NOTE: Only used to report changes from #RAK3172_LoRaWAN_InitDiff. */
+    RAK_SHADOW_KEYS         = (0x01 << 19),     /**< LoRaWAN keys.
+                                                     NOTE: Only used to report changes from #RAK3172_LoRaWAN_InitDiff. */
+} RAK3172_ShadowFlag_t;
+
+/** @brief RAK3172 configuration shadow object. Holds the last settings which were written to or read from the module.
+ */
+typedef struct
+{
+    uint32_t Valid;                     /**< Valid settings as combination of #RAK3172_ShadowFlag_t flags. */
+    RAK3172_Band_t Band;                /**< LoRaWAN frequency band. */
+    RAK3172_SubBand_t SubBand;          /**< LoRaWAN sub band. */
+    RAK3172_DataRate_t DataRate;        /**< LoRaWAN data rate.
+                                             NOTE: Only valid when ADR is disabled, because the module changes the data rate with ADR. */
+    bool ADR;                           /**< LoRaWAN adaptive data rate. */
+    uint8_t TxPwrIndex;                 /**< LoRaWAN transmit power index. */
+    uint32_t Join1Delay;                /**< LoRaWAN join accept delay 1 in seconds. */
+    uint32_t Join2Delay;                /**< LoRaWAN join accept delay 2 in seconds. */
+    uint32_t RX1Delay;                  /**< LoRaWAN receive window delay 1 in seconds. */
+    uint32_t RX2Delay;                  /**< LoRaWAN receive window delay 2 in seconds. */
+    uint8_t Retries;                    /**< LoRaWAN retransmissions for confirmed messages. */
+    bool Confirmation;                  /**< LoRaWAN confirmation mode. */
+    uint32_t Frequency;                 /**< P2P frequency. */
+    RAK3172_PSF_t Spreading;            /**< P2P spreading factor. */
+    RAK3172_BW_t Bandwidth;             /**< P2P bandwidth. */
+    RAK3172_CR_t CodeRate;              /**< P2P coding rate. */
+    uint16_t Preamble;                  /**< P2P preamble length. */
+    uint8_t Power;                      /**< P2P transmit power. */
+} RAK3172_Shadow_t;
+
+/** @brief                  Event callback. The callback is called from the UART event task and must not block.
+ *  @param Event            Event type
+ *  @param p_Frame          Pointer to received message or #NULL when the event isn´t a receive event
+ *  @param p_Arg            User argument from the subscription
+ */
+typedef void (*RAK3172_EventCallback_t)(RAK3172_Event_t Event, const RAK3172_RxFrame_t* p_Frame, void* p_Arg);
+
+/** @brief RAK3172 event message object for event queues.
+ */
+typedef struct
+{
+    RAK3172_Event_t Event;              /**< Event type. */
+    int64_t Timestamp;                  /**< Time of the UART event which has received the event in microseconds since boot. */
+    RAK3172_RxFrame_t Frame;            /**< Received message.
+                                             NOTE: Only valid for receive events! */
+} RAK3172_EventMsg_t;
+
+/** @brief RAK3172 event subscription object.
+ */
+typedef struct
+{
+    RAK3172_Event_t Event;              /**< Subscribed event or #RAK_EVENT_NONE when the subscription is unused. */
+    RAK3172_EventCallback_t Callback;   /**< Callback or #NULL when the event is passed to a queue. */
+    QueueHandle_t Queue;                /**< Queue for #RAK3172_EventMsg_t objects or #NULL when the callback is used. */
+    void* p_Arg;                        /**< User argument for the callback. */
+} RAK3172_Subscription_t;
+
+#ifdef CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE
+    /** @brief Number of logarithmic latency buckets. Bucket i counts round trip times below 2^i ms.
+     */
+    #define RAK3172_LATENCY_BUCKETS                             16
+
+    /** @brief RAK3172 command latency histogram.
+     */
+    typedef struct
+    {
+        uint16_t Buckets[RAK3172_LATENCY_BUCKETS];          /**< Number of round trip times per bucket. */
+        uint16_t Samples;                                   /**< Number of round trip times in all buckets. */
+        uint32_t Timeout;                                   /**< Current timeout in ms or 0 when the static timeout is used. */
+    } RAK3172_Latency_t;
+#endif
+
+#ifdef CONFIG_RAK3172_UART_CAPTURE
+    /** @brief RAK3172 UART capture object.
+     */
+    typedef struct
+    {
+        SemaphoreHandle_t Lock;                             /**< Lock for the capture buffer and the sink. */
+        RAK3172_Capture_Sink_t Sink;                        /**< Capture sink or NULL when the RAM ring buffer is used. */
+        void* Arg;                                          /**< User argument for the capture sink. */
+        uint8_t* Buffer;                                    /**< RAM ring buffer with CONFIG_RAK3172_UART_CAPTURE_SIZE bytes. */
+        size_t Tail;                                        /**< Index of the oldest record in the ring buffer. */
+        size_t Used;                                        /**< Number of used bytes in the ring buffer. */
+        uint32_t Dropped;                                   /**< Number of records which were dropped because the ring buffer is full. */
+        bool isActive;                                      /**< #true when the UART traffic is recorded. */
+    } RAK3172_Capture_t;
+#endif
+
+#ifdef CONFIG_RAK3172_TRACE
+    /** @brief Maximum length of a command name in the trace including the zero terminator.
+     */
+    #define RAK3172_TRACE_COMMAND_SIZE                          12
+
+    /** @brief Number of logarithmic latency buckets in the trace. Bucket i counts latencies from 2^(i - 1) us to 2^i us and the last bucket all longer latencies.
+     */
+    #define RAK3172_TRACE_BUCKETS                               24
+
+    /** @brief RAK3172 command trace record.
+     */
+    typedef struct
+    {
+        char Command[RAK3172_TRACE_COMMAND_SIZE];           /**< Zero terminated command name without the value, i. e. "AT+DR=" or "AT+DR=?". */
+        int64_t Sent;                                       /**< Transmission time of the command in microseconds since boot. */
+        int64_t FirstResponse;                              /**< Reception time of the first response line in microseconds since boot or 0 when no line was received. */
+        int64_t Status;                                     /**< Reception time of the status line in microseconds since boot or 0 when the command has timed out. */
+        uint16_t BytesSent;                                 /**< Number of transmitted bytes including the line ending. */
+        uint16_t BytesReceived;                             /**< Number of received bytes including the line endings. */
+        RAK3172_Error_t Result;                             /**< Command result. */
+    } RAK3172_TraceRecord_t;
+
+    /** @brief RAK3172 command latency histogram. The latency is the time between the transmission and the status line.
+     */
+    typedef struct
+    {
+        char Command[RAK3172_TRACE_COMMAND_SIZE];           /**< Zero terminated command name without the value. */
+        uint32_t Count;                                     /**< Number of completed commands. */
+        uint32_t Timeouts;                                  /**< Number of timed out commands. They aren´t part of the buckets. */
+        uint32_t Max;                                       /**< Maximum latency in us. */
+        uint64_t Sum;                                       /**< Sum of all latencies in us. */
+        uint32_t Buckets[RAK3172_TRACE_BUCKETS];            /**< Number of latencies per bucket. */
+    } RAK3172_TraceHistogram_t;
+
+    /** @brief RAK3172 command trace object.
+     */
+    typedef struct
+    {
+        std::atomic<uint32_t> Head;                                             /**< Number of records written into the ring buffer. */
+        RAK3172_TraceRecord_t Records[CONFIG_RAK3172_TRACE_SIZE + 1];           /**< Ring buffer with the last records. The additional record is written by the driver while the others are read. */
+        RAK3172_TraceHistogram_t Histograms[CONFIG_RAK3172_TRACE_COMMANDS];     /**< Latency histograms of the first commands. */
+        uint32_t Untracked;                                                     /**< Number of commands without a free histogram. */
+        RAK3172_TraceRecord_t Current;                                          /**< Record of the running command. */
+        bool isActive;                                                          /**< #true while a command is traced. */
+    } RAK3172_Trace_t;
+#endif
+
+#ifdef CONFIG_RAK3172_COMMAND_ASYNC
+    /** @brief RAK3172 asynchronous command result object.
+     */
+    typedef struct
+    {
+        uint32_t ID;                                        /**< Command ID from #RAK3172_SendCommandAsync. */
+        RAK3172_Error_t Error;                              /**< Command result. */
+        char Value[CONFIG_RAK3172_COMMAND_ASYNC_SIZE + 1];  /**< Zero terminated value returned by a query command. */
+    } RAK3172_CommandResult_t;
+
+    /** @brief              Command completion callback. The callback is called from the command task.
+     *  @param p_Result     Pointer to command result
+     *  @param p_Arg        User argument from #RAK3172_SendCommandAsync
+     */
+    typedef void (*RAK3172_CommandCallback_t)(const RAK3172_CommandResult_t* p_Result, void* p_Arg);
+#endif
+
 /** @brief RAK3172 device object definition.
  */
 typedef struct
@@ -266,15 +537,23 @@ typedef struct
     RAK3172_Info_t* Info;               /**< (Optional) Pointer to device information object. */
     struct
     {
-        TaskHandle_t Handle;            /**< Handle for the UART receive task.
+        TaskHandle_t Handle;            /**< Handle for the UART receive task. #NULL when the shared event task is used.
                                              NOTE: Managed by the driver. */
         uint8_t* RxBuffer;              /**< Pointer to receive buffer.
                                              NOTE: Managed by the driver. */
-        QueueHandle_t MessageQueue;     /**< Module Rx message queue used by the receiving task.
+        QueueHandle_t MessageQueue;     /**< Module Rx message queue used by the receiving task. Transports pointers to #RAK3172_Line_t objects.
+                                             NOTE: Managed by the driver. */
+        RAK3172_Line_t* LinePool;       /**< Pointer to the preallocated line buffers.
+                                             NOTE: Managed by the driver. */
+        QueueHandle_t LineFreeQueue;    /**< Queue with all unused line buffers.
+                                             NOTE: Managed by the driver. */
+        mutable RAK3172_Stats_t Stats;  /**< Drop, overflow and lock statistics.
                                              NOTE: Managed by the driver. */
         QueueHandle_t EventQueue;       /**< Event queue used by the UART driver for the pattern detection.
                                              NOTE: Managed by the driver. */
-        QueueHandle_t ReceiveQueue;     /**< Receive message queue.
+        QueueHandle_t ReceiveQueue;     /**< Receive message queue. Transports #RAK3172_RxFrame_t objects.
+                                             NOTE: Managed by the driver. */
+        EventGroupHandle_t EventGroup;  /**< Event group used to wake up tasks which are waiting for a state change from the event task.
                                              NOTE: Managed by the driver. */
         bool isJoinEvent;               /**< #true when a join event has occured.
                                              NOTE: Only used for module firmware without RUI3 interface! */
@@ -284,6 +563,48 @@ typedef struct
                                              NOTE: Managed by the driver. */
         bool isRestricted;              /**< #true when the device is in restricted wait state.
                                              NOTE: Managed by the driver. */
+        bool isRxPending;               /**< #true when a receive event waits for the payload in the next line.
+                                             NOTE: Only used for module firmware without RUI3 interface! */
+        RAK3172_RxInfo_t PendingRx;     /**< Receive information of the receive event which waits for the payload.
+                                             NOTE: Only used for module firmware without RUI3 interface! */
+        RAK3172_Subscription_t Subscriptions[CONFIG_RAK3172_EVENT_SUBSCRIPTIONS];   /**< Event subscriptions of the application.
+                                                                                         NOTE: Managed by the driver. */
+        int64_t LineTimestamp;          /**< Time of the UART event of the line which is processed by the event task in microseconds since boot.
+                                             NOTE: Managed by the driver. */
+        int64_t EventTimestamps[RAK_EVENT_MAX];     /**< Time of the last occurrence of each event in microseconds since boot or 0 when the event hasn´t occurred.
+                                                         NOTE: Managed by the driver. */
+        mutable RAK3172_Shadow_t Shadow;    /**< Configuration shadow. Serves the getters without a module access.
+                                                 NOTE: Managed by the driver. */
+        SemaphoreHandle_t Lock;         /**< Recursive mutex which serializes the module access of multiple tasks.
+                                             NOTE: Managed by the driver. */
+        mutable uint8_t LockDepth;      /**< Nesting depth of the lock holder.
+                                             NOTE: Managed by the driver. */
+        mutable UBaseType_t LockPriority;   /**< Priority of the lock holder before an urgent request.
+                                                 NOTE: Managed by the driver. */
+        mutable bool isLockBoosted;     /**< #true when the priority of the lock holder was raised by an urgent request.
+                                             NOTE: Managed by the driver. */
+        #ifdef CONFIG_RAK3172_COMMAND_ASYNC
+            TaskHandle_t CommandHandle;     /**< Handle for the command task.
+                                                 NOTE: Managed by the driver. */
+            QueueHandle_t CommandQueue;     /**< Queue with the pending asynchronous commands.
+                                                 NOTE: Managed by the driver. */
+            SemaphoreHandle_t CommandDone;  /**< Given by the command task when it has completed all commands and stopped.
+                                                 NOTE: Managed by the driver. */
+            uint32_t CommandID;             /**< ID of the last asynchronous command.
+                                                 NOTE: Managed by the driver. */
+        #endif
+        #ifdef CONFIG_RAK3172_UART_CAPTURE
+            mutable RAK3172_Capture_t Capture;  /**< UART capture.
+                                                     NOTE: Managed by the driver. */
+        #endif
+        #ifdef CONFIG_RAK3172_TRACE
+            RAK3172_Trace_t* Trace;         /**< Pointer to the command trace.
+                                                 NOTE: Managed by the driver. */
+        #endif
+        #ifdef CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE
+            mutable RAK3172_Latency_t Latency[RAK_TIMEOUT_CLASS_MAX];   /**< Round trip times of each timeout class.
+                                                                             NOTE: Managed by the driver. */
+        #endif
     } Internal;
     struct
     {
@@ -297,6 +618,10 @@ typedef struct
                                              NOTE: Managed by the driver and only used when RUI3 isn´t used. */
         RAK3172_Class_t Class;          /**< Current device class.
                                              NOTE: Managed by the driver. */
+        #ifdef CONFIG_RAK3172_MODE_WITH_LORAWAN_CLOCK_SYNC
+            RAK3172_AppTime_t AppTime;  /**< Clock synchronization state.
+                                             NOTE: Managed by the driver. */
+        #endif
     } LoRaWAN;
     struct
     {
@@ -328,6 +653,7 @@ typedef struct
                                              NOTE: Only used in LoRaWAN mode! */
     RAK3172_Rx_Group_t Group;           /**< Receive group.
                                              NOTE: Only used in LoRaWAN mode! */
+    int64_t Timestamp;                  /**< Time of the UART event which has received the message in microseconds since boot. */
 } RAK3172_Rx_t;
 
 /** @brief RAK3172 multicast group configuration object.
@@ -380,23 +706,4 @@ typedef struct
     } Descriptor;                       /**< The descriptor field is a freely allocated 4 bytes field describing the file that is going to be transported through the fragmentation session. */
 } __attribute__((packed)) RAK3172_FragSetup_t;
 
-/** @brief RAK3172 app time object.
- */
-typedef struct
-{
-    uint32_t DeviceTime;                /**< Current end-device clock and is expressed as the time in seconds since 00:00:00,
-                                             Sunday 6th of January 1980 (start of the GPS epoch) modulo 2^32. */
-    union
-    {
-        struct
-        {
-            uint8_t TokenReq:4;         /**< 4 bits counter initially set to 0. TokenReq is incremented (modulo 16) each
-                                             time the end-device receives and processes successfully an AppTimeAns message. */
-            uint8_t AnsRequired:1;      /**< If set to 1 the end-device expects an answer whether its clock is well synchronized or not. */
-            uint8_t RFU:3;              /**< */
-        } __attribute__((packed)) Fields;
-        uint8_t Raw;
-    } Param;
-} __attribute__((packed)) RAK3172_AppTime_t;
-
 #endif /* RAK3172_DEFS_H_ */
\ No newline at end of file
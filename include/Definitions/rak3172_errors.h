@@ -105,4 +105,8 @@ typedef uint32_t RAK3172_Error_t;
  */
 #define RAK3172_ERR_COMMAND_NOT_FOUND   (RAK3172_ERR_BASE + 13)
 
+/** @brief The buffer is too small for the data.
+ */
+#define RAK3172_ERR_INVALID_SIZE        (RAK3172_ERR_BASE + 14)
+
 #endif /* RAK3172_ERRORS_H_ */
\ No newline at end of file
@@ -0,0 +1,41 @@
+ /*
+ * rak3172_event_types.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: RAK3172 event type definitions.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_EVENT_TYPES_H_
+#define RAK3172_EVENT_TYPES_H_
+
+/** @brief RAK3172 event types. The types are detected by the line classifier and used for the event subscriptions.
+ */
+typedef enum
+{
+    RAK_EVENT_NONE          = 0,        /**< Regular response line. */
+    RAK_EVENT_RESTRICTED,               /**< Restricted wait message from the module. */
+    RAK_EVENT_UNKNOWN,                  /**< Event that isn´t handled by the driver. */
+    RAK_EVENT_JOINED,                   /**< LoRaWAN join was successful. */
+    RAK_EVENT_JOIN_FAILED,              /**< LoRaWAN join failed. */
+    RAK_EVENT_TX_DONE,                  /**< LoRaWAN transmission done. */
+    RAK_EVENT_CONFIRMED_OK,             /**< LoRaWAN transmission was confirmed. */
+    RAK_EVENT_CONFIRMED_FAILED,         /**< LoRaWAN transmission wasn´t confirmed. */
+    RAK_EVENT_RX,                       /**< LoRaWAN downlink received. */
+    RAK_EVENT_P2P_RX_TIMEOUT,           /**< LoRa P2P receive timeout. */
+    RAK_EVENT_P2P_RX,                   /**< LoRa P2P message received. */
+    RAK_EVENT_MAX,                      /**< Number of event types. */
+} RAK3172_Event_t;
+
+#endif /* RAK3172_EVENT_TYPES_H_ */
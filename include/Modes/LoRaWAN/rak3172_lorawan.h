@@ -67,6 +67,29 @@
  */
 RAK3172_Error_t RAK3172_LoRaWAN_Init(RAK3172_t& p_Device, uint8_t TxPwr, RAK3172_JoinMode_t JoinMode, const uint8_t* const p_Key1, const uint8_t* const p_Key2, const uint8_t* const p_Key3, RAK3172_Class_t Class, RAK3172_Band_t Band, RAK3172_SubBand_t Subband = RAK_SUB_BAND_NONE, bool UseADR = true, uint32_t Timeout = 10);
 
+/** @brief              Initialize the RAK3172 module in LoRaWAN mode and write only the settings which differ from the configuration
+ *                      stored in the module. The current configuration is read back with a single batch of queries.
+ *                      NOTE: Use this function instead of #RAK3172_LoRaWAN_Init when the module persists its configuration (i. e. RUI3)
+ *                      to reduce the initialization time and the flash wear of the module.
+ *  @param p_Device     RAK3172 device object
+ *  @param TxPwr        Tx power in dB
+ *  @param JoinMode     LoRaWAN join mode
+ *  @param p_Key1       Pointer to key 1 (see #RAK3172_LoRaWAN_Init)
+ *  @param p_Key2       Pointer to key 2 (see #RAK3172_LoRaWAN_Init)
+ *  @param p_Key3       Pointer to key 3 (see #RAK3172_LoRaWAN_Init)
+ *  @param Class        LoRaWAN device class
+ *  @param Band         LoRaWAN frequency band
+ *  @param Subband      (Optional) LoRa sub band
+ *                      NOTE: Only needed when US915, AU915 or CN470 band is used. Otherwise set it to RAK_SUB_BAND_NONE!
+ *  @param UseADR       (Optional) Enable adaptive data rate
+ *  @param p_Changed    (Optional) Pointer to the written settings as combination of #RAK3172_ShadowFlag_t flags
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+ *                      RAK3172_ERR_INVALID_STATE when the device is not initialized. Please call \ref RAK3172_Init first!
+ *                      RAK3172_ERR_TIMEOUT when the module doesn´t answer the queries
+ */
+RAK3172_Error_t RAK3172_LoRaWAN_InitDiff(RAK3172_t& p_Device, uint8_t TxPwr, RAK3172_JoinMode_t JoinMode, const uint8_t* const p_Key1, const uint8_t* const p_Key2, const uint8_t* const p_Key3, RAK3172_Class_t Class, RAK3172_Band_t Band, RAK3172_SubBand_t Subband = RAK_SUB_BAND_NONE, bool UseADR = true, uint32_t* const p_Changed = NULL);
+
 /** @brief              Set the keys for OTAA mode.
  *  @param p_Device     RAK3172 device object
  *  @param p_DEVEUI     Pointer to LoRaWAN DEVEUI (8 Bytes)
@@ -150,6 +173,7 @@ bool RAK3172_LoRaWAN_isJoined(RAK3172_t& p_Device, bool Refresh = true);
  *                          RAK3172_ERR_INVALID_MODE when the device is not initialized as LoRaWAN device. Please call \ref RAK3172_LoRaWAN_Init first
  *                          RAK3172_ERR_INVALID_RESPONSE when a send confirmation is required, but a confirmation error has occured
  *                          RAK3172_ERR_RESTRICTED when a duty cycle restriction error has occured
+ *                          RAK3172_ERR_NO_MEM when the command for a payload with more than 256 bytes can not be allocated
  */
 RAK3172_Error_t RAK3172_LoRaWAN_Transmit(RAK3172_t& p_Device, uint8_t Port, const void* p_Buffer, uint16_t Length, bool Confirmed = false, uint8_t Retries = 0, bool WaitForTransmit = true, RAK3172_Wait_t Wait = NULL);
 
@@ -163,6 +187,20 @@ RAK3172_Error_t RAK3172_LoRaWAN_Transmit(RAK3172_t& p_Device, uint8_t Port, cons
  */
 RAK3172_Error_t RAK3172_LoRaWAN_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* const p_Message, uint32_t Timeout = 3);
 
+/** @brief              Check if a downlink message was received during the last uplink and pop one message with a binary payload from the stack.
+ *  @param p_Device     RAK3172 device object
+ *  @param p_Buffer     Pointer to payload buffer
+ *  @param Size         Size of the payload buffer in bytes
+ *  @param p_Info       Pointer to receive information object. The object contains the length of the payload
+ *  @param Timeout      (Optional) Wait timeout in seconds
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+ *                      RAK3172_ERR_INVALID_SIZE when the payload doesn´t fit into the buffer. The message is removed from the stack
+ *                      RAK3172_ERR_TIMEOUT when no message is available
+ *                      RAK3172_ERR_INVALID_MODE when the device is not initialized as LoRaWAN device. Please call \ref RAK3172_LoRaWAN_Init first
+ */
+RAK3172_Error_t RAK3172_LoRaWAN_ReceiveBinary(RAK3172_t& p_Device, uint8_t* const p_Buffer, size_t Size, RAK3172_RxInfo_t* const p_Info, uint32_t Timeout = 3);
+
 /** @brief          Set the number of confirmed payload retransmissions.
  *                  NOTE: This function also activates the confirmed transmission mode!
  *  @param p_Device RAK3172 device object
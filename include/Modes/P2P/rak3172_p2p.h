@@ -204,6 +204,22 @@ RAK3172_Error_t RAK3172_P2P_Transmit(const RAK3172_t& p_Device, const uint8_t* c
  */
 RAK3172_Error_t RAK3172_P2P_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* const p_Message, uint16_t Timeout);
 
+/** @brief              Receive a single P2P packet with a binary payload.
+ *                      NOTE: This is a blocking fuction!
+ *  @param p_Device     RAK3172 device object
+ *  @param p_Buffer     Pointer to payload buffer
+ *  @param Size         Size of the payload buffer in bytes
+ *  @param p_Info       Pointer to receive information object. The object contains the length of the payload
+ *  @param Timeout      Receive timeout in milliseconds
+ *                      NOTE: Only values below 65534 are allowed!
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_TIMEOUT when no message was received
+ *                      RAK3172_ERR_INVALID_SIZE when the payload doesn´t fit into the buffer
+ *                      RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+ *                      RAK3172_ERR_INVALID_MODE when the device is not initialized as P2P device. Please call \ref RAK3172_P2P_Init first
+ */
+RAK3172_Error_t RAK3172_P2P_ReceiveBinary(RAK3172_t& p_Device, uint8_t* const p_Buffer, size_t Size, RAK3172_RxInfo_t* const p_Info, uint16_t Timeout);
+
 /** @brief              Start the listening mode to receive LoRa P2P message.
  *  @param p_Device     RAK3172 device object
  *  @param Timeout      (Optional) Timeout in milliseconds.
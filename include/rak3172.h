@@ -20,7 +20,10 @@
 #ifndef RAK3172_H_
 #define RAK3172_H_
 
+#include <vector>
+
 #include "rak3172_defs.h"
+#include "rak3172_command.h"
 
 #ifdef CONFIG_RAK3172_USE_RUI3
     #include "rak3172_commands_rui3.h"
@@ -66,6 +69,16 @@ inline __attribute__((always_inline)) bool RAK3172_isBusy(const RAK3172_t& p_Dev
     return p_Device.Internal.isBusy;
 }
 
+/** @brief          Get the time of the last occurrence of an event.
+ *  @param p_Device RAK3172 device object
+ *  @param Event    Event type
+ *  @return         Time of the UART event which has received the event in microseconds since boot or 0 when the event hasn´t occurred
+ */
+inline __attribute__((always_inline)) int64_t RAK3172_GetEventTimestamp(const RAK3172_t& p_Device, RAK3172_Event_t Event)
+{
+    return (Event < RAK_EVENT_MAX) ? p_Device.Internal.EventTimestamps[Event] : 0;
+}
+
 /** @brief          Initialize the driver and the RAK3172 module.
  *  @param p_Device RAK3172 device object
  *  @return         RAK3172_ERR_OK when successful
@@ -77,8 +90,11 @@ RAK3172_Error_t RAK3172_Init(RAK3172_t& p_Device);
 
 /** @brief          Deinitialize the RAK3172 driver.
  *  @param p_Device RAK3172 device object
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_STATE when the driver isn´t initialized or the device lock can´t be taken
+ *                  RAK3172_ERR_TIMEOUT when the asynchronous command task doesn´t stop
  */
-void RAK3172_Deinit(RAK3172_t& p_Device);
+RAK3172_Error_t RAK3172_Deinit(RAK3172_t& p_Device);
 
 /** @brief          Set the baudrate of the module.
  *  @param p_Device RAK3172 device object
@@ -123,7 +139,25 @@ RAK3172_Error_t RAK3172_SoftReset(RAK3172_t& p_Device, uint32_t Timeout = 10);
     RAK3172_Error_t RAK3172_HardReset(RAK3172_t& p_Device, uint32_t Timeout = 10);
 #endif
 
-/** @brief          Transmit an AT command to the RAK3172 module.
+/** @brief          Acquire the device lock. All driver functions which communicate with the module acquire the lock for each command.
+ *                  Call this function to execute a sequence of commands without interruption by other tasks. The lock is recursive
+ *                  and uses priority inheritance.
+ *  @param p_Device RAK3172 device object
+ *  @param Priority (Optional) Lock priority. Use #RAK_PRIO_URGENT to get the lock ahead of background tasks
+ *  @param Timeout  (Optional) Maximum wait time in milliseconds
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_STATE when the driver is not initialized
+ *                  RAK3172_ERR_BUSY when the lock is not available within the timeout
+ */
+RAK3172_Error_t RAK3172_Acquire(const RAK3172_t& p_Device, RAK3172_Priority_t Priority = RAK_PRIO_NORMAL, uint32_t Timeout = CONFIG_RAK3172_LOCK_TIMEOUT);
+
+/** @brief          Release the device lock.
+ *  @param p_Device RAK3172 device object
+ */
+void RAK3172_Release(const RAK3172_t& p_Device);
+
+/** @brief          Transmit an AT command to the RAK3172 module. Commands up to RAK3172_COMMAND_SIZE characters are transmitted
+ *                  together with the line ending in a single UART transfer.
  *  @param p_Device RAK3172 device object
  *  @param Command  RAK3172 command
  *  @param p_Value  (Optional) Pointer to returned value.
@@ -132,8 +166,102 @@ RAK3172_Error_t RAK3172_SoftReset(RAK3172_t& p_Device, uint32_t Timeout = 10);
  *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
  *                  RAK3172_ERR_FAIL when an event happens, when the status is not "OK" or when the device is busy
  *                  RAK3172_ERR_TIMEOUT when a receive timeout occurs
+ *                  RAK3172_ERR_BUSY when the device lock is not available
+ */
+RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, std::string_view Command, std::string* const p_Value = NULL, std::string* const p_Status = NULL);
+
+/** @brief          Transmit a complete AT command line with line ending to the RAK3172 module in a single UART transfer.
+ *  @param p_Device RAK3172 device object
+ *  @param Line     RAK3172 command followed by "\r\n"
+ *  @param p_Value  (Optional) Pointer to returned value.
+ *  @param p_Status (Optional) Pointer to status string
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_ARG when the line ending is missing
+ *                  RAK3172_ERR_FAIL when an event happens, when the status is not "OK" or when the device is busy
+ *                  RAK3172_ERR_TIMEOUT when a receive timeout occurs
+ */
+RAK3172_Error_t RAK3172_SendLine(const RAK3172_t& p_Device, std::string_view Line, std::string* const p_Value = NULL, std::string* const p_Status = NULL);
+
+/** @brief          Transmit an AT command from a command object to the RAK3172 module.
+ *  @param p_Device RAK3172 device object
+ *  @param Command  Command object from #RAK3172_Command_Build or #RAK3172_Command_Create
+ *  @param p_Value  (Optional) Pointer to returned value.
+ *  @param p_Status (Optional) Pointer to status string
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_SIZE when the command didn´t fit into the command object
+ *                  RAK3172_ERR_FAIL when an event happens, when the status is not "OK" or when the device is busy
+ *                  RAK3172_ERR_TIMEOUT when a receive timeout occurs
+ */
+template<size_t Size>
+inline RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, const RAK3172_CommandBuffer_t<Size>& Command, std::string* const p_Value = NULL, std::string* const p_Status = NULL)
+{
+    if(Command.isOverflow)
+    {
+        return RAK3172_ERR_INVALID_SIZE;
+    }
+
+    return RAK3172_SendLine(p_Device, RAK3172_Command_Line(Command), p_Value, p_Status);
+}
+
+/** @brief              Transmit a batch of AT commands to the RAK3172 module. Up to CONFIG_RAK3172_COMMAND_PIPELINE_DEPTH commands
+ *                      are transmitted before the status of the first command is received. The responses are assigned to
+ *                      the commands in the order of transmission.
+ *                      NOTE: The remaining commands are aborted after a receive timeout, because the responses can´t be
+ *                      assigned anymore.
+ *  @param p_Device     RAK3172 device object
+ *  @param Commands     List with RAK3172 commands
+ *  @param p_Results    (Optional) Pointer to list with the result of each command
+ *  @param p_Values     (Optional) Pointer to list with the returned value of each command
+ *  @return             RAK3172_ERR_OK when all commands were successful or the result of the first failed command
+ */
+RAK3172_Error_t RAK3172_SendCommands(const RAK3172_t& p_Device, const std::vector<std::string>& Commands, std::vector<RAK3172_Error_t>* const p_Results = NULL, std::vector<std::string>* const p_Values = NULL);
+
+/** @brief              Transmit a batch of AT commands from command objects to the RAK3172 module.
+ *                      See #RAK3172_SendCommands for the handling of the responses.
+ *  @param p_Device     RAK3172 device object
+ *  @param p_Commands   Pointer to list with command objects from #RAK3172_Command_Build
+ *  @param Count        Number of commands
+ *  @param p_Results    (Optional) Pointer to list for Count results
+ *  @param p_Values     (Optional) Pointer to list for Count returned values
+ *  @return             RAK3172_ERR_OK when all commands were successful or the result of the first failed command
+ *                      RAK3172_ERR_INVALID_SIZE when a command didn´t fit into the command object
  */
-RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, std::string Command, std::string* const p_Value = NULL, std::string* const p_Status = NULL);
+RAK3172_Error_t RAK3172_SendCommands(const RAK3172_t& p_Device, const RAK3172_Command_t* p_Commands, size_t Count, RAK3172_Error_t* const p_Results = NULL,
+                                     std::string* const p_Values = NULL);
+
+#ifdef CONFIG_RAK3172_COMMAND_ASYNC
+    /** @brief              Put an AT command into the command queue of the driver and return immediately. The command is executed
+     *                      by the command task and the result is passed to the callback. Query commands (ending with '?') return
+     *                      the value in the result.
+     *                      NOTE: The command task acquires the device lock for each command like the blocking functions.
+     *  @param p_Device     RAK3172 device object
+     *  @param Command      RAK3172 command
+     *  @param Callback     Completion callback
+     *  @param p_Arg        (Optional) User argument for the callback
+     *  @param p_ID         (Optional) Pointer to command ID
+     *  @return             RAK3172_ERR_OK when successful
+     *                      RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+     *                      RAK3172_ERR_INVALID_SIZE when the command is longer than CONFIG_RAK3172_COMMAND_ASYNC_SIZE
+     *                      RAK3172_ERR_INVALID_STATE when the interface is not initialized
+     *                      RAK3172_ERR_BUSY when the command queue is full
+     */
+    RAK3172_Error_t RAK3172_SendCommandAsync(RAK3172_t& p_Device, std::string_view Command, RAK3172_CommandCallback_t Callback, void* p_Arg = NULL, uint32_t* p_ID = NULL);
+
+    /** @brief              Put an AT command into the command queue of the driver and return immediately. The result is passed as
+     *                      #RAK3172_CommandResult_t object to the completion queue. Results are dropped when the queue is full.
+     *                      NOTE: The command task acquires the device lock for each command like the blocking functions.
+     *  @param p_Device     RAK3172 device object
+     *  @param Command      RAK3172 command
+     *  @param Queue        Completion queue with an item size of sizeof(RAK3172_CommandResult_t)
+     *  @param p_ID         (Optional) Pointer to command ID
+     *  @return             RAK3172_ERR_OK when successful
+     *                      RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+     *                      RAK3172_ERR_INVALID_SIZE when the command is longer than CONFIG_RAK3172_COMMAND_ASYNC_SIZE
+     *                      RAK3172_ERR_INVALID_STATE when the interface is not initialized
+     *                      RAK3172_ERR_BUSY when the command queue is full
+     */
+    RAK3172_Error_t RAK3172_SendCommandAsyncQueue(RAK3172_t& p_Device, std::string_view Command, QueueHandle_t Queue, uint32_t* p_ID = NULL);
+#endif
 
 /** @brief              Get the firmware version of the RAK3172 module.
  *  @param p_Device     RAK3172 device object
@@ -179,4 +307,142 @@ RAK3172_Error_t RAK3172_GetMode(RAK3172_t& p_Device);
  */
 RAK3172_Error_t RAK3172_GetBaudrateFromDevice(RAK3172_t& p_Device, RAK3172_Baud_t* p_Baudrate);
 
+/** @brief          Get the receive statistics of the driver.
+ *                  NOTE: The counters are updated by the UART event task without locking. Single counters can be off by one
+ *                  event when they are read while the event task updates them.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Stats  Pointer to statistics object
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+ */
+RAK3172_Error_t RAK3172_GetStats(const RAK3172_t& p_Device, RAK3172_Stats_t* p_Stats);
+
+/** @brief          Reset the receive statistics of the driver.
+ *  @param p_Device RAK3172 device object
+ */
+void RAK3172_ResetStats(RAK3172_t& p_Device);
+
+#ifdef CONFIG_RAK3172_UART_CAPTURE
+    /** @brief          Start the recording of all bytes which are written to and read from the module.
+     *                  NOTE: The capture is encoded as described in rak3172_capture_types.h. It contains all transmitted data including keys and passwords.
+     *  @param p_Device RAK3172 device object
+     *  @param Sink     (Optional) Capture sink. The capture is stored in a RAM ring buffer with CONFIG_RAK3172_UART_CAPTURE_SIZE bytes
+     *                  when no sink is used. The oldest records are dropped when the ring buffer is full
+     *  @param p_Arg    (Optional) User argument for the capture sink
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_NO_MEM when the ring buffer or the lock cannot be allocated
+     */
+    RAK3172_Error_t RAK3172_StartCapture(RAK3172_t& p_Device, RAK3172_Capture_Sink_t Sink = NULL, void* p_Arg = NULL);
+
+    /** @brief          Stop the recording of the UART traffic. The ring buffer keeps the recorded data.
+     *  @param p_Device RAK3172 device object
+     */
+    void RAK3172_StopCapture(RAK3172_t& p_Device);
+
+    /** @brief          Move the oldest complete records from the capture ring buffer into a buffer.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Buffer Pointer to data buffer
+     *  @param Size     Size of the data buffer
+     *  @param p_Length Pointer to number of copied bytes
+     *  @param p_Dropped (Optional) Pointer to number of records which were dropped since the last call
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+     *                  RAK3172_ERR_INVALID_STATE when the capture doesn´t use the ring buffer
+     */
+    RAK3172_Error_t RAK3172_ReadCapture(const RAK3172_t& p_Device, uint8_t* p_Buffer, size_t Size, size_t* const p_Length, uint32_t* const p_Dropped = NULL);
+#endif
+
+#ifdef CONFIG_RAK3172_TRACE
+    /** @brief          Get the last command trace records.
+     *                  NOTE: The records are read without locking. Records which are overwritten while they are copied are skipped.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Records Pointer to list with Size records. The oldest record is stored first
+     *  @param Size     Number of records in the list
+     *  @param p_Count  Pointer to number of copied records
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+     *                  RAK3172_ERR_INVALID_STATE when the driver isn´t initialized
+     */
+    RAK3172_Error_t RAK3172_GetTrace(const RAK3172_t& p_Device, RAK3172_TraceRecord_t* const p_Records, size_t Size, size_t* const p_Count);
+
+    /** @brief          Get the latency histograms of all traced commands.
+     *                  NOTE: The histograms are read without locking. A histogram can miss the command which completes while it is copied.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Histograms Pointer to list with Size histograms
+     *  @param Size     Number of histograms in the list
+     *  @param p_Count  Pointer to number of copied histograms
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+     *                  RAK3172_ERR_INVALID_STATE when the driver isn´t initialized
+     */
+    RAK3172_Error_t RAK3172_GetLatencyHistograms(const RAK3172_t& p_Device, RAK3172_TraceHistogram_t* const p_Histograms, size_t Size, size_t* const p_Count);
+
+    /** @brief          Clear the command trace and the latency histograms.
+     *  @param p_Device RAK3172 device object
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_INVALID_STATE when the driver isn´t initialized
+     *                  RAK3172_ERR_BUSY when the device lock can´t be acquired
+     */
+    RAK3172_Error_t RAK3172_ResetTrace(const RAK3172_t& p_Device);
+#endif
+
+/** @brief          Invalidate the configuration shadow of the driver. The next getter reads the setting from the module again.
+ *                  NOTE: Call this function after changing module settings with #RAK3172_SendCommand or asynchronous commands.
+ *  @param p_Device RAK3172 device object
+ */
+void RAK3172_InvalidateShadow(const RAK3172_t& p_Device);
+
+/** @brief          Get the response timeout which is used for a command class.
+ *                  NOTE: The timeout follows the measured round trip times when CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE is enabled.
+ *  @param p_Device RAK3172 device object
+ *  @param Class    Timeout class
+ *  @param p_Timeout Pointer to timeout in ms
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+ */
+RAK3172_Error_t RAK3172_GetCommandTimeout(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, uint32_t* const p_Timeout);
+
+/** @brief              Subscribe a callback to an event. The callback is called from the UART event task after the driver
+ *                      has processed the event.
+ *                      NOTE: Received messages are still passed to the receive queue of the driver.
+ *  @param p_Device     RAK3172 device object
+ *  @param Event        Event type
+ *  @param Callback     Event callback
+ *  @param p_Arg        (Optional) User argument for the callback
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+ *                      RAK3172_ERR_NO_MEM when all subscriptions are in use
+ */
+RAK3172_Error_t RAK3172_Events_Subscribe(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback, void* p_Arg = NULL);
+
+/** @brief              Subscribe a queue to an event. The event is passed as #RAK3172_EventMsg_t object to the queue.
+ *                      Events are dropped when the queue is full.
+ *  @param p_Device     RAK3172 device object
+ *  @param Event        Event type
+ *  @param Queue        Queue with an item size of sizeof(RAK3172_EventMsg_t)
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when an invalid argument was passed
+ *                      RAK3172_ERR_NO_MEM when all subscriptions are in use
+ */
+RAK3172_Error_t RAK3172_Events_SubscribeQueue(RAK3172_t& p_Device, RAK3172_Event_t Event, QueueHandle_t Queue);
+
+/** @brief              Remove a callback subscription.
+ *                      NOTE: The callback can be called a last time when the event task processes the event at the same time.
+ *  @param p_Device     RAK3172 device object
+ *  @param Event        Event type
+ *  @param Callback     Event callback
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when the subscription doesn´t exist
+ */
+RAK3172_Error_t RAK3172_Events_Unsubscribe(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback);
+
+/** @brief              Remove a queue subscription.
+ *  @param p_Device     RAK3172 device object
+ *  @param Event        Event type
+ *  @param Queue        Event queue
+ *  @return             RAK3172_ERR_OK when successful
+ *                      RAK3172_ERR_INVALID_ARG when the subscription doesn´t exist
+ */
+RAK3172_Error_t RAK3172_Events_UnsubscribeQueue(RAK3172_t& p_Device, RAK3172_Event_t Event, QueueHandle_t Queue);
+
 #endif /* RAK3172_H_ */
\ No newline at end of file
@@ -24,4 +24,9 @@
 unsigned long RAK3172_Timer_GetMilliseconds(void)
 {
     return static_cast<unsigned long>(esp_timer_get_time() / 1000ULL);
+}
+
+int64_t RAK3172_Timer_GetMicroseconds(void)
+{
+    return esp_timer_get_time();
 }
\ No newline at end of file
@@ -29,4 +29,9 @@
  */
 unsigned long IRAM_ATTR RAK3172_Timer_GetMilliseconds(void);
 
+/** @brief  Get the microseconds from the ESP timer.
+ *  @return Microseconds since boot
+ */
+int64_t IRAM_ATTR RAK3172_Timer_GetMicroseconds(void);
+
 #endif /* RAK3172_TIMER_H_ */
\ No newline at end of file
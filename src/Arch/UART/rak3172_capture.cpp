@@ -0,0 +1,261 @@
+ /*
+ * rak3172_capture.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: UART capture for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <sdkconfig.h>
+
+#ifdef CONFIG_RAK3172_UART_CAPTURE
+
+#include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+
+#include <freertos/semphr.h>
+
+#include "rak3172_capture.h"
+
+/** @brief              Copy data into the capture ring buffer.
+ *  @param p_Capture    Pointer to capture object
+ *  @param p_Data       Pointer to data
+ *  @param Length       Length of the data
+ */
+static void RAK3172_Capture_Push(RAK3172_Capture_t* p_Capture, const void* p_Data, size_t Length)
+{
+    size_t Head;
+    size_t First;
+
+    Head = (p_Capture->Tail + p_Capture->Used) % CONFIG_RAK3172_UART_CAPTURE_SIZE;
+    First = std::min(Length, static_cast<size_t>(CONFIG_RAK3172_UART_CAPTURE_SIZE - Head));
+
+    memcpy(&p_Capture->Buffer[Head], p_Data, First);
+    memcpy(p_Capture->Buffer, static_cast<const uint8_t*>(p_Data) + First, Length - First);
+    p_Capture->Used += Length;
+}
+
+/** @brief              Copy data from the capture ring buffer without removing it.
+ *  @param p_Capture    Pointer to capture object
+ *  @param Offset       Offset from the oldest byte
+ *  @param p_Data       Pointer to data buffer
+ *  @param Length       Length of the data
+ */
+static void RAK3172_Capture_Peek(const RAK3172_Capture_t* p_Capture, size_t Offset, void* p_Data, size_t Length)
+{
+    size_t Index;
+    size_t First;
+
+    Index = (p_Capture->Tail + Offset) % CONFIG_RAK3172_UART_CAPTURE_SIZE;
+    First = std::min(Length, static_cast<size_t>(CONFIG_RAK3172_UART_CAPTURE_SIZE - Index));
+
+    memcpy(p_Data, &p_Capture->Buffer[Index], First);
+    memcpy(static_cast<uint8_t*>(p_Data) + First, p_Capture->Buffer, Length - First);
+}
+
+/** @brief              Get the size of the oldest record in the capture ring buffer.
+ *  @param p_Capture    Pointer to capture object
+ *  @return             Size of the record including the header
+ */
+static size_t RAK3172_Capture_GetRecordSize(const RAK3172_Capture_t* p_Capture)
+{
+    uint8_t Header[RAK3172_CAPTURE_HEADER_SIZE];
+    RAK3172_CaptureRecord_t Record;
+
+    RAK3172_Capture_Peek(p_Capture, 0, Header, sizeof(Header));
+
+    // Only the header is decoded. The data is still in the ring buffer.
+    RAK3172_Capture_Decode(Header, sizeof(Header), &Record);
+
+    return RAK3172_CAPTURE_HEADER_SIZE + Record.Length;
+}
+
+void RAK3172_Capture_Record(const RAK3172_t& p_Device, RAK3172_CaptureType_t Type, int64_t Timestamp, const void* p_Data, size_t Length)
+{
+    RAK3172_Capture_t* Capture = &p_Device.Internal.Capture;
+
+    if(Capture->isActive == false)
+    {
+        return;
+    }
+
+    xSemaphoreTake(Capture->Lock, portMAX_DELAY);
+
+    // Check again because the capture can be stopped while the lock is taken.
+    if(Capture->isActive == false)
+    {
+        xSemaphoreGive(Capture->Lock);
+
+        return;
+    }
+
+    // Split data which exceeds the length field of a single record.
+    do
+    {
+        size_t Part;
+        uint8_t Header[RAK3172_CAPTURE_HEADER_SIZE];
+
+        Part = std::min(Length, static_cast<size_t>(RAK3172_CAPTURE_MAX_LENGTH));
+        RAK3172_Capture_EncodeHeader(Header, static_cast<uint32_t>(Timestamp), Type, static_cast<uint16_t>(Part));
+
+        if(Capture->Sink != NULL)
+        {
+            Capture->Sink(Header, sizeof(Header), Capture->Arg);
+            if(Part > 0)
+            {
+                Capture->Sink(static_cast<const uint8_t*>(p_Data), Part, Capture->Arg);
+            }
+        }
+        else if((sizeof(Header) + Part) > CONFIG_RAK3172_UART_CAPTURE_SIZE)
+        {
+            Capture->Dropped++;
+        }
+        else
+        {
+            // Drop the oldest records until the new record fits into the ring buffer.
+            while((CONFIG_RAK3172_UART_CAPTURE_SIZE - Capture->Used) < (sizeof(Header) + Part))
+            {
+                size_t Size;
+
+                Size = RAK3172_Capture_GetRecordSize(Capture);
+                Capture->Tail = (Capture->Tail + Size) % CONFIG_RAK3172_UART_CAPTURE_SIZE;
+                Capture->Used -= Size;
+                Capture->Dropped++;
+            }
+
+            RAK3172_Capture_Push(Capture, Header, sizeof(Header));
+            RAK3172_Capture_Push(Capture, p_Data, Part);
+        }
+
+        p_Data = static_cast<const uint8_t*>(p_Data) + Part;
+        Length -= Part;
+    } while(Length > 0);
+
+    xSemaphoreGive(Capture->Lock);
+}
+
+void RAK3172_Capture_Deinit(RAK3172_t& p_Device)
+{
+    RAK3172_Capture_t* Capture = &p_Device.Internal.Capture;
+
+    RAK3172_StopCapture(p_Device);
+
+    if(Capture->Lock != NULL)
+    {
+        vSemaphoreDelete(Capture->Lock);
+        Capture->Lock = NULL;
+    }
+
+    free(Capture->Buffer);
+    Capture->Buffer = NULL;
+}
+
+RAK3172_Error_t RAK3172_StartCapture(RAK3172_t& p_Device, RAK3172_Capture_Sink_t Sink, void* p_Arg)
+{
+    RAK3172_Capture_t* Capture = &p_Device.Internal.Capture;
+
+    if(Capture->Lock == NULL)
+    {
+        Capture->Lock = xSemaphoreCreateMutex();
+        if(Capture->Lock == NULL)
+        {
+            return RAK3172_ERR_NO_MEM;
+        }
+    }
+
+    // The ring buffer is allocated only once and reused for the next captures.
+    if((Sink == NULL) && (Capture->Buffer == NULL))
+    {
+        Capture->Buffer = static_cast<uint8_t*>(malloc(CONFIG_RAK3172_UART_CAPTURE_SIZE));
+        if(Capture->Buffer == NULL)
+        {
+            return RAK3172_ERR_NO_MEM;
+        }
+    }
+
+    xSemaphoreTake(Capture->Lock, portMAX_DELAY);
+    Capture->Sink = Sink;
+    Capture->Arg = p_Arg;
+    Capture->Tail = 0;
+    Capture->Used = 0;
+    Capture->Dropped = 0;
+    Capture->isActive = true;
+    xSemaphoreGive(Capture->Lock);
+
+    return RAK3172_ERR_OK;
+}
+
+void RAK3172_StopCapture(RAK3172_t& p_Device)
+{
+    RAK3172_Capture_t* Capture = &p_Device.Internal.Capture;
+
+    if(Capture->Lock == NULL)
+    {
+        return;
+    }
+
+    // The lock ensures that the sink isn´t used anymore when the function returns.
+    xSemaphoreTake(Capture->Lock, portMAX_DELAY);
+    Capture->isActive = false;
+    xSemaphoreGive(Capture->Lock);
+}
+
+RAK3172_Error_t RAK3172_ReadCapture(const RAK3172_t& p_Device, uint8_t* p_Buffer, size_t Size, size_t* const p_Length, uint32_t* const p_Dropped)
+{
+    size_t Length;
+    RAK3172_Capture_t* Capture = &p_Device.Internal.Capture;
+
+    if((p_Buffer == NULL) || (p_Length == NULL))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+    else if((Capture->Lock == NULL) || (Capture->Buffer == NULL) || (Capture->Sink != NULL))
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(Capture->Lock, portMAX_DELAY);
+
+    Length = 0;
+    while(Capture->Used > 0)
+    {
+        size_t Record;
+
+        Record = RAK3172_Capture_GetRecordSize(Capture);
+        if((Length + Record) > Size)
+        {
+            break;
+        }
+
+        RAK3172_Capture_Peek(Capture, 0, &p_Buffer[Length], Record);
+        Capture->Tail = (Capture->Tail + Record) % CONFIG_RAK3172_UART_CAPTURE_SIZE;
+        Capture->Used -= Record;
+        Length += Record;
+    }
+
+    if(p_Dropped != NULL)
+    {
+        *p_Dropped = Capture->Dropped;
+        Capture->Dropped = 0;
+    }
+
+    xSemaphoreGive(Capture->Lock);
+
+    *p_Length = Length;
+
+    return RAK3172_ERR_OK;
+}
+
+#endif
@@ -0,0 +1,49 @@
+ /*
+ * rak3172_capture.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: UART capture for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_CAPTURE_H_
+#define RAK3172_CAPTURE_H_
+
+#include "rak3172.h"
+
+#ifdef CONFIG_RAK3172_UART_CAPTURE
+    /** @brief          Add a record to the capture.
+     *  @param p_Device RAK3172 device object
+     *  @param Type     Record type
+     *  @param Timestamp Record time in microseconds since boot
+     *  @param p_Data   Pointer to record data
+     *  @param Length   Length of the record data
+     */
+    void RAK3172_Capture_Record(const RAK3172_t& p_Device, RAK3172_CaptureType_t Type, int64_t Timestamp, const void* p_Data, size_t Length);
+
+    /** @brief          Stop the capture and free the ring buffer and the lock.
+     *  @param p_Device RAK3172 device object
+     */
+    void RAK3172_Capture_Deinit(RAK3172_t& p_Device);
+#else
+    static inline void RAK3172_Capture_Record(const RAK3172_t& p_Device, RAK3172_CaptureType_t Type, int64_t Timestamp, const void* p_Data, size_t Length)
+    {
+    }
+
+    static inline void RAK3172_Capture_Deinit(RAK3172_t& p_Device)
+    {
+    }
+#endif
+
+#endif /* RAK3172_CAPTURE_H_ */
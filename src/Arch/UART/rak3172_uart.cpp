@@ -17,13 +17,37 @@
  * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
  */
 
+#include <string.h>
+
 #include "rak3172_uart.h"
+#include "rak3172_capture.h"
 
 #include <sdkconfig.h>
 
+#include "../Timer/rak3172_timer.h"
 #include "../Logging/rak3172_logging.h"
+#include "../../Events/rak3172_events.h"
+#include "../../Parser/rak3172_line_parser.h"
+
+#ifdef CONFIG_RAK3172_TASK_SHARED
+    #include <freertos/semphr.h>
+#endif
+
+/** @brief Size of the chunks which are read from the UART driver in stream mode.
+ */
+#define RAK3172_UART_CHUNK_SIZE                                 128
+
+/** @brief Timeout in milliseconds for reading a detected line from the UART driver.
+ */
+#ifdef CONFIG_RAK3172_USE_RUI3
+    #define RAK3172_UART_READ_TIMEOUT                           10
+#else
+    #define RAK3172_UART_READ_TIMEOUT                           200
+#endif
 
-static uart_config_t _RAK3172_UART_Config = {
+/** @brief UART configuration template. The baudrate is taken from the device object.
+ */
+static const uart_config_t _RAK3172_UART_Config = {
     .baud_rate              = 9600,
     .data_bits              = UART_DATA_8_BITS,
     .parity                 = UART_PARITY_DISABLE,
@@ -45,377 +69,530 @@ static uart_config_t _RAK3172_UART_Config = {
     }
 };
 
-#ifdef CONFIG_RAK3172_USE_RUI3
-    static uint32_t _RAK3172_UART_Timeout = 10;
-#else
-    static uint32_t _RAK3172_UART_Timeout = 200;
+#ifdef CONFIG_RAK3172_TASK_SHARED
+    /** @brief Devices serviced by the shared event task.
+     */
+    static RAK3172_t* _RAK3172_UART_Devices[CONFIG_RAK3172_TASK_MAX_DEVICES];
+
+    #ifdef CONFIG_RAK3172_UART_RX_STREAM
+        /** @brief Stream line parser for each device slot of the shared event task.
+         */
+        static RAK3172_LineParser_t _RAK3172_UART_Parsers[CONFIG_RAK3172_TASK_MAX_DEVICES];
+    #endif
+
+    /** @brief Queue set with the event queues of all registered devices.
+     */
+    static QueueSetHandle_t _RAK3172_UART_QueueSet = NULL;
+
+    /** @brief Mutex to protect the device slots against concurrent changes while an event is processed.
+     */
+    static SemaphoreHandle_t _RAK3172_UART_Lock = NULL;
+
+    /** @brief Handle for the shared event task.
+     */
+    static TaskHandle_t _RAK3172_UART_SharedHandle = NULL;
 #endif
 
 static const char* TAG      = "RAK3172_UART";
 
-/** @brief          UART receive task.
- *  @param p_Arg    Pointer to task arguments
+/** @brief          Get an unused line buffer from the line pool.
+ *  @param p_Device RAK3172 device object
+ *  @return         Pointer to line object or NULL when the pool is exhausted
  */
-static void RAK3172_UART_EventTask(void* p_Arg)
+static RAK3172_Line_t* RAK3172_UART_AllocateLine(RAK3172_t* p_Device)
 {
-    uart_event_t Event;
-    RAK3172_t* Device;
+    UBaseType_t InUse;
+    RAK3172_Line_t* Line;
+
+    if(xQueueReceive(p_Device->Internal.LineFreeQueue, &Line, 0) != pdPASS)
+    {
+        p_Device->Internal.Stats.LinePoolExhausted++;
+
+        return NULL;
+    }
+
+    InUse = CONFIG_RAK3172_UART_LINE_POOL_SIZE - uxQueueMessagesWaiting(p_Device->Internal.LineFreeQueue);
+    if(InUse > p_Device->Internal.Stats.LinePoolHighWater)
+    {
+        p_Device->Internal.Stats.LinePoolHighWater = InUse;
+    }
+
+    return Line;
+}
+
+/** @brief          Pass a line to the message queue. The overflow policy is used when the queue is full.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Line   Pointer to line object. The line is returned to the line pool when it is dropped
+ */
+static void RAK3172_UART_PushLine(RAK3172_t* p_Device, RAK3172_Line_t* p_Line)
+{
+    #ifdef CONFIG_RAK3172_QUEUE_OVERFLOW_BLOCK
+        if(xQueueSend(p_Device->Internal.MessageQueue, &p_Line, pdMS_TO_TICKS(CONFIG_RAK3172_QUEUE_BLOCK_TIMEOUT)) == pdPASS)
+        {
+            return;
+        }
+    #else
+        if(xQueueSend(p_Device->Internal.MessageQueue, &p_Line, 0) == pdPASS)
+        {
+            return;
+        }
+
+        #ifdef CONFIG_RAK3172_QUEUE_OVERFLOW_DROP_OLDEST
+            RAK3172_Line_t* Oldest;
+
+            if(xQueueReceive(p_Device->Internal.MessageQueue, &Oldest, 0) == pdPASS)
+            {
+                RAK3172_UART_ReleaseLine(*p_Device, Oldest);
+                p_Device->Internal.Stats.MessageDropped++;
+
+                if(xQueueSend(p_Device->Internal.MessageQueue, &p_Line, 0) == pdPASS)
+                {
+                    return;
+                }
+            }
+        #endif
+    #endif
+
+    RAK3172_LOGW(TAG, "Message queue full. Drop line!");
+
+    p_Device->Internal.Stats.MessageDropped++;
+    RAK3172_UART_ReleaseLine(*p_Device, p_Line);
+}
+
+/** @brief          Process a complete line from the module. Events are handled by the event handler and all other lines
+ *                  are passed to the message queue.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Line   Pointer to zero terminated line without line ending
+ *  @param Length   Length of the line
+ */
+static void RAK3172_UART_ProcessLine(RAK3172_t* p_Device, char* p_Line, size_t Length)
+{
+    RAK3172_Line_t* Line;
+
+    RAK3172_LOGD(TAG, "     Response: %s", p_Line);
+
+    if(RAK3172_Events_Process(*p_Device, p_Line, Length))
+    {
+        return;
+    }
+
+    // Any other messages from the module.
+    Line = RAK3172_UART_AllocateLine(p_Device);
+    if(Line == NULL)
+    {
+        RAK3172_LOGW(TAG, "No free line buffer available. Drop line!");
+
+        return;
+    }
+
+    if(Length > CONFIG_RAK3172_UART_LINE_SIZE)
+    {
+        RAK3172_LOGW(TAG, "Line too long. Truncate line!");
+
+        p_Device->Internal.Stats.LinesTruncated++;
+        Length = CONFIG_RAK3172_UART_LINE_SIZE;
+    }
+
+    memcpy(Line->Data, p_Line, Length);
+    Line->Data[Length] = '\0';
+    Line->Length = Length;
+    Line->Timestamp = p_Device->Internal.LineTimestamp;
+
+    RAK3172_UART_PushLine(p_Device, Line);
+}
+
+#ifdef CONFIG_RAK3172_UART_RX_STREAM
+    /** @brief          Line callback for the stream line parser.
+     *  @param p_Arg    Pointer to RAK3172 device object
+     *  @param p_Line   Pointer to zero terminated line without line ending
+     *  @param Length   Length of the line
+     */
+    static void RAK3172_UART_OnLine(void* p_Arg, char* p_Line, size_t Length)
+    {
+        RAK3172_UART_ProcessLine(static_cast<RAK3172_t*>(p_Arg), p_Line, Length);
+    }
+
+    /** @brief          Read all buffered data from the UART driver and pass it to the stream line parser.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Parser Pointer to stream line parser
+     */
+    static void RAK3172_UART_ReadStream(RAK3172_t* p_Device, RAK3172_LineParser_t* p_Parser)
+    {
+        size_t BufferedSize;
+        uint8_t Chunk[RAK3172_UART_CHUNK_SIZE];
+
+        while((uart_get_buffered_data_len(p_Device->UART.Interface, &BufferedSize) == ESP_OK) && (BufferedSize > 0))
+        {
+            int BytesRead;
 
-    RAK3172_LOGD(TAG, "Start RAK3172 event task");
+            BytesRead = uart_read_bytes(p_Device->UART.Interface, Chunk, (BufferedSize < sizeof(Chunk)) ? BufferedSize : sizeof(Chunk), 0);
+            if(BytesRead <= 0)
+            {
+                break;
+            }
+
+            RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_RX, p_Device->Internal.LineTimestamp, Chunk, BytesRead);
+            RAK3172_LineParser_Feed(p_Parser, Chunk, BytesRead);
+        }
 
-    Device = static_cast<RAK3172_t*>(p_Arg);
+        // Collect the lines which were truncated by the parser.
+        p_Device->Internal.Stats.LinesTruncated += p_Parser->Truncated;
+        p_Parser->Truncated = 0;
+    }
+#endif
+
+/** @brief          Handle a single event from the UART driver.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Event  Pointer to UART event
+ *  @param p_Parser Pointer to stream line parser of the device
+ *                  NOTE: Only used in stream mode!
+ */
+static void RAK3172_UART_HandleEvent(RAK3172_t* p_Device, const uart_event_t* p_Event, RAK3172_LineParser_t* p_Parser)
+{
+    // All lines which are processed for this event get the time of the event as receive time.
+    p_Device->Internal.LineTimestamp = RAK3172_Timer_GetMicroseconds();
 
-    while(true)
+    switch(p_Event->type)
     {
-        if(xQueueReceive(Device->Internal.EventQueue, (void*)&Event, 20 / portTICK_PERIOD_MS) == pdPASS)
+        case UART_FIFO_OVF:
+        {
+            ESP_LOGW(TAG, "HW FIFO Overflow");
+
+            p_Device->Internal.Stats.FifoOverflows++;
+            RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_LOST, p_Device->Internal.LineTimestamp, NULL, 0);
+
+            #ifdef CONFIG_RAK3172_UART_RX_STREAM
+                // Data is lost. Process the buffered data and drop the incomplete line until the parser is synchronized
+                // with the next line ending again.
+                RAK3172_UART_ReadStream(p_Device, p_Parser);
+                RAK3172_LineParser_Reset(p_Parser, true);
+            #else
+                uart_flush(p_Device->UART.Interface);
+                RAK3172_UART_FlushLines(*p_Device);
+            #endif
+
+            break;
+        }
+        case UART_BUFFER_FULL:
+        {
+            ESP_LOGW(TAG, "Ring Buffer Full");
+
+            p_Device->Internal.Stats.BufferFull++;
+            RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_LOST, p_Device->Internal.LineTimestamp, NULL, 0);
+
+            #ifdef CONFIG_RAK3172_UART_RX_STREAM
+                RAK3172_UART_ReadStream(p_Device, p_Parser);
+                RAK3172_LineParser_Reset(p_Parser, true);
+            #else
+                uart_flush(p_Device->UART.Interface);
+                RAK3172_UART_FlushLines(*p_Device);
+            #endif
+
+            break;
+        }
+        #ifdef CONFIG_RAK3172_UART_RX_STREAM
+            case UART_DATA:
+            {
+                RAK3172_UART_ReadStream(p_Device, p_Parser);
+
+                break;
+            }
+        #endif
+        #ifdef CONFIG_RAK3172_UART_RX_PATTERN
+        case UART_PATTERN_DET:
         {
             size_t BufferedSize;
             int32_t PatternPos;
 
-            switch(Event.type)
+            uart_get_buffered_data_len(p_Device->UART.Interface, &BufferedSize);
+
+            PatternPos = uart_pattern_pop_pos(p_Device->UART.Interface);
+
+            if(PatternPos == -1)
             {
-                case UART_FIFO_OVF:
-                {
-                    ESP_LOGW(TAG, "HW FIFO Overflow");
+                // The pattern queue has overflowed. The position of the line ending is lost.
+                p_Device->Internal.Stats.PatternMisses++;
+                RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_LOST, p_Device->Internal.LineTimestamp, NULL, 0);
 
-                    uart_flush(Device->UART.Interface);
-                    xQueueReset(Device->Internal.MessageQueue);
+                uart_flush_input(p_Device->UART.Interface);
+                RAK3172_UART_FlushLines(*p_Device);
+            }
+            else
+            {
+                int BytesRead;
+                size_t Length;
+                char* Response;
 
-                    break;
-                }
-                case UART_BUFFER_FULL:
-                {
-                    ESP_LOGW(TAG, "Ring Buffer Full");
+                RAK3172_LOGD(TAG, "     Pattern detected at position %u. Use buffered size: %u", static_cast<unsigned int>(PatternPos), static_cast<unsigned int>(BufferedSize));
 
-                    uart_flush(Device->UART.Interface);
-                    xQueueReset(Device->Internal.MessageQueue);
+                BytesRead = uart_read_bytes(p_Device->UART.Interface, p_Device->Internal.RxBuffer, PatternPos, pdMS_TO_TICKS(RAK3172_UART_READ_TIMEOUT));
+                if(BytesRead == -1)
+                {
+                    RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_LOST, p_Device->Internal.LineTimestamp, NULL, 0);
+                    uart_flush(p_Device->UART.Interface);
+                    RAK3172_UART_FlushLines(*p_Device);
 
                     break;
                 }
-                case UART_PATTERN_DET:
+
+                RAK3172_Capture_Record(*p_Device, RAK_CAPTURE_RX, p_Device->Internal.LineTimestamp, p_Device->Internal.RxBuffer, BytesRead);
+
+                // Remove the line endings from the data in the receive buffer.
+                Response = reinterpret_cast<char*>(p_Device->Internal.RxBuffer);
+                Length = 0;
+                for(int i = 0; i < BytesRead; i++)
                 {
-                    uart_get_buffered_data_len(Device->UART.Interface, &BufferedSize);
+                    char Character;
 
-                    PatternPos = uart_pattern_pop_pos(Device->UART.Interface);
+                    Character = Response[i];
 
-                    if(PatternPos == -1)
+                    if((Character != '\n') && (Character != '\r'))
                     {
-                        uart_flush_input(Device->UART.Interface);
-                        xQueueReset(Device->Internal.MessageQueue);
-                    }
-                    else
-                    {
-                        int BytesRead;
-                        std::string* Response = new std::string();
-
-                        RAK3172_LOGD(TAG, "     Pattern detected at position %u. Use buffered size: %u", static_cast<unsigned int>(PatternPos), static_cast<unsigned int>(BufferedSize));
-
-                        BytesRead = uart_read_bytes(Device->UART.Interface, Device->Internal.RxBuffer, PatternPos, pdMS_TO_TICKS(_RAK3172_UART_Timeout));
-                        if(BytesRead == -1)
-                        {
-                            delete Response;
-                            uart_flush(Device->UART.Interface);
-                            xQueueReset(Device->Internal.MessageQueue);
-
-                            continue;
-                        }
-
-                        // Copy the data from the buffer into the string.
-                        for(uint32_t i = 0; i < BytesRead; i++)
-                        {
-                            char Character;
-
-                            Character = Device->Internal.RxBuffer[i];
-
-                            if((Character != '\n') && (Character != '\r'))
-                            {
-                                *Response += Character;
-                            }
-                        }
-
-                        RAK3172_LOGD(TAG, "     Response: %s", Response->c_str());
-
-                        if(Response->find("Restricted_Wait") != std::string::npos)
-                        {
-                            Device->Internal.isRestricted = true;
-                        }
-                        else
-                        {
-                            Device->Internal.isRestricted = false;
-                        }
-
-                        #ifdef CONFIG_RAK3172_MODE_WITH_LORAWAN
-                            if((Device->Mode == RAK_MODE_LORAWAN) && (Response->find("EVT") != std::string::npos))
-                            {
-                                RAK3172_LOGD(TAG, "Event: %s", Response->c_str());
-
-                                // Join was successful.
-                                if(Response->find("JOINED") != std::string::npos)
-                                {
-                                    RAK3172_LOGD(TAG, " Joined...");
-
-                                    #ifndef CONFIG_RAK3172_USE_RUI3
-                                        Device->Internal.isJoinEvent = true;
-                                    #endif
-
-                                    Device->Internal.isBusy = false;
-                                    Device->LoRaWAN.isJoined = true;
-                                }
-                                // Join failed.
-                                #ifdef CONFIG_RAK3172_USE_RUI3
-                                    else if(Response->find("JOIN_FAILED_RX_TIMEOUT") != std::string::npos)
-                                #else
-                                    else if(Response->find("JOIN FAILED") != std::string::npos)
-                                #endif
-                                {
-                                    RAK3172_LOGD(TAG, " Not joined...");
-                                    RAK3172_LOGD(TAG, "  Attempts left: %u", static_cast<unsigned int>(Device->LoRaWAN.AttemptCounter) - 1);
-
-                                    if(Device->LoRaWAN.AttemptCounter > 0)
-                                    {
-                                        Device->LoRaWAN.AttemptCounter--;
-                                    }
-                                    else
-                                    {
-                                        Device->Internal.isBusy = false;
-                                    }
-
-                                    #ifndef CONFIG_RAK3172_USE_RUI3
-                                        Device->Internal.isBusy = false;
-                                        Device->Internal.isJoinEvent = true;
-                                    #endif
-
-                                    Device->LoRaWAN.isJoined = false;
-                                }
-                                else if(Response->find("TX_DONE") != std::string::npos)
-                                {
-                                    Device->Internal.isBusy = false;
-                                }
-                                // Transmission failed.
-                                #ifdef CONFIG_RAK3172_USE_RUI3
-                                    else if(Response->find("SEND_CONFIRMED_FAILED") != std::string::npos)
-                                #else
-                                    else if(Response->find("SEND CONFIRMED FAILED") != std::string::npos)
-                                #endif
-                                {
-                                    Device->Internal.isBusy = false;
-                                    Device->LoRaWAN.ConfirmError = true;
-                                }
-                                // Transmission was successful.
-                                #ifdef CONFIG_RAK3172_USE_RUI3
-                                    else if(Response->find("SEND_CONFIRMED_OK") != std::string::npos)
-                                #else
-                                    else if(Response->find("SEND CONFIRMED OK") != std::string::npos)
-                                #endif
-                                {
-                                    Device->Internal.isBusy = false;
-                                    Device->LoRaWAN.ConfirmError = false;
-                                }
-                                else if(Response->find("RX") != std::string::npos)
-                                {
-                                    size_t Index;
-                                    std::string Dummy;
-                                    RAK3172_Rx_t* Received = new RAK3172_Rx_t();
-
-                                    // Formats documentation:
-                                    //  FW 1.03     +EVT:RX_1, RSSI -89, SNR 4
-
-                                    // Remove "+EVT:" from the response.
-                                    Response->erase(Response->find("+EVT:"), std::string("+EVT:").length());
-
-                                    // Get the channel number from the "RX_x" part of the response.
-                                    Index = Response->find("RX_");
-                                   if(Index == std::string::npos)
-                                   {
-                                       delete Response;
-                                       break;
-                                    }
-
-                                    Received->isMulticast = false;
-                                    if(Response->find("MULTICAST") != std::string::npos)
-                                    {
-                                        Received->isMulticast = true;
-                                    }
-
-                                    if(Response->at(Index + 3) == '1')
-                                    {
-                                        Received->Group = RAK_RX_GROUP_1;
-                                    }
-                                    else if(Response->at(Index + 3) == '2')
-                                    {
-                                        Received->Group = RAK_RX_GROUP_2;
-                                    }
-                                    else if(Response->at(Index + 3) == 'B')
-                                    {
-                                        Received->Group = RAK_RX_GROUP_B;
-                                    }
-                                    else if(Response->at(Index + 3) == 'C')
-                                    {
-                                        Received->Group = RAK_RX_GROUP_C;
-                                    }
-
-                                    // Remove the "RX_x" from the response.
-                                    Response->erase(0, 4);
-
-                                    // Get the RSSI value.
-                                    #ifdef CONFIG_RAK3172_USE_RUI3
-                                        size_t ColonPos = Response->find(":");
-                                        if(ColonPos == std::string::npos)
-                                        {
-                                            delete Received;
-                                            delete Response;
-                                            break;
-                                        }
-                                        Dummy = Response->substr(0, ColonPos);
-                                        Response->erase(0, std::string(Dummy + ":").length());
-                                    #else
-                                        size_t CommaPos = Response->find(",");
-                                        if(CommaPos == std::string::npos)
-                                        {
-                                            delete Received;
-                                            delete Response;
-                                            break;
-                                        }
-                                        Dummy = Response->substr(std::string("RSSI").length() + 1, CommaPos);
-                                        Response->erase(0, std::string(Dummy).length() + 2);
-                                    #endif
-                                    Received->RSSI = std::stoi(Dummy);
-
-                                    // Get the SNR value.
-                                    #ifdef CONFIG_RAK3172_USE_RUI3
-                                        Dummy = Response->substr(0, Response->find(":"));
-                                        Response->erase(0, std::string(Dummy + ":").length());
-                                    #else
-                                        Dummy = Response->substr(std::string("SNR").length() + 1, Response->find(","));
-                                    #endif
-                                    Received->SNR = std::stoi(Dummy);
-
-                                    #ifndef CONFIG_RAK3172_USE_RUI3
-                                        // The payload is stored in the next line.
-                                        char Data;
-                                        int Bytes;
-
-                                        Response->clear();
-                                        do
-                                        {
-                                            Bytes = uart_read_bytes(Device->UART.Interface, &Data, 1, pdMS_TO_TICKS(_RAK3172_UART_Timeout));
-                                            if((Bytes != 0) && (Data != '\r') && (Data != '\n'))
-                                            {
-                                                *Response += Data;
-                                            }
-                                        } while(Bytes != 0);
-
-                                        RAK3172_LOGD(TAG, "Next line: %s", Response->c_str());
-
-                                        // Remove all "+EVT" strings.
-                                        size_t EvtPos = Response->find("+EVT");
-                                        if(EvtPos != std::string::npos)
-                                        {
-                                            Response->erase(EvtPos, std::string("+EVT").length());
-                                        }
-                                    #endif
-
-                                    // Remove the "UNICAST" or the "MULCAST" from the message.
-                                    Response->erase(0, Response->find(":") + 1);
-
-                                    // Get the communication port.
-                                    Dummy = Response->substr(0, Response->find(":"));
-                                    Response->erase(Response->find(Dummy), std::string(Dummy + ":").length());
-                                    Received->Port = std::stoi(Dummy);
-
-                                    // Get the payload.
-                                    Received->Payload = *Response;
-
-                                    RAK3172_LOGD(TAG, "RSSI: %i", Received->RSSI);
-                                    RAK3172_LOGD(TAG, "SNR: %i", Received->SNR);
-                                    RAK3172_LOGD(TAG, "Port: %u", Received->Port);
-                                    RAK3172_LOGD(TAG, "Channel: %u", Received->Group);
-                                    RAK3172_LOGD(TAG, "Payload: %s", Received->Payload.c_str());
-                                    RAK3172_LOGD(TAG, "Multicast: %u", Received->isMulticast);
-
-                                    xQueueSend(Device->Internal.ReceiveQueue, &Received, 0);
-                                }
-
-                                delete Response;
-                            }
-                        #endif
-                        #ifdef CONFIG_RAK3172_MODE_WITH_P2P
-                            if((Device->Mode == RAK_MODE_P2P) && (Response->find("EVT") != std::string::npos))
-                            {
-                                RAK3172_LOGD(TAG, "Event: %s", Response->c_str());
-
-                                if(Response->find("+EVT:RXP2P RECEIVE TIMEOUT") != std::string::npos)
-                                {
-                                    Device->P2P.isRxTimeout = true;
-                                }
-                                else if(Response->find("RX") != std::string::npos)
-                                {
-                                    std::string Dummy;
-                                    RAK3172_Rx_t* Received = new RAK3172_Rx_t();
-
-                                    // Remove "+EVT:RXP2P:" from the response.
-                                    size_t EvtPos = Response->find("+EVT:");
-                                    if(EvtPos == std::string::npos)
-                                    {
-                                        delete Received;
-                                        delete Response;
-                                        break;
-                                    }
-                                    Response->erase(EvtPos, std::string("+EVT:").length() + 6);
-
-                                    // Get the RSSI value.
-                                    #ifdef CONFIG_RAK3172_USE_RUI3
-                                        Dummy = Response->substr(0, Response->find(":"));
-                                        Response->erase(0, std::string(Dummy + ":").length());
-                                    #else
-                                        Dummy = Response->substr(std::string("RSSI").length() + 1, Response->find(","));
-                                        Response->erase(0, std::string(Dummy + ":").length() + 1);
-                                    #endif
-                                    Received->RSSI = std::stoi(Dummy);
-
-                                    // Get the SNR value.
-                                    #ifdef CONFIG_RAK3172_USE_RUI3
-                                        Dummy = Response->substr(0, Response->find(":"));
-                                        Response->erase(0, std::string(Dummy + ":").length());
-                                    #else
-                                        Dummy = Response->substr(std::string("SNR").length() + 1, Response->find(","));
-                                    #endif
-                                    Received->SNR = std::stoi(Dummy);
-
-                                    // Get the payload.
-                                    Received->Payload = *Response;
-
-                                    RAK3172_LOGD(TAG, "RSSI: %i", Received->RSSI);
-                                    RAK3172_LOGD(TAG, "SNR: %i", Received->SNR);
-                                    RAK3172_LOGD(TAG, "Payload: %s", Received->Payload.c_str());
-
-                                    xQueueSend(Device->Internal.ReceiveQueue, &Received, 0);
-                                }
-
-                                delete Response;
-                            }
-                            // Any other messages from the module.
-                            else
-                        #endif
-                            {
-                                xQueueSend(Device->Internal.MessageQueue, &Response, 0);
-                            }
+                        Response[Length++] = Character;
                     }
+                }
+                Response[Length] = '\0';
 
-                    break;
+                RAK3172_UART_ProcessLine(p_Device, Response, Length);
+            }
+
+            break;
+        }
+        #endif
+        default:
+        {
+            break;
+        }
+    }
+}
+
+#ifdef CONFIG_RAK3172_TASK_SHARED
+    /** @brief          Shared UART receive task. The task waits for the event queues of all registered devices.
+     *  @param p_Arg    Pointer to task arguments
+     */
+    static void RAK3172_UART_SharedTask(void* p_Arg)
+    {
+        RAK3172_LOGD(TAG, "Start shared RAK3172 event task");
+
+        while(true)
+        {
+            QueueSetMemberHandle_t Member;
+
+            Member = xQueueSelectFromSet(_RAK3172_UART_QueueSet, portMAX_DELAY);
+            if(Member == NULL)
+            {
+                continue;
+            }
+
+            // The lock prevents the removal of the device while the event is processed.
+            xSemaphoreTake(_RAK3172_UART_Lock, portMAX_DELAY);
+
+            for(uint8_t i = 0; i < CONFIG_RAK3172_TASK_MAX_DEVICES; i++)
+            {
+                uart_event_t Event;
+                RAK3172_t* Device;
+
+                Device = _RAK3172_UART_Devices[i];
+                if((Device == NULL) || (Device->Internal.EventQueue != Member))
+                {
+                    continue;
                 }
-                default:
+
+                // Queues which are removed from the set can leave stale entries in the set. So don´t block here.
+                if(xQueueReceive(Member, &Event, 0) == pdPASS)
                 {
-                    break;
+                    #ifdef CONFIG_RAK3172_UART_RX_STREAM
+                        RAK3172_UART_HandleEvent(Device, &Event, &_RAK3172_UART_Parsers[i]);
+                    #else
+                        RAK3172_UART_HandleEvent(Device, &Event, NULL);
+                    #endif
                 }
+
+                break;
+            }
+
+            xSemaphoreGive(_RAK3172_UART_Lock);
+        }
+    }
+
+    /** @brief          Add a device to the shared event task. The task and the queue set are created with the first device.
+     *  @param p_Device RAK3172 device object
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_NO_MEM when the task, the queue set or the mutex cannot be created
+     *                  RAK3172_ERR_INVALID_STATE when no free device slot is available
+     */
+    static RAK3172_Error_t RAK3172_UART_Register(RAK3172_t& p_Device)
+    {
+        int8_t Slot;
+        RAK3172_Error_t Error;
+
+        // The first initialization creates the shared objects. They are never deleted, because other devices can be
+        // registered at any time.
+        if(_RAK3172_UART_Lock == NULL)
+        {
+            _RAK3172_UART_Lock = xSemaphoreCreateMutex();
+            if(_RAK3172_UART_Lock == NULL)
+            {
+                return RAK3172_ERR_NO_MEM;
+            }
+        }
+
+        if(_RAK3172_UART_QueueSet == NULL)
+        {
+            _RAK3172_UART_QueueSet = xQueueCreateSet(CONFIG_RAK3172_TASK_MAX_DEVICES * CONFIG_RAK3172_UART_QUEUE_LENGTH);
+            if(_RAK3172_UART_QueueSet == NULL)
+            {
+                return RAK3172_ERR_NO_MEM;
+            }
+        }
+
+        if(_RAK3172_UART_SharedHandle == NULL)
+        {
+            #ifdef CONFIG_RAK3172_TASK_CORE_USE_AFFINITY
+                xTaskCreatePinnedToCore(RAK3172_UART_SharedTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, NULL, CONFIG_RAK3172_TASK_PRIO, &_RAK3172_UART_SharedHandle, CONFIG_RAK3172_TASK_CORE);
+            #else
+                xTaskCreate(RAK3172_UART_SharedTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, NULL, CONFIG_RAK3172_TASK_PRIO, &_RAK3172_UART_SharedHandle);
+            #endif
+
+            if(_RAK3172_UART_SharedHandle == NULL)
+            {
+                return RAK3172_ERR_NO_MEM;
+            }
+        }
+
+        xSemaphoreTake(_RAK3172_UART_Lock, portMAX_DELAY);
+
+        Slot = -1;
+        for(uint8_t i = 0; i < CONFIG_RAK3172_TASK_MAX_DEVICES; i++)
+        {
+            if(_RAK3172_UART_Devices[i] == &p_Device)
+            {
+                Slot = i;
+
+                break;
+            }
+            else if((_RAK3172_UART_Devices[i] == NULL) && (Slot == -1))
+            {
+                Slot = i;
             }
         }
+
+        if(Slot == -1)
+        {
+            RAK3172_LOGE(TAG, "No free slot in the shared event task. Increase CONFIG_RAK3172_TASK_MAX_DEVICES!");
+
+            Error = RAK3172_ERR_INVALID_STATE;
+            goto RAK3172_UART_Register_Exit;
+        }
+
+        // Only empty queues can be added to a queue set.
+        xQueueReset(p_Device.Internal.EventQueue);
+        if(xQueueAddToSet(p_Device.Internal.EventQueue, _RAK3172_UART_QueueSet) != pdPASS)
+        {
+            Error = RAK3172_ERR_INVALID_STATE;
+            goto RAK3172_UART_Register_Exit;
+        }
+
+        #ifdef CONFIG_RAK3172_UART_RX_STREAM
+            // The receive buffer is used as line assembly buffer.
+            RAK3172_LineParser_Init(&_RAK3172_UART_Parsers[Slot], reinterpret_cast<char*>(p_Device.Internal.RxBuffer), CONFIG_RAK3172_UART_BUFFER_SIZE + 1, RAK3172_UART_OnLine, &p_Device);
+        #endif
+
+        _RAK3172_UART_Devices[Slot] = &p_Device;
+
+        RAK3172_LOGD(TAG, "Use slot %i of the shared event task", Slot);
+
+        Error = RAK3172_ERR_OK;
+
+    RAK3172_UART_Register_Exit:
+        xSemaphoreGive(_RAK3172_UART_Lock);
+
+        return Error;
     }
+
+    /** @brief          Remove a device from the shared event task.
+     *  @param p_Device RAK3172 device object
+     */
+    static void RAK3172_UART_Unregister(RAK3172_t& p_Device)
+    {
+        if(_RAK3172_UART_Lock == NULL)
+        {
+            return;
+        }
+
+        xSemaphoreTake(_RAK3172_UART_Lock, portMAX_DELAY);
+
+        for(uint8_t i = 0; i < CONFIG_RAK3172_TASK_MAX_DEVICES; i++)
+        {
+            if(_RAK3172_UART_Devices[i] == &p_Device)
+            {
+                // Only empty queues can be removed from a queue set.
+                xQueueReset(p_Device.Internal.EventQueue);
+                xQueueRemoveFromSet(p_Device.Internal.EventQueue, _RAK3172_UART_QueueSet);
+                _RAK3172_UART_Devices[i] = NULL;
+
+                break;
+            }
+        }
+
+        xSemaphoreGive(_RAK3172_UART_Lock);
+    }
+#else
+    /** @brief          UART receive task.
+     *  @param p_Arg    Pointer to task arguments
+     */
+    static void RAK3172_UART_EventTask(void* p_Arg)
+    {
+        uart_event_t Event;
+        RAK3172_t* Device;
+        RAK3172_LineParser_t* Parser;
+
+        RAK3172_LOGD(TAG, "Start RAK3172 event task");
+
+        Device = static_cast<RAK3172_t*>(p_Arg);
+        Parser = NULL;
+
+        #ifdef CONFIG_RAK3172_UART_RX_STREAM
+            RAK3172_LineParser_t StreamParser;
+
+            // The receive buffer is used as line assembly buffer.
+            RAK3172_LineParser_Init(&StreamParser, reinterpret_cast<char*>(Device->Internal.RxBuffer), CONFIG_RAK3172_UART_BUFFER_SIZE + 1, RAK3172_UART_OnLine, Device);
+            Parser = &StreamParser;
+        #endif
+
+        while(true)
+        {
+            if(xQueueReceive(Device->Internal.EventQueue, (void*)&Event, 20 / portTICK_PERIOD_MS) == pdPASS)
+            {
+                RAK3172_UART_HandleEvent(Device, &Event, Parser);
+            }
+        }
+    }
+#endif
+
+/** @brief          Stop the processing of UART events for a device.
+ *  @param p_Device RAK3172 device object
+ */
+static void RAK3172_UART_StopEvents(RAK3172_t& p_Device)
+{
+    #ifdef CONFIG_RAK3172_TASK_SHARED
+        RAK3172_UART_Unregister(p_Device);
+    #else
+        if(p_Device.Internal.Handle != NULL)
+        {
+            vTaskSuspend(p_Device.Internal.Handle);
+            vTaskDelete(p_Device.Internal.Handle);
+            p_Device.Internal.Handle = NULL;
+        }
+    #endif
 }
 
 RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
 {
     uint8_t Flags;
+    bool isPoolCreated;
+    bool isEventGroupCreated;
+    uart_config_t Config;
     RAK3172_Error_t Error;
 
     if(p_Device.UART.Tx == p_Device.UART.Rx)
@@ -436,6 +613,18 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
     RAK3172_LOGI(TAG, "     Buffer size: %u", CONFIG_RAK3172_UART_BUFFER_SIZE);
     RAK3172_LOGI(TAG, "     Stack size: %u", CONFIG_RAK3172_TASK_STACK_SIZE);
     RAK3172_LOGI(TAG, "     Queue length: %u", CONFIG_RAK3172_UART_QUEUE_LENGTH);
+    RAK3172_LOGI(TAG, "     Line size: %u", CONFIG_RAK3172_UART_LINE_SIZE);
+    RAK3172_LOGI(TAG, "     Line pool size: %u", CONFIG_RAK3172_UART_LINE_POOL_SIZE);
+    #ifdef CONFIG_RAK3172_UART_RX_STREAM
+        RAK3172_LOGI(TAG, "     Receive mode: Stream");
+    #else
+        RAK3172_LOGI(TAG, "     Receive mode: Pattern");
+    #endif
+    #ifdef CONFIG_RAK3172_TASK_SHARED
+        RAK3172_LOGI(TAG, "     Event task: Shared (%u devices)", CONFIG_RAK3172_TASK_MAX_DEVICES);
+    #else
+        RAK3172_LOGI(TAG, "     Event task: Device");
+    #endif
     RAK3172_LOGI(TAG, "     Rx: %u", p_Device.UART.Rx);
     RAK3172_LOGI(TAG, "     Tx: %u", p_Device.UART.Tx);
     RAK3172_LOGI(TAG, "     Baudrate: %u", p_Device.UART.Baudrate);
@@ -446,11 +635,14 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
         return RAK3172_ERR_INVALID_STATE;
     }
 
-    _RAK3172_UART_Config.baud_rate = p_Device.UART.Baudrate;
-    if(uart_param_config(p_Device.UART.Interface, &_RAK3172_UART_Config) ||
-       uart_set_pin(p_Device.UART.Interface, p_Device.UART.Tx, p_Device.UART.Rx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) ||
-       uart_enable_pattern_det_baud_intr(p_Device.UART.Interface, '\n', 1, 1, 0, 0) ||
-       uart_pattern_queue_reset(p_Device.UART.Interface, CONFIG_RAK3172_UART_QUEUE_LENGTH)
+    Config = _RAK3172_UART_Config;
+    Config.baud_rate = p_Device.UART.Baudrate;
+    if(uart_param_config(p_Device.UART.Interface, &Config) ||
+       uart_set_pin(p_Device.UART.Interface, p_Device.UART.Tx, p_Device.UART.Rx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE)
+      #ifdef CONFIG_RAK3172_UART_RX_PATTERN
+       || uart_enable_pattern_det_baud_intr(p_Device.UART.Interface, '\n', 1, 1, 0, 0)
+       || uart_pattern_queue_reset(p_Device.UART.Interface, CONFIG_RAK3172_UART_QUEUE_LENGTH)
+      #endif
       )
     {
         uart_driver_delete(p_Device.UART.Interface);
@@ -458,7 +650,7 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
         return RAK3172_ERR_INVALID_STATE;
     }
 
-    p_Device.Internal.MessageQueue = xQueueCreate(CONFIG_RAK3172_UART_QUEUE_LENGTH, sizeof(std::string*));
+    p_Device.Internal.MessageQueue = xQueueCreate(CONFIG_RAK3172_UART_QUEUE_LENGTH, sizeof(RAK3172_Line_t*));
     if(p_Device.Internal.MessageQueue == NULL)
     {
         Error = RAK3172_ERR_NO_MEM;
@@ -466,7 +658,7 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
         goto RAK3172_UART_Init_Error_1;
     }
 
-    p_Device.Internal.ReceiveQueue = xQueueCreate(8, sizeof(RAK3172_Rx_t*));
+    p_Device.Internal.ReceiveQueue = xQueueCreate(8, sizeof(RAK3172_RxFrame_t));
     if(p_Device.Internal.ReceiveQueue == NULL)
     { 
         Error = RAK3172_ERR_NO_MEM;
@@ -474,7 +666,8 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
         goto RAK3172_UART_Init_Error_2;
     }
 
-    p_Device.Internal.RxBuffer = (uint8_t*)malloc(CONFIG_RAK3172_UART_BUFFER_SIZE);
+    // Reserve one additional byte for the string termination.
+    p_Device.Internal.RxBuffer = (uint8_t*)malloc(CONFIG_RAK3172_UART_BUFFER_SIZE + 1);
     if(p_Device.Internal.RxBuffer == NULL)
     {
         Error = RAK3172_ERR_NO_MEM;
@@ -482,47 +675,124 @@ RAK3172_Error_t RAK3172_UART_Init(RAK3172_t& p_Device)
         goto RAK3172_UART_Init_Error_3;
     }
 
-    #ifdef CONFIG_RAK3172_TASK_CORE_AFFINITY
-        xTaskCreatePinnedToCore(RAK3172_UART_EventTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, &p_Device, CONFIG_RAK3172_TASK_PRIO, &p_Device.Internal.Handle, CONFIG_RAK3172_TASK_CORE);
-    #else
-        xTaskCreate(RAK3172_UART_EventTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, &p_Device, CONFIG_RAK3172_TASK_PRIO, &p_Device.Internal.Handle);
-    #endif
+    // The line pool is allocated only once and reused when the interface is initialized again (i. e. for a new baudrate).
+    // Only the objects which are created by this call are released when the initialization fails.
+    isPoolCreated = false;
+    if(p_Device.Internal.LinePool == NULL)
+    {
+        p_Device.Internal.LinePool = (RAK3172_Line_t*)malloc(sizeof(RAK3172_Line_t) * CONFIG_RAK3172_UART_LINE_POOL_SIZE);
+        if(p_Device.Internal.LinePool == NULL)
+        {
+            Error = RAK3172_ERR_NO_MEM;
+
+            goto RAK3172_UART_Init_Error_4;
+        }
+
+        isPoolCreated = true;
+
+        p_Device.Internal.LineFreeQueue = xQueueCreate(CONFIG_RAK3172_UART_LINE_POOL_SIZE, sizeof(RAK3172_Line_t*));
+        if(p_Device.Internal.LineFreeQueue == NULL)
+        {
+            Error = RAK3172_ERR_NO_MEM;
+
+            goto RAK3172_UART_Init_Error_5;
+        }
+    }
 
-    if(p_Device.Internal.Handle == NULL)
+    // The event group is reused when the interface is initialized again, because other tasks can wait for it.
+    isEventGroupCreated = false;
+    if(p_Device.Internal.EventGroup == NULL)
     {
-        Error = RAK3172_ERR_NO_MEM;
+        p_Device.Internal.EventGroup = xEventGroupCreate();
+        if(p_Device.Internal.EventGroup == NULL)
+        {
+            Error = RAK3172_ERR_NO_MEM;
+
+            goto RAK3172_UART_Init_Error_6;
+        }
+
+        isEventGroupCreated = true;
+    }
+
+    xQueueReset(p_Device.Internal.LineFreeQueue);
+    for(uint8_t i = 0; i < CONFIG_RAK3172_UART_LINE_POOL_SIZE; i++)
+    {
+        RAK3172_Line_t* Line;
 
-        goto RAK3172_UART_Init_Error_4;
+        Line = &p_Device.Internal.LinePool[i];
+        xQueueSend(p_Device.Internal.LineFreeQueue, &Line, 0);
     }
 
+    #ifdef CONFIG_RAK3172_TASK_SHARED
+        Error = RAK3172_UART_Register(p_Device);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_UART_Init_Error_7;
+        }
+    #else
+        #ifdef CONFIG_RAK3172_TASK_CORE_USE_AFFINITY
+            xTaskCreatePinnedToCore(RAK3172_UART_EventTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, &p_Device, CONFIG_RAK3172_TASK_PRIO, &p_Device.Internal.Handle, CONFIG_RAK3172_TASK_CORE);
+        #else
+            xTaskCreate(RAK3172_UART_EventTask, "RAK3172-Event", CONFIG_RAK3172_TASK_STACK_SIZE, &p_Device, CONFIG_RAK3172_TASK_PRIO, &p_Device.Internal.Handle);
+        #endif
+
+        if(p_Device.Internal.Handle == NULL)
+        {
+            Error = RAK3172_ERR_NO_MEM;
+
+            goto RAK3172_UART_Init_Error_7;
+        }
+    #endif
+
     if(uart_flush(p_Device.UART.Interface))
     {
         Error = RAK3172_ERR_INVALID_STATE;
 
-        goto RAK3172_UART_Init_Error_4;
+        goto RAK3172_UART_Init_Error_7;
     }
 
-    xQueueReset(p_Device.Internal.MessageQueue);
+    RAK3172_UART_FlushLines(p_Device);
+    p_Device.Internal.isRxPending = false;
     p_Device.Internal.isInitialized = true;
 
     return RAK3172_ERR_OK;
 
+RAK3172_UART_Init_Error_7:
+    RAK3172_UART_StopEvents(p_Device);
+
+RAK3172_UART_Init_Error_6:
+    // The persistent objects of a previous initialization are released by RAK3172_Deinit.
+    if(isEventGroupCreated)
+    {
+        vEventGroupDelete(p_Device.Internal.EventGroup);
+        p_Device.Internal.EventGroup = NULL;
+    }
+
+RAK3172_UART_Init_Error_5:
+    if(isPoolCreated && (p_Device.Internal.LineFreeQueue != NULL))
+    {
+        vQueueDelete(p_Device.Internal.LineFreeQueue);
+        p_Device.Internal.LineFreeQueue = NULL;
+    }
+
 RAK3172_UART_Init_Error_4:
-    if(p_Device.Internal.Handle != NULL)
+    if(isPoolCreated)
     {
-        vTaskSuspend(p_Device.Internal.Handle);
-        vTaskDelete(p_Device.Internal.Handle);
-        p_Device.Internal.Handle = NULL;
+        free(p_Device.Internal.LinePool);
+        p_Device.Internal.LinePool = NULL;
     }
 
 RAK3172_UART_Init_Error_3:
     free(p_Device.Internal.RxBuffer);
+    p_Device.Internal.RxBuffer = NULL;
 
 RAK3172_UART_Init_Error_2:
     vQueueDelete(p_Device.Internal.ReceiveQueue);
+    p_Device.Internal.ReceiveQueue = NULL;
 
 RAK3172_UART_Init_Error_1:
     vQueueDelete(p_Device.Internal.MessageQueue);
+    p_Device.Internal.MessageQueue = NULL;
 
     uart_driver_delete(p_Device.UART.Interface);
 
@@ -533,9 +803,14 @@ RAK3172_UART_Init_Error_1:
 
 void RAK3172_UART_Deinit(RAK3172_t& p_Device)
 {
+    // Stop the event processing before the event queue is deleted by the UART driver.
+    RAK3172_UART_StopEvents(p_Device);
+
     if(uart_is_driver_installed(p_Device.UART.Interface))
     {
-        uart_disable_pattern_det_intr(p_Device.UART.Interface);
+        #ifdef CONFIG_RAK3172_UART_RX_PATTERN
+            uart_disable_pattern_det_intr(p_Device.UART.Interface);
+        #endif
         uart_driver_delete(p_Device.UART.Interface);
     }
 
@@ -545,18 +820,21 @@ void RAK3172_UART_Deinit(RAK3172_t& p_Device)
 
 RAK3172_Error_t RAK3172_UART_SetBaudrate(RAK3172_t& p_Device, RAK3172_Baud_t Baudrate)
 {
+    RAK3172_Baud_t Previous;
+
     // Deinitialize the UART interface.
+    RAK3172_UART_StopEvents(p_Device);
     if(uart_driver_delete(p_Device.UART.Interface))
     {
         return RAK3172_ERR_INVALID_STATE;
     }
 
     // Initialize the interface with the new baudrate. Do a rollback if something is going wrong.
-    _RAK3172_UART_Config.baud_rate = Baudrate;
+    Previous = p_Device.UART.Baudrate;
+    p_Device.UART.Baudrate = Baudrate;
     if(RAK3172_UART_Init(p_Device) != RAK3172_ERR_OK)
     {
-        const uint32_t Previous = p_Device.UART.Baudrate;
-        _RAK3172_UART_Config.baud_rate = Previous;
+        p_Device.UART.Baudrate = Previous;
         if(RAK3172_UART_Init(p_Device) != RAK3172_ERR_OK)
         {
             RAK3172_LOGE(TAG, "Failed to rollback to previous baudrate %u", static_cast<unsigned int>(Previous));
@@ -565,12 +843,60 @@ RAK3172_Error_t RAK3172_UART_SetBaudrate(RAK3172_t& p_Device, RAK3172_Baud_t Bau
         return RAK3172_ERR_FAIL;
     }
 
-    p_Device.UART.Baudrate = Baudrate;
-
     return RAK3172_ERR_OK;
 }
 
-int RAK3172_UART_WriteBytes(RAK3172_t& p_Device, const void* p_Buffer, size_t Length)
+void RAK3172_UART_SuspendEvents(RAK3172_t& p_Device)
+{
+    #ifdef CONFIG_RAK3172_TASK_SHARED
+        RAK3172_UART_Unregister(p_Device);
+    #else
+        if(p_Device.Internal.Handle != NULL)
+        {
+            vTaskSuspend(p_Device.Internal.Handle);
+        }
+    #endif
+}
+
+RAK3172_Error_t RAK3172_UART_ResumeEvents(RAK3172_t& p_Device)
 {
+    #ifdef CONFIG_RAK3172_TASK_SHARED
+        return RAK3172_UART_Register(p_Device);
+    #else
+        if(p_Device.Internal.Handle == NULL)
+        {
+            return RAK3172_ERR_INVALID_STATE;
+        }
+
+        vTaskResume(p_Device.Internal.Handle);
+
+        return RAK3172_ERR_OK;
+    #endif
+}
+
+int RAK3172_UART_WriteBytes(const RAK3172_t& p_Device, const void* p_Buffer, size_t Length)
+{
+    RAK3172_Capture_Record(p_Device, RAK_CAPTURE_TX, RAK3172_Timer_GetMicroseconds(), p_Buffer, Length);
+
     return uart_write_bytes(p_Device.UART.Interface, p_Buffer, Length);
+}
+
+void RAK3172_UART_ReleaseLine(const RAK3172_t& p_Device, RAK3172_Line_t* p_Line)
+{
+    if(p_Line == NULL)
+    {
+        return;
+    }
+
+    xQueueSend(p_Device.Internal.LineFreeQueue, &p_Line, 0);
+}
+
+void RAK3172_UART_FlushLines(const RAK3172_t& p_Device)
+{
+    RAK3172_Line_t* Line;
+
+    while(xQueueReceive(p_Device.Internal.MessageQueue, &Line, 0) == pdPASS)
+    {
+        RAK3172_UART_ReleaseLine(p_Device, Line);
+    }
 }
\ No newline at end of file
@@ -42,12 +42,37 @@ void RAK3172_UART_Deinit(RAK3172_t& p_Device);
  */
 RAK3172_Error_t RAK3172_UART_SetBaudrate(RAK3172_t& p_Device, RAK3172_Baud_t Baudrate);
 
+/** @brief          Stop the processing of UART events for a device, i. e. to access the UART directly.
+ *                  NOTE: Only the given device is affected when the shared event task is used.
+ *  @param p_Device RAK3172 device object
+ */
+void RAK3172_UART_SuspendEvents(RAK3172_t& p_Device);
+
+/** @brief          Continue the processing of UART events for a device.
+ *  @param p_Device RAK3172 device object
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_STATE when the device isn´t serviced by an event task
+ */
+RAK3172_Error_t RAK3172_UART_ResumeEvents(RAK3172_t& p_Device);
+
 /** @brief          Transmit bytes via UART.
+ *                  NOTE: The bytes are added to the UART capture.
  *  @param p_Device RAK3172 device object
  *  @param p_Buffer Pointer to data buffer
  *  @param Length   Length of data buffer
  *  @return         Number of bytes written or -1 when error
  */
-int RAK3172_UART_WriteBytes(RAK3172_t& p_Device, const void* p_Buffer, size_t Length);
+int RAK3172_UART_WriteBytes(const RAK3172_t& p_Device, const void* p_Buffer, size_t Length);
+
+/** @brief          Return a line received from the message queue back to the line pool.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Line   Pointer to line object
+ */
+void RAK3172_UART_ReleaseLine(const RAK3172_t& p_Device, RAK3172_Line_t* p_Line);
+
+/** @brief          Drop all lines from the message queue and return them back to the line pool.
+ *  @param p_Device RAK3172 device object
+ */
+void RAK3172_UART_FlushLines(const RAK3172_t& p_Device);
 
 #endif /* RAK3172_UART_H_ */
\ No newline at end of file
@@ -17,15 +17,72 @@
  * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
  */
 
+#include <string.h>
+
 #include "rak3172.h"
 
+#include "rak3172_trace.h"
+#include "rak3172_timeout.h"
+
+#include "../Parser/rak3172_number.h"
+
+#include "../Arch/UART/rak3172_uart.h"
+#include "../Arch/Timer/rak3172_timer.h"
 #include "../Arch/Logging/rak3172_logging.h"
 
 static const char* TAG = "RAK3172";
 
-RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, std::string Command, std::string* const p_Value, std::string* const p_Status)
+/** @brief          Check if a line is the trailing status line of a command.
+ *  @param p_Line   Pointer to line object
+ *  @return         #true when the line is a status line
+ */
+static bool RAK3172_Commands_isStatus(const RAK3172_Line_t* p_Line)
+{
+    return (strcmp(p_Line->Data, "OK") == 0) || (strncmp(p_Line->Data, "AT_", 3) == 0) || (strstr(p_Line->Data, "ERROR") != NULL) ||
+           (strstr(p_Line->Data, "Command not found") != NULL);
+}
+
+/** @brief          Convert the status line of a command into an error code.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Line   Pointer to status line
+ *  @return         RAK3172_ERR_OK when the status is "OK"
+ */
+static RAK3172_Error_t RAK3172_Commands_GetStatus(const RAK3172_t& p_Device, const RAK3172_Line_t* p_Line)
+{
+    if(p_Device.Internal.isRestricted)
+    {
+        return RAK3172_ERR_RESTRICTED;
+    }
+
+    // Transmission is without error when 'OK' as status code and when no event data are received.
+    if(strstr(p_Line->Data, "OK") == NULL)
+    {
+        if(strstr(p_Line->Data, "Command not found") != NULL)
+        {
+            return RAK3172_ERR_COMMAND_NOT_FOUND;
+        }
+
+        return RAK3172_ERR_FAIL;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+/** @brief              Transmit an AT command and receive the response.
+ *  @param p_Device     RAK3172 device object
+ *  @param Command      RAK3172 command without line ending
+ *  @param isTerminated #true when the line ending is stored behind the command
+ *  @param p_Value      (Optional) Pointer to returned value
+ *  @param p_Status     (Optional) Pointer to status string
+ *  @return             RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_Commands_Exchange(const RAK3172_t& p_Device, std::string_view Command, bool isTerminated, std::string* const p_Value,
+                                                 std::string* const p_Status)
 {
-    std::string* Response = NULL;
+    int64_t Start;
+    TickType_t Timeout;
+    RAK3172_TimeoutClass_t Class;
+    RAK3172_Line_t* Response = NULL;
     RAK3172_Error_t Error;
 
     if(p_Device.Internal.isBusy)
@@ -39,83 +96,398 @@ RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, std::string Comma
         return RAK3172_ERR_INVALID_STATE;
     }
 
-    Error = RAK3172_ERR_OK;
+    Class = RAK3172_Timeout_GetClass(Command);
+    Timeout = RAK3172_Timeout_GetTicks(p_Device, Class, Command.size() + 2);
 
     // Clear the queue and drop all items.
-    xQueueReset(p_Device.Internal.MessageQueue);
+    RAK3172_UART_FlushLines(p_Device);
 
     // Transmit the command.
-    RAK3172_LOGD(TAG, "Transmit command: %s", Command.c_str());
-    uart_write_bytes(p_Device.UART.Interface, static_cast<const char*>(Command.c_str()), Command.length());
-    uart_write_bytes(p_Device.UART.Interface, "\r\n", 2);
+    RAK3172_LOGD(TAG, "Transmit command: %.*s", static_cast<int>(Command.size()), Command.data());
+    if(isTerminated)
+    {
+        RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size() + 2);
+    }
+    else
+    {
+        RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size());
+        RAK3172_UART_WriteBytes(p_Device, "\r\n", 2);
+    }
+    Start = RAK3172_Timer_GetMicroseconds();
+    RAK3172_Trace_Begin(p_Device, Command, Start);
 
     // Copy the value if needed.
     if(p_Value != NULL)
     {
-        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
+        const char* Value;
+
+        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
         {
+            RAK3172_Timeout_Record(p_Device, Class, Start, true);
+            RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
+
             return RAK3172_ERR_TIMEOUT;
         }
 
+        RAK3172_Trace_Response(p_Device, Response);
+        Value = Response->Data;
+
         #ifdef CONFIG_RAK3172_USE_RUI3
             // Remove the command from the response.
-            size_t Index;
+            const char* Index;
 
-            Index = Response->find("=");
-            *Response = Response->substr(Index + 1);
+            Index = strchr(Response->Data, '=');
+            if(Index != NULL)
+            {
+                Value = Index + 1;
+            }
         #endif
 
-        *p_Value = *Response;
-        delete Response;
+        p_Value->assign(Value);
+        RAK3172_UART_ReleaseLine(p_Device, Response);
 
         RAK3172_LOGD(TAG, "     Value: %s", p_Value->c_str());
     }
 
     #ifndef CONFIG_RAK3172_USE_RUI3
         // Receive the line feed before the status.
-        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
+        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
         {
+            RAK3172_Timeout_Record(p_Device, Class, Start, true);
+            RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
+
             return RAK3172_ERR_TIMEOUT;
         }
-        delete Response;
+        RAK3172_Trace_Response(p_Device, Response);
+        RAK3172_UART_ReleaseLine(p_Device, Response);
     #endif
 
     // Receive the trailing status code.
-    if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
+    if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
     {
+        RAK3172_Timeout_Record(p_Device, Class, Start, true);
+        RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
+
         return RAK3172_ERR_TIMEOUT;
     }
 
-    RAK3172_LOGD(TAG, "     Status: %s", Response->c_str());
+    RAK3172_Timeout_Record(p_Device, Class, Start, false);
+    RAK3172_Trace_Response(p_Device, Response);
 
-    if(p_Device.Internal.isRestricted)
+    RAK3172_LOGD(TAG, "     Status: %s", Response->Data);
+
+    Error = RAK3172_Commands_GetStatus(p_Device, Response);
+    RAK3172_Trace_End(p_Device, Error);
+    if(Error == RAK3172_ERR_RESTRICTED)
     {
-        delete Response;
+        RAK3172_UART_ReleaseLine(p_Device, Response);
 
         return RAK3172_ERR_RESTRICTED;
     }
 
-    // Transmission is without error when 'OK' as status code and when no event data are received.
-    if(Response->find("OK") == std::string::npos)
+    // Copy the status string if needed.
+    if(p_Status != NULL)
     {
-        if(Response->find("Command not found") != std::string::npos)
+        p_Status->assign(Response->Data, Response->Length);
+    }
+    RAK3172_LOGD(TAG, "    Error: 0x%X", static_cast<int>(Error));
+
+    RAK3172_UART_ReleaseLine(p_Device, Response);
+
+    return Error;
+}
+
+/** @brief              Transmit an AT command and receive the response while holding the device lock.
+ *  @param p_Device     RAK3172 device object
+ *  @param Command      RAK3172 command without line ending
+ *  @param isTerminated #true when the line ending is stored behind the command
+ *  @param p_Value      (Optional) Pointer to returned value
+ *  @param p_Status     (Optional) Pointer to status string
+ *  @return             RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_Commands_Execute(const RAK3172_t& p_Device, std::string_view Command, bool isTerminated, std::string* const p_Value,
+                                                std::string* const p_Status)
+{
+    RAK3172_Error_t Error;
+
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+    Error = RAK3172_Commands_Exchange(p_Device, Command, isTerminated, p_Value, p_Status);
+    RAK3172_Release(p_Device);
+
+    return Error;
+}
+
+RAK3172_Error_t RAK3172_SendLine(const RAK3172_t& p_Device, std::string_view Line, std::string* const p_Value, std::string* const p_Status)
+{
+    if((Line.size() < 2) || (Line[Line.size() - 2] != '\r') || (Line[Line.size() - 1] != '\n'))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    return RAK3172_Commands_Execute(p_Device, Line.substr(0, Line.size() - 2), true, p_Value, p_Status);
+}
+
+RAK3172_Error_t RAK3172_SendCommand(const RAK3172_t& p_Device, std::string_view Command, std::string* const p_Value, std::string* const p_Status)
+{
+    RAK3172_Command_t Buffer;
+
+    // Only long commands are transmitted with a separate line ending.
+    if(Command.size() > RAK3172_COMMAND_SIZE)
+    {
+        return RAK3172_Commands_Execute(p_Device, Command, false, p_Value, p_Status);
+    }
+
+    RAK3172_Command_Build(Buffer, Command);
+
+    return RAK3172_Commands_Execute(p_Device, RAK3172_Command_View(Buffer), true, p_Value, p_Status);
+}
+
+/** @brief          Write a command with the line ending to the UART.
+ *  @param p_Device RAK3172 device object
+ *  @param Command  Command object
+ */
+static void RAK3172_Commands_Write(const RAK3172_t& p_Device, const RAK3172_Command_t& Command)
+{
+    RAK3172_LOGD(TAG, "Transmit command: %.*s", static_cast<int>(Command.Length), Command.Buffer);
+
+    RAK3172_UART_WriteBytes(p_Device, Command.Buffer, Command.Length + 2);
+}
+
+/** @brief          Write a command with the line ending to the UART.
+ *  @param p_Device RAK3172 device object
+ *  @param Command  Command string without line ending
+ */
+static void RAK3172_Commands_Write(const RAK3172_t& p_Device, const std::string& Command)
+{
+    RAK3172_LOGD(TAG, "Transmit command: %s", Command.c_str());
+
+    RAK3172_UART_WriteBytes(p_Device, Command.c_str(), Command.length());
+    RAK3172_UART_WriteBytes(p_Device, "\r\n", 2);
+}
+
+/** @brief          Get the command without the line ending.
+ *  @param Command  Command object
+ *  @return         Command string
+ */
+static inline std::string_view RAK3172_Commands_View(const RAK3172_Command_t& Command)
+{
+    return RAK3172_Command_View(Command);
+}
+
+/** @brief          Get the command without the line ending.
+ *  @param Command  Command string
+ *  @return         Command string
+ */
+static inline std::string_view RAK3172_Commands_View(const std::string& Command)
+{
+    return std::string_view(Command);
+}
+
+/** @brief              Transmit a batch of commands with the pipeline and assign the responses to the commands.
+ *  @param p_Device     RAK3172 device object
+ *  @param p_Commands   Pointer to list with commands (#std::string or #RAK3172_Command_t)
+ *  @param Count        Number of commands
+ *  @param p_Results    (Optional) Pointer to list with Count results
+ *  @param p_Values     (Optional) Pointer to list with Count values
+ *  @return             RAK3172_ERR_OK when all commands were successful or the result of the first failed command
+ */
+template<typename T>
+static RAK3172_Error_t RAK3172_Commands_Pipeline(const RAK3172_t& p_Device, const T* p_Commands, size_t Count, RAK3172_Error_t* const p_Results, std::string* const p_Values)
+{
+    size_t Sent;
+    int64_t Start;
+    RAK3172_Error_t Error;
+
+    if(p_Device.Internal.isBusy)
+    {
+        RAK3172_LOGE(TAG, "Device busy!");
+
+        return RAK3172_ERR_BUSY;
+    }
+    else if(p_Device.Internal.isInitialized == false)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    // Commands without a result are aborted because of a previous timeout.
+    for(size_t i = 0; i < Count; i++)
+    {
+        if(p_Results != NULL)
         {
-            Error = RAK3172_ERR_COMMAND_NOT_FOUND;
+            p_Results[i] = RAK3172_ERR_TIMEOUT;
         }
-        else
+
+        if(p_Values != NULL)
         {
-            Error = RAK3172_ERR_FAIL;
+            p_Values[i].clear();
         }
     }
 
-    // Copy the status string if needed.
-    if(p_Status != NULL)
+    Error = RAK3172_ERR_OK;
+    Sent = 0;
+
+    // Clear the queue and drop all items.
+    RAK3172_UART_FlushLines(p_Device);
+
+    for(size_t i = 0; i < Count; i++)
+    {
+        RAK3172_Line_t* Response;
+        RAK3172_Error_t Result;
+        TickType_t Timeout;
+        RAK3172_TimeoutClass_t Class;
+        std::string_view Command;
+        #ifdef CONFIG_RAK3172_USE_RUI3
+            size_t EchoLength;
+        #endif
+
+        // Fill the pipeline.
+        while((Sent < Count) && ((Sent - i) < CONFIG_RAK3172_COMMAND_PIPELINE_DEPTH))
+        {
+            RAK3172_Commands_Write(p_Device, p_Commands[Sent]);
+            Sent++;
+        }
+
+        // The module processes the commands one after another. The round trip time of a command starts with the status of the previous command.
+        if(i == 0)
+        {
+            Start = RAK3172_Timer_GetMicroseconds();
+        }
+
+        Command = RAK3172_Commands_View(p_Commands[i]);
+        Class = RAK3172_Timeout_GetClass(Command);
+        Timeout = RAK3172_Timeout_GetTicks(p_Device, Class, Command.size() + 2);
+        RAK3172_Trace_Begin(p_Device, Command, Start);
+
+        #ifdef CONFIG_RAK3172_USE_RUI3
+            // The module echoes the command up to the '=' in front of a returned value.
+            EchoLength = Command.find('=');
+            EchoLength = (EchoLength == std::string_view::npos) ? 0 : (EchoLength + 1);
+        #endif
+
+        // Collect the value lines until the status of the command is received.
+        Result = RAK3172_ERR_OK;
+        while(true)
+        {
+            if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
+            {
+                RAK3172_Timeout_Record(p_Device, Class, Start, true);
+                RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
+
+                RAK3172_LOGE(TAG, "Timeout for command %.*s. Abort %u commands!", static_cast<int>(Command.size()), Command.data(), static_cast<unsigned int>(Count - i));
+
+                // Drop the responses of the remaining commands in the pipeline.
+                RAK3172_UART_FlushLines(p_Device);
+
+                return (Error == RAK3172_ERR_OK) ? RAK3172_ERR_TIMEOUT : Error;
+            }
+
+            // Skip the line feed in front of the status.
+            if(Response->Length == 0)
+            {
+                RAK3172_UART_ReleaseLine(p_Device, Response);
+
+                continue;
+            }
+
+            RAK3172_Trace_Response(p_Device, Response);
+
+            if(RAK3172_Commands_isStatus(Response))
+            {
+                RAK3172_Timeout_Record(p_Device, Class, Start, false);
+                Start = RAK3172_Timer_GetMicroseconds();
+
+                RAK3172_LOGD(TAG, "     Status: %s", Response->Data);
+
+                if(Result == RAK3172_ERR_OK)
+                {
+                    Result = RAK3172_Commands_GetStatus(p_Device, Response);
+                }
+
+                RAK3172_Trace_End(p_Device, Result);
+                RAK3172_UART_ReleaseLine(p_Device, Response);
+
+                break;
+            }
+
+            RAK3172_LOGD(TAG, "     Value: %s", Response->Data);
+
+            #ifdef CONFIG_RAK3172_USE_RUI3
+                if((EchoLength == 0) || (Response->Length < EchoLength) || (strncmp(Response->Data, Command.data(), EchoLength) != 0))
+                {
+                    RAK3172_LOGW(TAG, "Response %s doesn´t belong to command %.*s!", Response->Data, static_cast<int>(Command.size()), Command.data());
+
+                    Result = RAK3172_ERR_FAIL;
+                }
+                else if(p_Values != NULL)
+                {
+                    p_Values[i].assign(Response->Data + EchoLength, Response->Length - EchoLength);
+                }
+            #else
+                if(p_Values != NULL)
+                {
+                    p_Values[i].assign(Response->Data, Response->Length);
+                }
+            #endif
+
+            RAK3172_UART_ReleaseLine(p_Device, Response);
+        }
+
+        if(p_Results != NULL)
+        {
+            p_Results[i] = Result;
+        }
+
+        if((Error == RAK3172_ERR_OK) && (Result != RAK3172_ERR_OK))
+        {
+            Error = Result;
+        }
+    }
+
+    return Error;
+}
+
+RAK3172_Error_t RAK3172_SendCommands(const RAK3172_t& p_Device, const std::vector<std::string>& Commands, std::vector<RAK3172_Error_t>* const p_Results, std::vector<std::string>* const p_Values)
+{
+    RAK3172_Error_t Error;
+
+    if(p_Results != NULL)
     {
-        *p_Status = *Response;
+        p_Results->resize(Commands.size());
+    }
+
+    if(p_Values != NULL)
+    {
+        p_Values->resize(Commands.size());
+    }
+
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+    Error = RAK3172_Commands_Pipeline(p_Device, Commands.data(), Commands.size(), (p_Results != NULL) ? p_Results->data() : NULL,
+                                      (p_Values != NULL) ? p_Values->data() : NULL);
+    RAK3172_Release(p_Device);
+
+    return Error;
+}
+
+RAK3172_Error_t RAK3172_SendCommands(const RAK3172_t& p_Device, const RAK3172_Command_t* p_Commands, size_t Count, RAK3172_Error_t* const p_Results, std::string* const p_Values)
+{
+    RAK3172_Error_t Error;
+
+    if((p_Commands == NULL) && (Count > 0))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    for(size_t i = 0; i < Count; i++)
+    {
+        if(p_Commands[i].isOverflow)
+        {
+            return RAK3172_ERR_INVALID_SIZE;
+        }
     }
-    RAK3172_LOGD(TAG, "    Error: 0x%X", static_cast<int>(Error));
 
-    delete Response;
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+    Error = RAK3172_Commands_Pipeline(p_Device, p_Commands, Count, p_Results, p_Values);
+    RAK3172_Release(p_Device);
 
     return Error;
 }
@@ -142,8 +514,10 @@ RAK3172_Error_t RAK3172_GetSerialNumber(const RAK3172_t& p_Device, std::string*
 
 RAK3172_Error_t RAK3172_SetMode(RAK3172_t& p_Device, RAK3172_Mode_t Mode)
 {
-    std::string Command;
-    std::string* Response;
+    int64_t Start;
+    TickType_t Timeout;
+    RAK3172_Command_t Command;
+    RAK3172_Line_t* Response;
     RAK3172_Error_t Error;
 
     if(p_Device.Internal.isInitialized == false)
@@ -155,42 +529,56 @@ RAK3172_Error_t RAK3172_SetMode(RAK3172_t& p_Device, RAK3172_Mode_t Mode)
         return RAK3172_ERR_OK;
     }
 
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    // The settings of the previous mode are no longer valid.
+    RAK3172_InvalidateShadow(p_Device);
+
     p_Device.Internal.isBusy = true;
 
     // Transmit the command.
-    Command = "AT+NWM=" + std::to_string(static_cast<uint32_t>(Mode)) + "\r\n";
-    uart_write_bytes(p_Device.UART.Interface, static_cast<const char*>(Command.c_str()), Command.length());
+    RAK3172_Command_Build(Command, "AT+NWM=", static_cast<uint32_t>(Mode));
+    Timeout = RAK3172_Timeout_GetTicks(p_Device, RAK_TIMEOUT_SLOW, Command.Length + 2);
+    RAK3172_UART_WriteBytes(p_Device, Command.Buffer, Command.Length + 2);
+    Start = RAK3172_Timer_GetMicroseconds();
+    RAK3172_Trace_Begin(p_Device, RAK3172_Command_View(Command), Start);
 
     #ifndef CONFIG_RAK3172_USE_RUI3
         // Receive the line feed before the status.
-        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
+        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
         {
+            RAK3172_Timeout_Record(p_Device, RAK_TIMEOUT_SLOW, Start, true);
+            RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
             Error = RAK3172_ERR_TIMEOUT;
             goto RAK3172_SetMode_Exit;
         }
-        delete Response;
+        RAK3172_Trace_Response(p_Device, Response);
+        RAK3172_UART_ReleaseLine(p_Device, Response);
     #endif
 
     // Receive the trailing status code.
-    if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
+    if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, Timeout) != pdPASS)
     {
+        RAK3172_Timeout_Record(p_Device, RAK_TIMEOUT_SLOW, Start, true);
+        RAK3172_Trace_End(p_Device, RAK3172_ERR_TIMEOUT);
         Error = RAK3172_ERR_TIMEOUT;
         goto RAK3172_SetMode_Exit;
     }
-
-    do
+    RAK3172_Timeout_Record(p_Device, RAK_TIMEOUT_SLOW, Start, false);
+    RAK3172_Trace_Response(p_Device, Response);
+    RAK3172_Trace_End(p_Device, RAK3172_Commands_GetStatus(p_Device, Response));
+    RAK3172_UART_ReleaseLine(p_Device, Response);
+
+    // Process all lines until the module stops sending. The last line decides about the result.
+    Error = RAK3172_ERR_INVALID_RESPONSE;
+    while(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) == pdPASS)
     {
-        if(xQueueReceive(p_Device.Internal.MessageQueue, &Response, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) == pdFAIL)
-        {
-            p_Device.Internal.isBusy = false;
-        }
-
-        if(Response->find("Current Work Mode: LoRa P2P") != std::string::npos)
+        if(strstr(Response->Data, "Current Work Mode: LoRa P2P") != NULL)
         {
             p_Device.Mode = RAK_MODE_P2P;
             Error = RAK3172_ERR_OK;
         }
-        else if(Response->find("Current Work Mode: LoRa LoRaWAN") != std::string::npos)
+        else if(strstr(Response->Data, "Current Work Mode: LoRa LoRaWAN") != NULL)
         {
             p_Device.Mode = RAK_MODE_LORAWAN;
             Error = RAK3172_ERR_OK;
@@ -199,12 +587,14 @@ RAK3172_Error_t RAK3172_SetMode(RAK3172_t& p_Device, RAK3172_Mode_t Mode)
         {
             Error = RAK3172_ERR_INVALID_RESPONSE;
         }
-    } while(p_Device.Internal.isBusy);
 
-    delete Response;
+        RAK3172_UART_ReleaseLine(p_Device, Response);
+    }
 
 RAK3172_SetMode_Exit:
     p_Device.Internal.isBusy = false;
+    RAK3172_Release(p_Device);
+
     return Error;
 }
 
@@ -214,7 +604,10 @@ RAK3172_Error_t RAK3172_GetMode(RAK3172_t& p_Device)
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+NWM=?", &Value));
 
-    p_Device.Mode = static_cast<RAK3172_Mode_t>(std::stoi(Value));
+    if(RAK3172_Number_To(Value, &p_Device.Mode) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -225,7 +618,10 @@ RAK3172_Error_t RAK3172_GetBaudrateFromDevice(const RAK3172_t& p_Device, RAK3172
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+BAUD=?", &Value));
 
-    *p_Baudrate = static_cast<RAK3172_Baud_t>(std::stoi(Value));
+    if(RAK3172_Number_To(Value, p_Baudrate) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
\ No newline at end of file
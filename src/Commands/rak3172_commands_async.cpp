@@ -0,0 +1,270 @@
+ /*
+ * rak3172_commands_async.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Asynchronous command task for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <sdkconfig.h>
+
+#ifdef CONFIG_RAK3172_COMMAND_ASYNC
+
+#include <string.h>
+
+#include "rak3172_timeout.h"
+#include "rak3172_commands_async.h"
+
+#include "../Arch/Logging/rak3172_logging.h"
+
+/** @brief Asynchronous command request object.
+ */
+typedef struct
+{
+    uint32_t ID;                                            /**< Command ID or 0 to stop the command task. */
+    char Command[CONFIG_RAK3172_COMMAND_ASYNC_SIZE + 1];    /**< Zero terminated command. */
+    RAK3172_CommandCallback_t Callback;                     /**< Completion callback or #NULL when the completion queue is used. */
+    QueueHandle_t Queue;                                    /**< Completion queue or #NULL when the callback is used. */
+    void* p_Arg;                                            /**< User argument for the callback. */
+} RAK3172_CommandRequest_t;
+
+static const char* TAG = "RAK3172_Async";
+
+/** @brief              Pass the result of a command to the callback or the completion queue of the request.
+ *  @param p_Request    Pointer to command request
+ *  @param p_Result     Pointer to command result
+ */
+static void RAK3172_Commands_Complete(const RAK3172_CommandRequest_t* p_Request, const RAK3172_CommandResult_t* p_Result)
+{
+    if(p_Request->Callback != NULL)
+    {
+        p_Request->Callback(p_Result, p_Request->p_Arg);
+    }
+    else if(xQueueSend(p_Request->Queue, p_Result, 0) != pdPASS)
+    {
+        RAK3172_LOGW(TAG, "Completion queue full. Drop result of command %u!", static_cast<unsigned int>(p_Request->ID));
+    }
+}
+
+/** @brief          Command task. Executes the queued commands one after another with the blocking command interface.
+ *  @param p_Arg    Pointer to RAK3172 device object
+ */
+static void RAK3172_Commands_Task(void* p_Arg)
+{
+    RAK3172_t* Device = static_cast<RAK3172_t*>(p_Arg);
+    RAK3172_CommandRequest_t Request;
+    RAK3172_CommandResult_t Result;
+
+    while(true)
+    {
+        std::string Value;
+        size_t Length;
+        bool isQuery;
+
+        if(xQueueReceive(Device->Internal.CommandQueue, &Request, portMAX_DELAY) != pdPASS)
+        {
+            continue;
+        }
+        else if(Request.ID == 0)
+        {
+            break;
+        }
+
+        // Only query commands return a value.
+        Length = strlen(Request.Command);
+        isQuery = (Length > 0) && (Request.Command[Length - 1] == '?');
+
+        RAK3172_LOGD(TAG, "Execute command %u: %s", static_cast<unsigned int>(Request.ID), Request.Command);
+
+        Result.ID = Request.ID;
+        Result.Error = RAK3172_SendCommand(*Device, Request.Command, isQuery ? &Value : NULL);
+        Result.Value[0] = '\0';
+        if(isQuery)
+        {
+            Length = Value.copy(Result.Value, CONFIG_RAK3172_COMMAND_ASYNC_SIZE);
+            Result.Value[Length] = '\0';
+        }
+
+        RAK3172_Commands_Complete(&Request, &Result);
+    }
+
+    // Complete all pending commands.
+    while(xQueueReceive(Device->Internal.CommandQueue, &Request, 0) == pdPASS)
+    {
+        if(Request.ID == 0)
+        {
+            continue;
+        }
+
+        Result.ID = Request.ID;
+        Result.Error = RAK3172_ERR_INVALID_STATE;
+        Result.Value[0] = '\0';
+
+        RAK3172_Commands_Complete(&Request, &Result);
+    }
+
+    // The device object isn´t used after this point, because it can be released by the stopping task.
+    xSemaphoreGive(Device->Internal.CommandDone);
+
+    vTaskDelete(NULL);
+}
+
+/** @brief              Put a command into the command queue.
+ *  @param p_Device     RAK3172 device object
+ *  @param Command      RAK3172 command
+ *  @param Callback     Completion callback or #NULL
+ *  @param Queue        Completion queue or #NULL
+ *  @param p_Arg        User argument for the callback
+ *  @param p_ID         (Optional) Pointer to command ID
+ *  @return             RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_Commands_Enqueue(RAK3172_t& p_Device, std::string_view Command, RAK3172_CommandCallback_t Callback, QueueHandle_t Queue, void* p_Arg,
+                                                uint32_t* p_ID)
+{
+    RAK3172_CommandRequest_t Request;
+
+    if(Command.length() > CONFIG_RAK3172_COMMAND_ASYNC_SIZE)
+    {
+        return RAK3172_ERR_INVALID_SIZE;
+    }
+    else if((p_Device.Internal.isInitialized == false) || (p_Device.Internal.CommandQueue == NULL))
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    // The ID 0 is reserved for the stop request of the command task.
+    do
+    {
+        Request.ID = __atomic_add_fetch(&p_Device.Internal.CommandID, 1, __ATOMIC_RELAXED);
+    } while(Request.ID == 0);
+
+    Command.copy(Request.Command, CONFIG_RAK3172_COMMAND_ASYNC_SIZE);
+    Request.Command[Command.length()] = '\0';
+    Request.Callback = Callback;
+    Request.Queue = Queue;
+    Request.p_Arg = p_Arg;
+
+    if(xQueueSend(p_Device.Internal.CommandQueue, &Request, 0) != pdPASS)
+    {
+        return RAK3172_ERR_BUSY;
+    }
+
+    if(p_ID != NULL)
+    {
+        *p_ID = Request.ID;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_Commands_StartAsync(RAK3172_t& p_Device)
+{
+    if(p_Device.Internal.CommandHandle != NULL)
+    {
+        return RAK3172_ERR_OK;
+    }
+
+    p_Device.Internal.CommandQueue = xQueueCreate(CONFIG_RAK3172_COMMAND_ASYNC_QUEUE_LENGTH, sizeof(RAK3172_CommandRequest_t));
+    if(p_Device.Internal.CommandQueue == NULL)
+    {
+        return RAK3172_ERR_NO_MEM;
+    }
+
+    p_Device.Internal.CommandDone = xSemaphoreCreateBinary();
+    if(p_Device.Internal.CommandDone == NULL)
+    {
+        vQueueDelete(p_Device.Internal.CommandQueue);
+        p_Device.Internal.CommandQueue = NULL;
+
+        return RAK3172_ERR_NO_MEM;
+    }
+
+    #ifdef CONFIG_RAK3172_TASK_CORE_USE_AFFINITY
+        xTaskCreatePinnedToCore(RAK3172_Commands_Task, "RAK3172_Async", CONFIG_RAK3172_COMMAND_ASYNC_STACK_SIZE, &p_Device, CONFIG_RAK3172_COMMAND_ASYNC_PRIO,
+                                &p_Device.Internal.CommandHandle, CONFIG_RAK3172_TASK_CORE);
+    #else
+        xTaskCreate(RAK3172_Commands_Task, "RAK3172_Async", CONFIG_RAK3172_COMMAND_ASYNC_STACK_SIZE, &p_Device, CONFIG_RAK3172_COMMAND_ASYNC_PRIO,
+                    &p_Device.Internal.CommandHandle);
+    #endif
+
+    if(p_Device.Internal.CommandHandle == NULL)
+    {
+        vSemaphoreDelete(p_Device.Internal.CommandDone);
+        p_Device.Internal.CommandDone = NULL;
+        vQueueDelete(p_Device.Internal.CommandQueue);
+        p_Device.Internal.CommandQueue = NULL;
+
+        return RAK3172_ERR_NO_MEM;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_Commands_StopAsync(RAK3172_t& p_Device)
+{
+    RAK3172_CommandRequest_t Request;
+    TickType_t Timeout;
+
+    if(p_Device.Internal.CommandQueue == NULL)
+    {
+        return RAK3172_ERR_OK;
+    }
+
+    if(p_Device.Internal.CommandHandle != NULL)
+    {
+        memset(&Request, 0, sizeof(RAK3172_CommandRequest_t));
+        xQueueSendToFront(p_Device.Internal.CommandQueue, &Request, portMAX_DELAY);
+
+        // Wait until the current command has finished and the task has completed the pending commands. The current
+        // command can wait for the device lock and can be the slowest command of the module.
+        Timeout = pdMS_TO_TICKS(CONFIG_RAK3172_LOCK_TIMEOUT) + RAK3172_Timeout_GetTicks(p_Device, RAK_TIMEOUT_SLOW, CONFIG_RAK3172_COMMAND_ASYNC_SIZE);
+        if(xSemaphoreTake(p_Device.Internal.CommandDone, Timeout) != pdTRUE)
+        {
+            RAK3172_LOGE(TAG, "Timeout while stopping the command task!");
+
+            return RAK3172_ERR_TIMEOUT;
+        }
+
+        p_Device.Internal.CommandHandle = NULL;
+    }
+
+    vSemaphoreDelete(p_Device.Internal.CommandDone);
+    p_Device.Internal.CommandDone = NULL;
+    vQueueDelete(p_Device.Internal.CommandQueue);
+    p_Device.Internal.CommandQueue = NULL;
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_SendCommandAsync(RAK3172_t& p_Device, std::string_view Command, RAK3172_CommandCallback_t Callback, void* p_Arg, uint32_t* p_ID)
+{
+    if(Callback == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    return RAK3172_Commands_Enqueue(p_Device, Command, Callback, NULL, p_Arg, p_ID);
+}
+
+RAK3172_Error_t RAK3172_SendCommandAsyncQueue(RAK3172_t& p_Device, std::string_view Command, QueueHandle_t Queue, uint32_t* p_ID)
+{
+    if(Queue == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    return RAK3172_Commands_Enqueue(p_Device, Command, NULL, Queue, NULL, p_ID);
+}
+
+#endif
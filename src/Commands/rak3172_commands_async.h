@@ -0,0 +1,42 @@
+ /*
+ * rak3172_commands_async.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Asynchronous command task for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_COMMANDS_ASYNC_H_
+#define RAK3172_COMMANDS_ASYNC_H_
+
+#include "rak3172.h"
+
+#ifdef CONFIG_RAK3172_COMMAND_ASYNC
+    /** @brief          Create the command queue and the command task of a device.
+     *  @param p_Device RAK3172 device object
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_NO_MEM when the queue or the task cannot be created
+     */
+    RAK3172_Error_t RAK3172_Commands_StartAsync(RAK3172_t& p_Device);
+
+    /** @brief          Stop the command task of a device. The function blocks until the current command has finished.
+     *                  All pending commands are completed with RAK3172_ERR_INVALID_STATE.
+     *  @param p_Device RAK3172 device object
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_TIMEOUT when the command task doesn´t stop within the lock timeout and the timeout of the slowest command
+     */
+    RAK3172_Error_t RAK3172_Commands_StopAsync(RAK3172_t& p_Device);
+#endif
+
+#endif /* RAK3172_COMMANDS_ASYNC_H_ */
@@ -23,6 +23,10 @@
 
 #include "rak3172.h"
 
+#include "../Parser/rak3172_number.h"
+
+#include "../Arch/UART/rak3172_uart.h"
+
 RAK3172_Error_t RAK3172_GetCLIVersion(const RAK3172_t& p_Device, std::string* const p_Version)
 {
     if(p_Version == NULL)
@@ -94,7 +98,7 @@ RAK3172_Error_t RAK3172_Sleep(RAK3172_t& p_Device, uint32_t Duration)
         return (Error == RAK3172_ERR_TIMEOUT) ? RAK3172_ERR_OK : Error;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+SLEEP=" + std::to_string(Duration));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+SLEEP=", Duration));
 }
 
 RAK3172_Error_t RAK3172_Lock(const RAK3172_t& p_Device, std::string Password)
@@ -104,9 +108,10 @@ RAK3172_Error_t RAK3172_Lock(const RAK3172_t& p_Device, std::string Password)
         return RAK3172_ERR_INVALID_ARG;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PWORD=" + Password));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PWORD=", Password)));
 
-    uart_write_bytes(p_Device.UART.Interface, "AT+LOCK\r\n", std::string("AT+LOCK\r\n").length());
+    constexpr std::string_view Command = "AT+LOCK\r\n";
+    RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size());
 
     return RAK3172_ERR_FAIL;
 }
@@ -118,19 +123,19 @@ RAK3172_Error_t RAK3172_Unlock(const RAK3172_t& p_Device, std::string Password)
         return RAK3172_ERR_INVALID_ARG;
     }
 
-    uart_write_bytes(p_Device.UART.Interface, Password.c_str(), Password.length());
+    RAK3172_UART_WriteBytes(p_Device, Password.c_str(), Password.length());
 
     return RAK3172_ERR_FAIL;
 }
 
 RAK3172_Error_t RAK3172_EnableAutoLowPower(const RAK3172_t& p_Device, bool Enable)
 {
-    return RAK3172_SendCommand(p_Device, "AT+LPM=" + std::to_string(Enable));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+LPM=", Enable));
 }
 
 RAK3172_Error_t RAK3172_SetPwrMode(RAK3172_t& p_Device, RAK3172_PwrMode_t Mode)
 {
-    return RAK3172_SendCommand(p_Device, "AT+LPMLVL=" + std::to_string(Mode));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+LPMLVL=", Mode));
 }
 
 RAK3172_Error_t RAK3172_GetPwrMode(RAK3172_t& p_Device, RAK3172_PwrMode_t* const p_Mode)
@@ -144,7 +149,10 @@ RAK3172_Error_t RAK3172_GetPwrMode(RAK3172_t& p_Device, RAK3172_PwrMode_t* const
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+LPMLVL=?", &Response));
 
-    *p_Mode = static_cast<RAK3172_PwrMode_t>(std::stoi(Response));
+    if(RAK3172_Number_To(Response, p_Mode) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -0,0 +1,147 @@
+ /*
+ * rak3172_lock.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Device lock for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <freertos/semphr.h>
+
+#include "rak3172_lock.h"
+
+#include "../Arch/Timer/rak3172_timer.h"
+#include "../Arch/Logging/rak3172_logging.h"
+
+static const char* TAG = "RAK3172_Lock";
+
+RAK3172_Error_t RAK3172_Lock_Init(RAK3172_t& p_Device)
+{
+    if(p_Device.Internal.Lock != NULL)
+    {
+        return RAK3172_ERR_OK;
+    }
+
+    // Mutexes use priority inheritance and waiting tasks are woken up in the order of their priority.
+    p_Device.Internal.Lock = xSemaphoreCreateRecursiveMutex();
+    if(p_Device.Internal.Lock == NULL)
+    {
+        return RAK3172_ERR_NO_MEM;
+    }
+
+    p_Device.Internal.LockDepth = 0;
+
+    return RAK3172_ERR_OK;
+}
+
+void RAK3172_Lock_Deinit(RAK3172_t& p_Device)
+{
+    if(p_Device.Internal.Lock == NULL)
+    {
+        return;
+    }
+
+    vSemaphoreDelete(p_Device.Internal.Lock);
+    p_Device.Internal.Lock = NULL;
+}
+
+RAK3172_Error_t RAK3172_Acquire(const RAK3172_t& p_Device, RAK3172_Priority_t Priority, uint32_t Timeout)
+{
+    UBaseType_t Previous;
+    bool isBoosted;
+    int64_t Start;
+    uint32_t Wait;
+
+    if(p_Device.Internal.Lock == NULL)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    // Nested calls from the lock holder never block.
+    if(xSemaphoreGetMutexHolder(p_Device.Internal.Lock) == xTaskGetCurrentTaskHandle())
+    {
+        xSemaphoreTakeRecursive(p_Device.Internal.Lock, 0);
+        p_Device.Internal.LockDepth++;
+
+        return RAK3172_ERR_OK;
+    }
+
+    // Urgent requests wait with a raised priority to get the lock ahead of background tasks.
+    Previous = uxTaskPriorityGet(NULL);
+    isBoosted = (Priority == RAK_PRIO_URGENT) && (Previous < CONFIG_RAK3172_LOCK_URGENT_PRIO);
+    if(isBoosted)
+    {
+        vTaskPrioritySet(NULL, CONFIG_RAK3172_LOCK_URGENT_PRIO);
+    }
+
+    Wait = 0;
+    if(xSemaphoreTakeRecursive(p_Device.Internal.Lock, 0) != pdTRUE)
+    {
+        Start = RAK3172_Timer_GetMicroseconds();
+
+        if(xSemaphoreTakeRecursive(p_Device.Internal.Lock, pdMS_TO_TICKS(Timeout)) != pdTRUE)
+        {
+            if(isBoosted)
+            {
+                vTaskPrioritySet(NULL, Previous);
+            }
+
+            p_Device.Internal.Stats.LockTimeouts++;
+
+            RAK3172_LOGW(TAG, "Timeout while waiting for the device lock!");
+
+            return RAK3172_ERR_BUSY;
+        }
+
+        Wait = static_cast<uint32_t>(RAK3172_Timer_GetMicroseconds() - Start);
+        p_Device.Internal.Stats.LockWaits++;
+    }
+
+    // The statistics are only changed by the lock holder.
+    p_Device.Internal.Stats.LockAcquired++;
+    p_Device.Internal.Stats.LockWaitTime += Wait;
+    if(Wait > p_Device.Internal.Stats.LockWaitMax)
+    {
+        p_Device.Internal.Stats.LockWaitMax = Wait;
+    }
+
+    p_Device.Internal.LockDepth = 1;
+    p_Device.Internal.LockPriority = Previous;
+    p_Device.Internal.isLockBoosted = isBoosted;
+
+    return RAK3172_ERR_OK;
+}
+
+void RAK3172_Release(const RAK3172_t& p_Device)
+{
+    UBaseType_t Previous;
+    bool isBoosted;
+
+    if((p_Device.Internal.Lock == NULL) || (xSemaphoreGetMutexHolder(p_Device.Internal.Lock) != xTaskGetCurrentTaskHandle()))
+    {
+        return;
+    }
+
+    p_Device.Internal.LockDepth--;
+    Previous = p_Device.Internal.LockPriority;
+    isBoosted = (p_Device.Internal.LockDepth == 0) && p_Device.Internal.isLockBoosted;
+
+    xSemaphoreGiveRecursive(p_Device.Internal.Lock);
+
+    // Restore the priority of an urgent request after the outermost release.
+    if(isBoosted)
+    {
+        vTaskPrioritySet(NULL, Previous);
+    }
+}
@@ -0,0 +1,184 @@
+ /*
+ * rak3172_timeout.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Command timeout classes for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include "rak3172_timeout.h"
+
+#include <algorithm>
+
+#include "../Arch/Timer/rak3172_timer.h"
+
+/** @brief Static command timeouts in milliseconds for each timeout class.
+ */
+static const uint32_t _RAK3172_Timeouts[RAK_TIMEOUT_CLASS_MAX] = {
+    CONFIG_RAK3172_COMMAND_TIMEOUT_QUERY,
+    CONFIG_RAK3172_COMMAND_TIMEOUT_SET,
+    CONFIG_RAK3172_COMMAND_TIMEOUT_SLOW,
+};
+
+/** @brief Commands which write the module flash or restart the LoRa stack.
+ */
+static const std::string_view _RAK3172_SlowCommands[] = {
+    "AT+NWM=",
+    "AT+BAND=",
+    "AT+P2P=",
+    "AT+DEVEUI=",
+    "AT+APPEUI=",
+    "AT+APPKEY=",
+    "AT+APPSKEY=",
+    "AT+NWKSKEY=",
+    "AT+DEVADDR=",
+    "AT+MASK=",
+};
+
+#ifdef CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE
+    /** @brief Minimum number of samples before the timeout is derived from the measured round trip times.
+     */
+    #define RAK3172_TIMEOUT_MIN_SAMPLES                 16
+
+    /** @brief Number of samples after which all buckets are halved to forget old measurements.
+     */
+    #define RAK3172_TIMEOUT_WINDOW                      256
+
+    /** @brief      Get the p99 of the round trip times of a timeout class.
+     *  @param p_Latency Pointer to latency histogram
+     *  @return     Upper bound of the p99 bucket in milliseconds
+     */
+    static uint32_t RAK3172_Timeout_GetP99(const RAK3172_Latency_t* p_Latency)
+    {
+        uint32_t Sum;
+
+        Sum = 0;
+        for(uint8_t i = 0; i < RAK3172_LATENCY_BUCKETS; i++)
+        {
+            Sum += p_Latency->Buckets[i];
+
+            if((Sum * 100) >= (static_cast<uint32_t>(p_Latency->Samples) * 99))
+            {
+                return (1UL << i);
+            }
+        }
+
+        return (1UL << (RAK3172_LATENCY_BUCKETS - 1));
+    }
+#endif
+
+RAK3172_TimeoutClass_t RAK3172_Timeout_GetClass(std::string_view Command)
+{
+    if((Command == "AT") || ((Command.size() >= 2) && (Command.substr(Command.size() - 2) == "=?")))
+    {
+        return RAK_TIMEOUT_QUERY;
+    }
+
+    for(const std::string_view& Slow : _RAK3172_SlowCommands)
+    {
+        if(Command.substr(0, Slow.size()) == Slow)
+        {
+            return RAK_TIMEOUT_SLOW;
+        }
+    }
+
+    return RAK_TIMEOUT_SET;
+}
+
+TickType_t RAK3172_Timeout_GetTicks(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, size_t Length)
+{
+    uint32_t Timeout;
+
+    Timeout = CONFIG_RAK3172_COMMAND_TIMEOUT_SET;
+    RAK3172_GetCommandTimeout(p_Device, Class, &Timeout);
+
+    // The command is still transmitted when the UART write returns. Add the transmission time with 10 bits per byte,
+    // because long commands (i. e. AT+LPSEND) need longer than the timeout of the class.
+    if(p_Device.UART.Baudrate != 0)
+    {
+        Timeout += ((Length * 10000UL) + p_Device.UART.Baudrate - 1) / p_Device.UART.Baudrate;
+    }
+
+    return pdMS_TO_TICKS(Timeout);
+}
+
+void RAK3172_Timeout_Record(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, int64_t Start, bool isTimeout)
+{
+    #ifdef CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE
+        uint32_t Elapsed;
+        uint8_t Bucket;
+        RAK3172_Latency_t* p_Latency;
+
+        p_Latency = &p_Device.Internal.Latency[Class];
+
+        // A timeout is recorded with at least the used timeout to increase the p99 for commands which are slower than expected.
+        Elapsed = static_cast<uint32_t>((RAK3172_Timer_GetMicroseconds() - Start) / 1000);
+        if(isTimeout && (Elapsed < p_Latency->Timeout))
+        {
+            Elapsed = p_Latency->Timeout;
+        }
+
+        Bucket = 0;
+        while((Bucket < (RAK3172_LATENCY_BUCKETS - 1)) && (Elapsed >= (1UL << Bucket)))
+        {
+            Bucket++;
+        }
+
+        p_Latency->Buckets[Bucket]++;
+        p_Latency->Samples++;
+
+        if(p_Latency->Samples >= RAK3172_TIMEOUT_WINDOW)
+        {
+            p_Latency->Samples = 0;
+            for(uint8_t i = 0; i < RAK3172_LATENCY_BUCKETS; i++)
+            {
+                p_Latency->Buckets[i] /= 2;
+                p_Latency->Samples += p_Latency->Buckets[i];
+            }
+        }
+
+        // Use twice the p99 as timeout to tolerate outliers.
+        if(p_Latency->Samples >= RAK3172_TIMEOUT_MIN_SAMPLES)
+        {
+            p_Latency->Timeout = std::clamp<uint32_t>(2 * RAK3172_Timeout_GetP99(p_Latency), CONFIG_RAK3172_COMMAND_TIMEOUT_MIN,
+                                                      CONFIG_RAK3172_COMMAND_TIMEOUT_MAX);
+        }
+    #else
+        (void)p_Device;
+        (void)Class;
+        (void)Start;
+        (void)isTimeout;
+    #endif
+}
+
+RAK3172_Error_t RAK3172_GetCommandTimeout(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, uint32_t* const p_Timeout)
+{
+    if((Class >= RAK_TIMEOUT_CLASS_MAX) || (p_Timeout == NULL))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    *p_Timeout = _RAK3172_Timeouts[Class];
+
+    #ifdef CONFIG_RAK3172_COMMAND_TIMEOUT_ADAPTIVE
+        if(p_Device.Internal.Latency[Class].Timeout != 0)
+        {
+            *p_Timeout = p_Device.Internal.Latency[Class].Timeout;
+        }
+    #else
+        (void)p_Device;
+    #endif
+
+    return RAK3172_ERR_OK;
+}
@@ -0,0 +1,50 @@
+ /*
+ * rak3172_timeout.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Command timeout classes for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_TIMEOUT_H_
+#define RAK3172_TIMEOUT_H_
+
+#include <string_view>
+
+#include "rak3172.h"
+
+/** @brief          Get the timeout class of a command.
+ *  @param Command  RAK3172 command without line ending
+ *  @return         Timeout class
+ */
+RAK3172_TimeoutClass_t RAK3172_Timeout_GetClass(std::string_view Command);
+
+/** @brief          Get the response timeout for a command class.
+ *  @param p_Device RAK3172 device object
+ *  @param Class    Timeout class
+ *  @param Length   (Optional) Length of the transmitted command with line ending
+ *  @return         Timeout in ticks
+ */
+TickType_t RAK3172_Timeout_GetTicks(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, size_t Length = 0);
+
+/** @brief          Record the round trip time of a command.
+ *                  NOTE: Must be called with the device lock.
+ *  @param p_Device RAK3172 device object
+ *  @param Class    Timeout class
+ *  @param Start    Transmission time of the command in microseconds since boot
+ *  @param isTimeout #true when the command has timed out
+ */
+void RAK3172_Timeout_Record(const RAK3172_t& p_Device, RAK3172_TimeoutClass_t Class, int64_t Start, bool isTimeout);
+
+#endif /* RAK3172_TIMEOUT_H_ */
@@ -0,0 +1,296 @@
+ /*
+ * rak3172_trace.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Command latency trace for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <sdkconfig.h>
+
+#ifdef CONFIG_RAK3172_TRACE
+
+#include <new>
+#include <algorithm>
+#include <string.h>
+
+#include "rak3172_trace.h"
+
+/** @brief Number of records in the trace ring buffer.
+ */
+#define RAK3172_TRACE_SLOTS                     (CONFIG_RAK3172_TRACE_SIZE + 1)
+
+/** @brief          Get the latency bucket of a latency.
+ *  @param Latency  Latency in us
+ *  @return         Bucket index
+ */
+static uint32_t RAK3172_Trace_GetBucket(uint32_t Latency)
+{
+    uint32_t Bucket;
+
+    Bucket = 0;
+    while((Latency != 0) && (Bucket < (RAK3172_TRACE_BUCKETS - 1)))
+    {
+        Latency >>= 1;
+        Bucket++;
+    }
+
+    return Bucket;
+}
+
+/** @brief          Get the histogram of a command. A new histogram is assigned when the command isn´t tracked yet.
+ *  @param p_Trace  Pointer to trace object
+ *  @param p_Command Zero terminated command name
+ *  @return         Pointer to histogram or NULL when all histograms are in use
+ */
+static RAK3172_TraceHistogram_t* RAK3172_Trace_GetHistogram(RAK3172_Trace_t* p_Trace, const char* p_Command)
+{
+    for(uint32_t i = 0; i < CONFIG_RAK3172_TRACE_COMMANDS; i++)
+    {
+        RAK3172_TraceHistogram_t* Histogram = &p_Trace->Histograms[i];
+
+        if(Histogram->Command[0] == '\0')
+        {
+            strcpy(Histogram->Command, p_Command);
+
+            return Histogram;
+        }
+        else if(strcmp(Histogram->Command, p_Command) == 0)
+        {
+            return Histogram;
+        }
+    }
+
+    return NULL;
+}
+
+RAK3172_Error_t RAK3172_Trace_Init(RAK3172_t& p_Device)
+{
+    if(p_Device.Internal.Trace != NULL)
+    {
+        return RAK3172_ERR_OK;
+    }
+
+    p_Device.Internal.Trace = new(std::nothrow) RAK3172_Trace_t();
+    if(p_Device.Internal.Trace == NULL)
+    {
+        return RAK3172_ERR_NO_MEM;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+void RAK3172_Trace_Deinit(RAK3172_t& p_Device)
+{
+    delete p_Device.Internal.Trace;
+    p_Device.Internal.Trace = NULL;
+}
+
+void RAK3172_Trace_Begin(const RAK3172_t& p_Device, std::string_view Command, int64_t Sent)
+{
+    size_t Length;
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if(Trace == NULL)
+    {
+        return;
+    }
+
+    // Only store the name of the command to keep keys and payloads out of the trace.
+    Length = Command.find('=');
+    if(Length == std::string_view::npos)
+    {
+        Length = Command.size();
+    }
+    else if(Command.substr(Length) == "=?")
+    {
+        Length += 2;
+    }
+    else
+    {
+        Length += 1;
+    }
+    Length = std::min(Length, static_cast<size_t>(RAK3172_TRACE_COMMAND_SIZE - 1));
+
+    memcpy(Trace->Current.Command, Command.data(), Length);
+    Trace->Current.Command[Length] = '\0';
+    Trace->Current.Sent = Sent;
+    Trace->Current.FirstResponse = 0;
+    Trace->Current.Status = 0;
+    Trace->Current.BytesSent = Command.size() + 2;
+    Trace->Current.BytesReceived = 0;
+    Trace->Current.Result = RAK3172_ERR_OK;
+    Trace->isActive = true;
+}
+
+void RAK3172_Trace_Response(const RAK3172_t& p_Device, const RAK3172_Line_t* p_Line)
+{
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if((Trace == NULL) || (Trace->isActive == false))
+    {
+        return;
+    }
+
+    if(Trace->Current.FirstResponse == 0)
+    {
+        Trace->Current.FirstResponse = p_Line->Timestamp;
+    }
+
+    // The time of the last line is the status time when the command doesn´t time out.
+    Trace->Current.Status = p_Line->Timestamp;
+    Trace->Current.BytesReceived += p_Line->Length + 2;
+}
+
+void RAK3172_Trace_End(const RAK3172_t& p_Device, RAK3172_Error_t Result)
+{
+    uint32_t Head;
+    RAK3172_TraceHistogram_t* Histogram;
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if((Trace == NULL) || (Trace->isActive == false))
+    {
+        return;
+    }
+
+    Trace->isActive = false;
+    Trace->Current.Result = Result;
+    if(Result == RAK3172_ERR_TIMEOUT)
+    {
+        Trace->Current.Status = 0;
+    }
+
+    Histogram = RAK3172_Trace_GetHistogram(Trace, Trace->Current.Command);
+    if(Histogram == NULL)
+    {
+        Trace->Untracked++;
+    }
+    else if(Trace->Current.Status == 0)
+    {
+        Histogram->Timeouts++;
+    }
+    else
+    {
+        uint32_t Latency;
+
+        Latency = static_cast<uint32_t>(std::max<int64_t>(Trace->Current.Status - Trace->Current.Sent, 0));
+
+        Histogram->Count++;
+        Histogram->Sum += Latency;
+        Histogram->Max = std::max(Histogram->Max, Latency);
+        Histogram->Buckets[RAK3172_Trace_GetBucket(Latency)]++;
+    }
+
+    // Single writer. The record is written before the head is published.
+    Head = Trace->Head.load(std::memory_order_relaxed);
+    Trace->Records[Head % RAK3172_TRACE_SLOTS] = Trace->Current;
+    Trace->Head.store(Head + 1, std::memory_order_release);
+}
+
+RAK3172_Error_t RAK3172_GetTrace(const RAK3172_t& p_Device, RAK3172_TraceRecord_t* const p_Records, size_t Size, size_t* const p_Count)
+{
+    uint32_t Head;
+    uint32_t First;
+    uint32_t Valid;
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if((p_Records == NULL) || (p_Count == NULL))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+    else if(Trace == NULL)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    Head = Trace->Head.load(std::memory_order_acquire);
+    Size = std::min(Size, static_cast<size_t>(std::min<uint32_t>(Head, CONFIG_RAK3172_TRACE_SIZE)));
+    First = Head - Size;
+
+    for(size_t i = 0; i < Size; i++)
+    {
+        p_Records[i] = Trace->Records[(First + i) % RAK3172_TRACE_SLOTS];
+    }
+
+    // Records which were overwritten by the writer during the copy are dropped. Record i is overwritten by record i + RAK3172_TRACE_SLOTS.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    Head = Trace->Head.load(std::memory_order_relaxed);
+    Valid = (Head > CONFIG_RAK3172_TRACE_SIZE) ? (Head - CONFIG_RAK3172_TRACE_SIZE) : 0;
+    if(Valid > First)
+    {
+        size_t Dropped;
+
+        Dropped = std::min(static_cast<size_t>(Valid - First), Size);
+        memmove(p_Records, p_Records + Dropped, (Size - Dropped) * sizeof(RAK3172_TraceRecord_t));
+        Size -= Dropped;
+    }
+
+    *p_Count = Size;
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_GetLatencyHistograms(const RAK3172_t& p_Device, RAK3172_TraceHistogram_t* const p_Histograms, size_t Size, size_t* const p_Count)
+{
+    size_t Count;
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if((p_Histograms == NULL) || (p_Count == NULL))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+    else if(Trace == NULL)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    Count = 0;
+    for(uint32_t i = 0; (i < CONFIG_RAK3172_TRACE_COMMANDS) && (Count < Size); i++)
+    {
+        if(Trace->Histograms[i].Command[0] == '\0')
+        {
+            break;
+        }
+
+        p_Histograms[Count++] = Trace->Histograms[i];
+    }
+
+    *p_Count = Count;
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_ResetTrace(const RAK3172_t& p_Device)
+{
+    RAK3172_Trace_t* Trace = p_Device.Internal.Trace;
+
+    if(Trace == NULL)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    memset(Trace->Records, 0, sizeof(Trace->Records));
+    memset(Trace->Histograms, 0, sizeof(Trace->Histograms));
+    Trace->Untracked = 0;
+    Trace->isActive = false;
+    Trace->Head.store(0, std::memory_order_release);
+
+    RAK3172_Release(p_Device);
+
+    return RAK3172_ERR_OK;
+}
+
+#endif
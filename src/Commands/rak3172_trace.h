@@ -0,0 +1,84 @@
+ /*
+ * rak3172_trace.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Command latency trace for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_TRACE_H_
+#define RAK3172_TRACE_H_
+
+#include <string_view>
+
+#include "rak3172.h"
+
+#ifdef CONFIG_RAK3172_TRACE
+    /** @brief          Allocate the command trace.
+     *  @param p_Device RAK3172 device object
+     *  @return         RAK3172_ERR_OK when successful
+     *                  RAK3172_ERR_NO_MEM when the trace cannot be allocated
+     */
+    RAK3172_Error_t RAK3172_Trace_Init(RAK3172_t& p_Device);
+
+    /** @brief          Free the command trace.
+     *  @param p_Device RAK3172 device object
+     */
+    void RAK3172_Trace_Deinit(RAK3172_t& p_Device);
+
+    /** @brief          Start the trace of a command.
+     *                  NOTE: Must be called with the device lock.
+     *  @param p_Device RAK3172 device object
+     *  @param Command  RAK3172 command without line ending. Only the name of the command is stored
+     *  @param Sent     Transmission time of the command in microseconds since boot
+     */
+    void RAK3172_Trace_Begin(const RAK3172_t& p_Device, std::string_view Command, int64_t Sent);
+
+    /** @brief          Add a received line to the trace of the running command.
+     *                  NOTE: Must be called with the device lock.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to received line
+     */
+    void RAK3172_Trace_Response(const RAK3172_t& p_Device, const RAK3172_Line_t* p_Line);
+
+    /** @brief          Finish the trace of the running command and store the record.
+     *                  NOTE: Must be called with the device lock. The status time of the record is set by the last line of a successful command.
+     *  @param p_Device RAK3172 device object
+     *  @param Result   Command result
+     */
+    void RAK3172_Trace_End(const RAK3172_t& p_Device, RAK3172_Error_t Result);
+#else
+    static inline RAK3172_Error_t RAK3172_Trace_Init(RAK3172_t& p_Device)
+    {
+        return RAK3172_ERR_OK;
+    }
+
+    static inline void RAK3172_Trace_Deinit(RAK3172_t& p_Device)
+    {
+    }
+
+    static inline void RAK3172_Trace_Begin(const RAK3172_t& p_Device, std::string_view Command, int64_t Sent)
+    {
+    }
+
+    static inline void RAK3172_Trace_Response(const RAK3172_t& p_Device, const RAK3172_Line_t* p_Line)
+    {
+    }
+
+    static inline void RAK3172_Trace_End(const RAK3172_t& p_Device, RAK3172_Error_t Result)
+    {
+    }
+#endif
+
+#endif /* RAK3172_TRACE_H_ */
@@ -0,0 +1,604 @@
+ /*
+ * rak3172_events.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Event handling for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <sdkconfig.h>
+
+#include <string.h>
+
+#include "rak3172_events.h"
+
+#include "../Parser/rak3172_rx.h"
+#include "../Parser/rak3172_classifier.h"
+#include "../Arch/Logging/rak3172_logging.h"
+
+/** @brief Event handler function definition.
+ */
+typedef void (*RAK3172_EventHandler_t)(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset);
+
+/** @brief Event dispatch table entry.
+ */
+typedef struct
+{
+    RAK3172_Mode_t Mode;                /**< Device mode in which the handler is active. */
+    RAK3172_EventHandler_t Handler;     /**< Handler function or NULL when the event is ignored. */
+} RAK3172_EventEntry_t;
+
+#ifdef CONFIG_RAK3172_MODE_WITH_LORAWAN
+    #define RAK3172_LORAWAN_HANDLER(Handler)        {RAK_MODE_LORAWAN, Handler}
+#else
+    #define RAK3172_LORAWAN_HANDLER(Handler)        {RAK_MODE_LORAWAN, NULL}
+#endif
+
+#ifdef CONFIG_RAK3172_MODE_WITH_P2P
+    #define RAK3172_P2P_HANDLER(Handler)            {RAK_MODE_P2P, Handler}
+#else
+    #define RAK3172_P2P_HANDLER(Handler)            {RAK_MODE_P2P, NULL}
+#endif
+
+static const char* TAG      = "RAK3172_Events";
+
+/** @brief          Pass an event to all subscribers of the event.
+ *  @param p_Device RAK3172 device object
+ *  @param Event    Event type
+ *  @param p_Frame  Pointer to received message or NULL when the event isn´t a receive event
+ */
+static void RAK3172_Events_Notify(RAK3172_t& p_Device, RAK3172_Event_t Event, const RAK3172_RxFrame_t* p_Frame)
+{
+    for(uint8_t i = 0; i < CONFIG_RAK3172_EVENT_SUBSCRIPTIONS; i++)
+    {
+        const RAK3172_Subscription_t* Subscription;
+
+        Subscription = &p_Device.Internal.Subscriptions[i];
+        if(__atomic_load_n(&Subscription->Event, __ATOMIC_ACQUIRE) != Event)
+        {
+            continue;
+        }
+
+        if(Subscription->Callback != NULL)
+        {
+            Subscription->Callback(Event, p_Frame, Subscription->p_Arg);
+        }
+        else if(Subscription->Queue != NULL)
+        {
+            RAK3172_EventMsg_t Message;
+
+            Message.Event = Event;
+            if(p_Frame != NULL)
+            {
+                Message.Timestamp = p_Frame->Info.Timestamp;
+                Message.Frame.Info = p_Frame->Info;
+                memcpy(Message.Frame.Payload, p_Frame->Payload, p_Frame->Info.Length);
+            }
+            else
+            {
+                Message.Timestamp = p_Device.Internal.LineTimestamp;
+                Message.Frame.Info.Length = 0;
+            }
+
+            if(xQueueSend(Subscription->Queue, &Message, 0) != pdPASS)
+            {
+                RAK3172_LOGW(TAG, "Event queue full. Drop event %u!", Event);
+
+                p_Device.Internal.Stats.EventDropped++;
+            }
+        }
+    }
+}
+
+/** @brief          Add a subscription to the device object.
+ *  @param p_Device RAK3172 device object
+ *  @param Event    Event type
+ *  @param Callback Event callback or NULL
+ *  @param Queue    Event queue or NULL
+ *  @param p_Arg    User argument for the callback
+ *  @return         RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_Events_Add(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback, QueueHandle_t Queue, void* p_Arg)
+{
+    if((Event == RAK_EVENT_NONE) || (Event == RAK_EVENT_UNKNOWN) || (Event >= RAK_EVENT_MAX) || ((Callback == NULL) && (Queue == NULL)))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    for(uint8_t i = 0; i < CONFIG_RAK3172_EVENT_SUBSCRIPTIONS; i++)
+    {
+        RAK3172_Subscription_t* Subscription;
+
+        Subscription = &p_Device.Internal.Subscriptions[i];
+        if(Subscription->Event != RAK_EVENT_NONE)
+        {
+            continue;
+        }
+
+        Subscription->Callback = Callback;
+        Subscription->Queue = Queue;
+        Subscription->p_Arg = p_Arg;
+
+        // The event task uses the event type to detect a valid subscription. So it must be set last.
+        __atomic_store_n(&Subscription->Event, Event, __ATOMIC_RELEASE);
+
+        return RAK3172_ERR_OK;
+    }
+
+    return RAK3172_ERR_NO_MEM;
+}
+
+/** @brief          Remove a subscription from the device object.
+ *  @param p_Device RAK3172 device object
+ *  @param Event    Event type
+ *  @param Callback Event callback or NULL
+ *  @param Queue    Event queue or NULL
+ *  @return         RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_Events_Remove(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback, QueueHandle_t Queue)
+{
+    for(uint8_t i = 0; i < CONFIG_RAK3172_EVENT_SUBSCRIPTIONS; i++)
+    {
+        RAK3172_Subscription_t* Subscription;
+
+        Subscription = &p_Device.Internal.Subscriptions[i];
+        if((Subscription->Event == Event) && (Subscription->Callback == Callback) && (Subscription->Queue == Queue))
+        {
+            __atomic_store_n(&Subscription->Event, RAK_EVENT_NONE, __ATOMIC_RELEASE);
+
+            return RAK3172_ERR_OK;
+        }
+    }
+
+    return RAK3172_ERR_INVALID_ARG;
+}
+
+#if(defined CONFIG_RAK3172_MODE_WITH_LORAWAN || defined CONFIG_RAK3172_MODE_WITH_P2P)
+    /** @brief          Pass a received frame to the receive queue. A full queue is handled with the configured overflow policy.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Frame  Pointer to receive frame object
+     */
+    static void RAK3172_Events_PushFrame(RAK3172_t& p_Device, const RAK3172_RxFrame_t* p_Frame)
+    {
+        #ifdef CONFIG_RAK3172_QUEUE_OVERFLOW_BLOCK
+            if(xQueueSend(p_Device.Internal.ReceiveQueue, p_Frame, pdMS_TO_TICKS(CONFIG_RAK3172_QUEUE_BLOCK_TIMEOUT)) == pdPASS)
+            {
+                RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_RX);
+
+                return;
+            }
+        #else
+            if(xQueueSend(p_Device.Internal.ReceiveQueue, p_Frame, 0) == pdPASS)
+            {
+                RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_RX);
+
+                return;
+            }
+
+            #ifdef CONFIG_RAK3172_QUEUE_OVERFLOW_DROP_OLDEST
+                RAK3172_RxFrame_t Oldest;
+
+                if(xQueueReceive(p_Device.Internal.ReceiveQueue, &Oldest, 0) == pdPASS)
+                {
+                    p_Device.Internal.Stats.ReceiveDropped++;
+
+                    if(xQueueSend(p_Device.Internal.ReceiveQueue, p_Frame, 0) == pdPASS)
+                    {
+                        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_RX);
+
+                        return;
+                    }
+                }
+            #endif
+        #endif
+
+        RAK3172_LOGW(TAG, "Receive queue full. Drop message!");
+
+        p_Device.Internal.Stats.ReceiveDropped++;
+    }
+#endif
+
+#ifdef CONFIG_RAK3172_MODE_WITH_LORAWAN
+    /** @brief          Handler for the LoRaWAN join event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnJoined(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        RAK3172_LOGD(TAG, " Joined...");
+
+        #ifndef CONFIG_RAK3172_USE_RUI3
+            p_Device.Internal.isJoinEvent = true;
+        #endif
+
+        p_Device.Internal.isBusy = false;
+        p_Device.LoRaWAN.isJoined = true;
+
+        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_JOIN | RAK3172_EVENT_BIT_IDLE);
+    }
+
+    /** @brief          Handler for the LoRaWAN join failed event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnJoinFailed(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        EventBits_t Bits;
+
+        RAK3172_LOGD(TAG, " Not joined...");
+        RAK3172_LOGD(TAG, "  Attempts left: %u", static_cast<unsigned int>(p_Device.LoRaWAN.AttemptCounter) - 1);
+
+        Bits = RAK3172_EVENT_BIT_JOIN;
+        if(p_Device.LoRaWAN.AttemptCounter > 0)
+        {
+            p_Device.LoRaWAN.AttemptCounter--;
+        }
+        else
+        {
+            p_Device.Internal.isBusy = false;
+            Bits |= RAK3172_EVENT_BIT_IDLE;
+        }
+
+        #ifndef CONFIG_RAK3172_USE_RUI3
+            p_Device.Internal.isBusy = false;
+            p_Device.Internal.isJoinEvent = true;
+            Bits |= RAK3172_EVENT_BIT_IDLE;
+        #endif
+
+        p_Device.LoRaWAN.isJoined = false;
+
+        RAK3172_Events_Signal(p_Device, Bits);
+    }
+
+    /** @brief          Handler for the LoRaWAN transmission done event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnTxDone(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        p_Device.Internal.isBusy = false;
+
+        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_IDLE);
+    }
+
+    /** @brief          Handler for the LoRaWAN confirmation events.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnConfirmFailed(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        p_Device.Internal.isBusy = false;
+        p_Device.LoRaWAN.ConfirmError = true;
+
+        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_IDLE);
+    }
+
+    /** @brief          Handler for the LoRaWAN confirmation events.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnConfirmOk(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        p_Device.Internal.isBusy = false;
+        p_Device.LoRaWAN.ConfirmError = false;
+
+        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_IDLE);
+    }
+
+    /** @brief          Pass a received LoRaWAN message to the receive queue.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Frame  Pointer to receive frame object
+     */
+    static void RAK3172_Events_Deliver(RAK3172_t& p_Device, const RAK3172_RxFrame_t* p_Frame)
+    {
+        RAK3172_LOGD(TAG, "RSSI: %i", p_Frame->Info.RSSI);
+        RAK3172_LOGD(TAG, "SNR: %i", p_Frame->Info.SNR);
+        RAK3172_LOGD(TAG, "Port: %u", p_Frame->Info.Port);
+        RAK3172_LOGD(TAG, "Channel: %u", p_Frame->Info.Group);
+        RAK3172_LOGD(TAG, "Length: %u", p_Frame->Info.Length);
+        RAK3172_LOGD(TAG, "Multicast: %u", p_Frame->Info.isMulticast);
+
+        RAK3172_Events_Notify(p_Device, RAK_EVENT_RX, p_Frame);
+        RAK3172_Events_PushFrame(p_Device, p_Frame);
+    }
+
+    /** @brief          Handler for the LoRaWAN receive event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnReceive(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        RAK3172_RxFrame_t Received;
+
+        // Formats documentation:
+        //  RUI3        +EVT:RX_1:-70:8:UNICAST:1:4865
+        //  FW 1.03     +EVT:RX_1, RSSI -89, SNR 4
+        //              +EVT:1:4865
+
+        memset(&Received.Info, 0, sizeof(RAK3172_RxInfo_t));
+        Received.Info.Timestamp = p_Device.Internal.LineTimestamp;
+
+        // Get the channel number from the "RX_x" part of the response.
+        if(p_Line[Offset] == '1')
+        {
+            Received.Info.Group = RAK_RX_GROUP_1;
+        }
+        else if(p_Line[Offset] == '2')
+        {
+            Received.Info.Group = RAK_RX_GROUP_2;
+        }
+        else if(p_Line[Offset] == 'B')
+        {
+            Received.Info.Group = RAK_RX_GROUP_B;
+        }
+        else if(p_Line[Offset] == 'C')
+        {
+            Received.Info.Group = RAK_RX_GROUP_C;
+        }
+
+        Offset++;
+        if(RAK3172_Rx_ParseHeader(p_Line, Length, &Offset, &Received.Info) == false)
+        {
+            RAK3172_LOGE(TAG, "Invalid receive event!");
+
+            p_Device.Internal.Stats.ParseErrors++;
+
+            return;
+        }
+
+        #ifdef CONFIG_RAK3172_USE_RUI3
+            if(RAK3172_Rx_ParsePayload(p_Line, Length, Offset, true, &Received) == false)
+            {
+                RAK3172_LOGE(TAG, "Invalid receive payload!");
+
+                p_Device.Internal.Stats.ParseErrors++;
+
+                return;
+            }
+
+            RAK3172_Events_Deliver(p_Device, &Received);
+        #else
+            // The payload is stored in the next line. Keep the receive information until the next line is processed.
+            p_Device.Internal.PendingRx = Received.Info;
+            p_Device.Internal.isRxPending = true;
+        #endif
+    }
+
+    #ifndef CONFIG_RAK3172_USE_RUI3
+        /** @brief          Handler for the payload line of a receive event.
+         *  @param p_Device RAK3172 device object
+         *  @param p_Line   Pointer to line
+         *  @param Length   Length of the line
+         *  @return         #true when the line contains the payload
+         */
+        static bool RAK3172_Events_OnReceivePayload(RAK3172_t& p_Device, char* p_Line, size_t Length)
+        {
+            RAK3172_RxFrame_t Received;
+
+            p_Device.Internal.isRxPending = false;
+            Received.Info = p_Device.Internal.PendingRx;
+
+            RAK3172_LOGD(TAG, "Next line: %s", p_Line);
+
+            if(RAK3172_Rx_ParsePayload(p_Line, Length, 0, true, &Received) == false)
+            {
+                RAK3172_LOGE(TAG, "Invalid receive payload!");
+
+                p_Device.Internal.Stats.ParseErrors++;
+
+                return false;
+            }
+
+            RAK3172_Events_Deliver(p_Device, &Received);
+
+            return true;
+        }
+    #endif
+#endif
+
+#ifdef CONFIG_RAK3172_MODE_WITH_P2P
+    /** @brief          Handler for the LoRa P2P receive timeout event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnP2PTimeout(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        p_Device.P2P.isRxTimeout = true;
+
+        RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_RX_TIMEOUT);
+    }
+
+    /** @brief          Handler for the LoRa P2P receive event.
+     *  @param p_Device RAK3172 device object
+     *  @param p_Line   Pointer to line
+     *  @param Length   Length of the line
+     *  @param Offset   Offset of the first character after the event token
+     */
+    static void RAK3172_Events_OnP2PReceive(RAK3172_t& p_Device, char* p_Line, size_t Length, size_t Offset)
+    {
+        RAK3172_RxFrame_t Received;
+
+        // Formats documentation:
+        //  RUI3        +EVT:RXP2P:-50:10:4865
+
+        memset(&Received.Info, 0, sizeof(RAK3172_RxInfo_t));
+        Received.Info.Timestamp = p_Device.Internal.LineTimestamp;
+
+        if((RAK3172_Rx_ParseHeader(p_Line, Length, &Offset, &Received.Info) == false) ||
+           (RAK3172_Rx_ParsePayload(p_Line, Length, Offset, false, &Received) == false))
+        {
+            RAK3172_LOGE(TAG, "Invalid receive event!");
+
+            p_Device.Internal.Stats.ParseErrors++;
+
+            return;
+        }
+
+        RAK3172_LOGD(TAG, "RSSI: %i", Received.Info.RSSI);
+        RAK3172_LOGD(TAG, "SNR: %i", Received.Info.SNR);
+        RAK3172_LOGD(TAG, "Length: %u", Received.Info.Length);
+
+        RAK3172_Events_Notify(p_Device, RAK_EVENT_P2P_RX, &Received);
+        RAK3172_Events_PushFrame(p_Device, &Received);
+    }
+#endif
+
+/** @brief Event dispatch table. The table is indexed with the event type from the line classifier.
+ */
+static const RAK3172_EventEntry_t _RAK3172_Events_Handler[] = {
+    {RAK_MODE_LORAWAN, NULL},                                           /**< RAK_EVENT_NONE */
+    {RAK_MODE_LORAWAN, NULL},                                           /**< RAK_EVENT_RESTRICTED */
+    {RAK_MODE_LORAWAN, NULL},                                           /**< RAK_EVENT_UNKNOWN */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnJoined),                   /**< RAK_EVENT_JOINED */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnJoinFailed),               /**< RAK_EVENT_JOIN_FAILED */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnTxDone),                   /**< RAK_EVENT_TX_DONE */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnConfirmOk),                /**< RAK_EVENT_CONFIRMED_OK */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnConfirmFailed),            /**< RAK_EVENT_CONFIRMED_FAILED */
+    RAK3172_LORAWAN_HANDLER(RAK3172_Events_OnReceive),                  /**< RAK_EVENT_RX */
+    RAK3172_P2P_HANDLER(RAK3172_Events_OnP2PTimeout),                   /**< RAK_EVENT_P2P_RX_TIMEOUT */
+    RAK3172_P2P_HANDLER(RAK3172_Events_OnP2PReceive),                   /**< RAK_EVENT_P2P_RX */
+};
+
+static_assert((sizeof(_RAK3172_Events_Handler) / sizeof(_RAK3172_Events_Handler[0])) == RAK_EVENT_MAX, "Event dispatch table doesn´t match the event types!");
+
+bool RAK3172_Events_Process(RAK3172_t& p_Device, char* p_Line, size_t Length)
+{
+    size_t Offset;
+    RAK3172_Event_t Event;
+    const RAK3172_EventEntry_t* Entry;
+
+    #if((defined CONFIG_RAK3172_MODE_WITH_LORAWAN) && (!defined CONFIG_RAK3172_USE_RUI3))
+        // Firmware without RUI3 interface transmits the payload of a receive event in the next line.
+        if(p_Device.Internal.isRxPending && RAK3172_Events_OnReceivePayload(p_Device, p_Line, Length))
+        {
+            return true;
+        }
+    #endif
+
+    Offset = 0;
+    Event = RAK3172_Classifier_Classify(p_Line, Length, &Offset);
+
+    p_Device.Internal.isRestricted = (Event == RAK_EVENT_RESTRICTED);
+
+    if(Event == RAK_EVENT_NONE)
+    {
+        return false;
+    }
+
+    p_Device.Internal.EventTimestamps[Event] = p_Device.Internal.LineTimestamp;
+
+    if(Event == RAK_EVENT_RESTRICTED)
+    {
+        // The restricted message is also the response of the pending command.
+        RAK3172_Events_Notify(p_Device, Event, NULL);
+
+        return false;
+    }
+
+    RAK3172_LOGD(TAG, "Event: %s", p_Line);
+
+    // Unknown events and events of the other mode are passed on as regular lines.
+    Entry = &_RAK3172_Events_Handler[Event];
+    if((Entry->Handler == NULL) || (Entry->Mode != p_Device.Mode))
+    {
+        RAK3172_LOGD(TAG, "Unhandled event: %s", p_Line);
+
+        p_Device.Internal.Stats.EventUnhandled++;
+
+        return false;
+    }
+
+    Entry->Handler(p_Device, p_Line, Length, Offset);
+
+    // Receive events are passed to the subscribers by the handler, because only the handler knows the message.
+    if((Event != RAK_EVENT_RX) && (Event != RAK_EVENT_P2P_RX))
+    {
+        RAK3172_Events_Notify(p_Device, Event, NULL);
+    }
+
+    return true;
+}
+
+void RAK3172_Events_Signal(RAK3172_t& p_Device, EventBits_t Bits)
+{
+    if(p_Device.Internal.EventGroup != NULL)
+    {
+        xEventGroupSetBits(p_Device.Internal.EventGroup, Bits);
+    }
+}
+
+void RAK3172_Events_Clear(RAK3172_t& p_Device, EventBits_t Bits)
+{
+    if(p_Device.Internal.EventGroup != NULL)
+    {
+        xEventGroupClearBits(p_Device.Internal.EventGroup, Bits);
+    }
+}
+
+EventBits_t RAK3172_Events_Wait(RAK3172_t& p_Device, EventBits_t Bits, TickType_t Ticks)
+{
+    // Fall back to a plain delay when the driver isn´t initialized. The caller checks the state anyway.
+    if(p_Device.Internal.EventGroup == NULL)
+    {
+        vTaskDelay((Ticks == portMAX_DELAY) ? 1 : Ticks);
+
+        return 0;
+    }
+
+    return xEventGroupWaitBits(p_Device.Internal.EventGroup, Bits, pdTRUE, pdFALSE, Ticks) & Bits;
+}
+
+RAK3172_Error_t RAK3172_Events_Subscribe(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback, void* p_Arg)
+{
+    if(Callback == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    return RAK3172_Events_Add(p_Device, Event, Callback, NULL, p_Arg);
+}
+
+RAK3172_Error_t RAK3172_Events_SubscribeQueue(RAK3172_t& p_Device, RAK3172_Event_t Event, QueueHandle_t Queue)
+{
+    if(Queue == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    return RAK3172_Events_Add(p_Device, Event, NULL, Queue, NULL);
+}
+
+RAK3172_Error_t RAK3172_Events_Unsubscribe(RAK3172_t& p_Device, RAK3172_Event_t Event, RAK3172_EventCallback_t Callback)
+{
+    return RAK3172_Events_Remove(p_Device, Event, Callback, NULL);
+}
+
+RAK3172_Error_t RAK3172_Events_UnsubscribeQueue(RAK3172_t& p_Device, RAK3172_Event_t Event, QueueHandle_t Queue)
+{
+    return RAK3172_Events_Remove(p_Device, Event, NULL, Queue);
+}
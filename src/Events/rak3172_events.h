@@ -0,0 +1,72 @@
+ /*
+ * rak3172_events.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Event handling for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_EVENTS_H_
+#define RAK3172_EVENTS_H_
+
+#include "rak3172.h"
+
+/** @brief Event bit which is set when the device leaves the busy state.
+ */
+#define RAK3172_EVENT_BIT_IDLE                                  (1 << 0)
+
+/** @brief Event bit which is set when the module has reported the result of a join attempt.
+ */
+#define RAK3172_EVENT_BIT_JOIN                                  (1 << 1)
+
+/** @brief Event bit which is set when a message was put into the receive queue.
+ */
+#define RAK3172_EVENT_BIT_RX                                    (1 << 2)
+
+/** @brief Event bit which is set when the LoRa P2P receive window has timed out.
+ */
+#define RAK3172_EVENT_BIT_RX_TIMEOUT                            (1 << 3)
+
+/** @brief          Notify all tasks which are waiting for one of the given event bits.
+ *                  NOTE: The state in the device object must be updated before the bits are set.
+ *  @param p_Device RAK3172 device object
+ *  @param Bits     Event bits
+ */
+void RAK3172_Events_Signal(RAK3172_t& p_Device, EventBits_t Bits);
+
+/** @brief          Clear event bits before the operation that causes the event is started.
+ *  @param p_Device RAK3172 device object
+ *  @param Bits     Event bits
+ */
+void RAK3172_Events_Clear(RAK3172_t& p_Device, EventBits_t Bits);
+
+/** @brief          Block until one of the given event bits is set. The bits are cleared when the function returns.
+ *                  The caller must check the state in the device object after this function returns.
+ *  @param p_Device RAK3172 device object
+ *  @param Bits     Event bits
+ *  @param Ticks    Maximum time to wait in ticks
+ *  @return         Event bits which were set
+ */
+EventBits_t RAK3172_Events_Wait(RAK3172_t& p_Device, EventBits_t Bits, TickType_t Ticks);
+
+/** @brief          Process a line received from the module and update the device object when the line is an event.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Line   Pointer to zero terminated line without line ending
+ *  @param Length   Length of the line
+ *  @return         #true when the line was dispatched to an event handler. Regular lines, unknown events and events of the
+ *                  other mode return #false and must be handled as regular lines
+ */
+bool RAK3172_Events_Process(RAK3172_t& p_Device, char* p_Line, size_t Length);
+
+#endif /* RAK3172_EVENTS_H_ */
@@ -26,14 +26,8 @@
 
 #include "rak3172.h"
 
-#include "../../Private/rak3172_tools.h"
-
 #include "../../../Arch/rak3172_arch.h"
 
-/** @brief 
- */
-static RAK3172_AppTime_t _RAK3172_AppTime;
-
 static const char* TAG = "RAK3172_LoRaWAN_ClockSync";
 
 /** @brief LoRaWAN clock synchronization command identifier definitions.
@@ -53,36 +47,39 @@ typedef enum
 
 /** @brief              Receive a command from the server and extract the message and the command code.
  *  @param p_Device     RAK3172 device object
- *  @param p_Message    Pointer to received message
+ *  @param p_Buffer     Pointer to payload buffer. The buffer contains the payload without the command code
+ *  @param Size         Size of the payload buffer in bytes
+ *  @param p_Info       Pointer to receive information object. The length doesn´t include the command code
  *  @param p_Command    Pointer to command code
  *  @param Timeout      (Optional) Receive timeout in seconds
  *  @return             RAK3172_ERR_OK when successful
  */
-static RAK3172_Error_t RAK3172_LoRaWAN_Clock_ReceiveCommand(RAK3172_t& p_Device, RAK3172_Rx_t* p_Message, uint8_t* p_Command, uint32_t Timeout = 3)
+static RAK3172_Error_t RAK3172_LoRaWAN_Clock_ReceiveCommand(RAK3172_t& p_Device, uint8_t* const p_Buffer, size_t Size, RAK3172_RxInfo_t* const p_Info, uint8_t* p_Command, uint32_t Timeout = 3)
 {
     RAK3172_Error_t Error;
 
-    Error = RAK3172_LoRaWAN_Receive(p_Device, p_Message, Timeout);
+    Error = RAK3172_LoRaWAN_ReceiveBinary(p_Device, p_Buffer, Size, p_Info, Timeout);
     if(Error != RAK3172_ERR_OK)
     {
         return Error;
     }
 
     // Check if the port is valid.
-    if(p_Message->Port != CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PORT)
+    if(p_Info->Port != CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PORT)
     {
         return RAK3172_ERR_WRONG_PORT;
     }
 
-    // Only process the message when at least one byte (2 characters were received).
-    if(p_Message->Payload.size() < 2)
+    // Only process the message when at least one byte was received.
+    if(p_Info->Length < 1)
     {
         return RAK3172_ERR_INVALID_ARG;
     }
 
     // The first byte is always the command.
-    RAK3172_Tools_Hex2ASCII(p_Message->Payload.substr(0, 2), p_Command);
-    p_Message->Payload.erase(0, 2);
+    *p_Command = p_Buffer[0];
+    p_Info->Length--;
+    memmove(p_Buffer, &p_Buffer[1], p_Info->Length);
 
     return RAK3172_ERR_OK;
 }
@@ -93,7 +90,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_Clock_SetLocalTime(RAK3172_t& p_Device, struct t
     uint8_t Command;
     uint8_t Buffer[6];
     uint32_t Time;
-    RAK3172_Rx_t Message;
+    RAK3172_RxInfo_t Info;
     RAK3172_Class_t PreviousClass = RAK_CLASS_C;
     RAK3172_Error_t Error;
     time_t Dummy;
@@ -136,16 +133,16 @@ RAK3172_Error_t RAK3172_LoRaWAN_Clock_SetLocalTime(RAK3172_t& p_Device, struct t
     //      Bits 0-3:   TokenReq
     //      Bits 4:     AnsRequired
     //      Bits 5-7:   RFU
-    _RAK3172_AppTime.Param.Fields.AnsRequired = AnsRequired;
+    p_Device.LoRaWAN.AppTime.Param.Fields.AnsRequired = AnsRequired;
     Buffer[0] = RAK3172_CLOCK_CID_APP_TIME_REQ;
-    memcpy(&Buffer[1], reinterpret_cast<const void*>(&_RAK3172_AppTime), sizeof(_RAK3172_AppTime));
+    memcpy(&Buffer[1], reinterpret_cast<const void*>(&p_Device.LoRaWAN.AppTime), sizeof(p_Device.LoRaWAN.AppTime));
     if(RAK3172_LoRaWAN_Transmit(p_Device, CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PORT, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
     {
         Error = RAK3172_ERR_FAIL;
         goto RAK3172_LoRaWAN_Clock_SetLocalTime_Exit;
     }
 
-    if(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, &Message, &Command, Timeout) != RAK3172_ERR_OK)
+    if(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, Buffer, sizeof(Buffer), &Info, &Command, Timeout) != RAK3172_ERR_OK)
     {
         // We expect an answer, but we don´t get an answer.
         if(AnsRequired == true)
@@ -160,7 +157,9 @@ RAK3172_Error_t RAK3172_LoRaWAN_Clock_SetLocalTime(RAK3172_t& p_Device, struct t
     }
 
     // Check if the command is valid.
-    if(Command != RAK3172_CLOCK_CID_APP_TIME_ANS)
+    // Byte 0-3:    TimeCorrection
+    // Byte 4:      TokenAns
+    if((Command != RAK3172_CLOCK_CID_APP_TIME_ANS) || (Info.Length < 5))
     {
         Error = RAK3172_ERR_INVALID_ARG;
         goto RAK3172_LoRaWAN_Clock_SetLocalTime_Exit;
@@ -168,28 +167,25 @@ RAK3172_Error_t RAK3172_LoRaWAN_Clock_SetLocalTime(RAK3172_t& p_Device, struct t
 
     RAK3172_LOGD(TAG, "Received app time answer");
 
-    // Convert the response payload.
-    RAK3172_Tools_Hex2ASCII(Message.Payload, Buffer);
-
     // Check the TokenAns field.
     TokenAns = Buffer[4] & 0x0F;
     RAK3172_LOGD(TAG, "TokenAns: %u", static_cast<unsigned int>(TokenAns));
 
     // Discard the answer if the counter doesn´t match.
-    if(TokenAns != _RAK3172_AppTime.Param.Fields.TokenReq)
+    if(TokenAns != p_Device.LoRaWAN.AppTime.Param.Fields.TokenReq)
     {
         Error = RAK3172_ERR_OK;
         goto RAK3172_LoRaWAN_Clock_SetLocalTime_Exit;
     }
 
     // We received an answer. So we have to increase the TokenReq counter.
-    if(_RAK3172_AppTime.Param.Fields.TokenReq < 15)
+    if(p_Device.LoRaWAN.AppTime.Param.Fields.TokenReq < 15)
     {
-        _RAK3172_AppTime.Param.Fields.TokenReq++;
+        p_Device.LoRaWAN.AppTime.Param.Fields.TokenReq++;
     }
     else
     {
-        _RAK3172_AppTime.Param.Fields.TokenReq = 0;
+        p_Device.LoRaWAN.AppTime.Param.Fields.TokenReq = 0;
     }
 
     // Get the time from the buffer.
@@ -221,14 +217,14 @@ RAK3172_Error_t RAK3172_LoRaWAN_ClockSync_PackageVersion(RAK3172_t& p_Device)
 {
     uint8_t Command;
     uint8_t Buffer[3];
-    RAK3172_Rx_t Message;
+    RAK3172_RxInfo_t Info;
 
     if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, &Message, &Command));
+    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, Buffer, sizeof(Buffer), &Info, &Command));
     if(Command != RAK3172_CLOCK_CID_PACKAGE_VERSION_REQ)
     {
         return RAK3172_ERR_INVALID_ARG;
@@ -240,15 +236,15 @@ RAK3172_Error_t RAK3172_LoRaWAN_ClockSync_PackageVersion(RAK3172_t& p_Device)
     Buffer[1] = 1;
     Buffer[2] = CONFIG_RAK3172_MODE_LORAWAN_CLOCK_SYNC_PACKAGE_VERSION;
 
-    return RAK3172_LoRaWAN_Transmit(p_Device, Message.Port, Buffer, sizeof(Buffer));
+    return RAK3172_LoRaWAN_Transmit(p_Device, Info.Port, Buffer, sizeof(Buffer));
 }
 
 bool RAK3172_LoRaWAN_ClockSync_isForceResync(RAK3172_t& p_Device, uint8_t* p_NbTransmissions, RAK3172_MC_Group_t* p_Group, uint32_t Timeout)
 {
     bool Result = false;
     uint8_t Command;
-    uint8_t Buffer[1];
-    RAK3172_Rx_t Message;
+    uint8_t Buffer[2];
+    RAK3172_RxInfo_t Info;
     RAK3172_Class_t PreviousClass = RAK_CLASS_C;
     bool RestoreClass = false;
     RAK3172_Error_t Error;
@@ -284,7 +280,7 @@ bool RAK3172_LoRaWAN_ClockSync_isForceResync(RAK3172_t& p_Device, uint8_t* p_NbT
         }
     }
 
-    Error = RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, &Message, &Command, Timeout);
+    Error = RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, Buffer, sizeof(Buffer), &Info, &Command, Timeout);
     RAK3172_LOGI(TAG, "Error: 0x%X", static_cast<unsigned int>(Error));
     if(Error != RAK3172_ERR_OK)
     {
@@ -292,14 +288,13 @@ bool RAK3172_LoRaWAN_ClockSync_isForceResync(RAK3172_t& p_Device, uint8_t* p_NbT
         goto RAK3172_LoRaWAN_ClockSync_isForceResync_Exit;
     }
 
-    if(Command != RAK3172_CLOCK_CID_FORCE_RESYNC)
+    if((Command != RAK3172_CLOCK_CID_FORCE_RESYNC) || (Info.Length < 1))
     {
         Result = false;
         goto RAK3172_LoRaWAN_ClockSync_isForceResync_Exit;
     }
 
     RAK3172_LOGI(TAG, "Received force resync request");
-    RAK3172_Tools_Hex2ASCII(Message.Payload, Buffer);
 
     *p_NbTransmissions = Buffer[0] & 0x07;
 
@@ -323,7 +318,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_ClockSync_HandlePeriodicity(RAK3172_t& p_Device,
 {
     uint8_t Command;
     uint8_t Buffer[6];
-    RAK3172_Rx_t Message;
+    RAK3172_RxInfo_t Info;
 
     if(p_Period == NULL)
     {
@@ -334,16 +329,14 @@ RAK3172_Error_t RAK3172_LoRaWAN_ClockSync_HandlePeriodicity(RAK3172_t& p_Device,
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, &Message, &Command, Timeout));
-    if(Command != RAK3172_CLOCK_CID_PERIODICITY_REQ)
+    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_Clock_ReceiveCommand(p_Device, Buffer, sizeof(Buffer), &Info, &Command, Timeout));
+    if((Command != RAK3172_CLOCK_CID_PERIODICITY_REQ) || (Info.Length < 1))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
 
     RAK3172_LOGI(TAG, "App time periodicity request");
 
-    RAK3172_Tools_Hex2ASCII(Message.Payload, Buffer);
-
     *p_Period = Buffer[0] & 0x0F;
     RAK3172_LOGD(TAG, "Period: %u", static_cast<unsigned int>(*p_Period));
 
@@ -356,7 +349,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_ClockSync_HandlePeriodicity(RAK3172_t& p_Device,
     Buffer[4] = (Time >> 0) & 0xFF;
     Buffer[5] = (NotSupported << 0x00);
 
-    return RAK3172_LoRaWAN_Transmit(p_Device, Message.Port, Buffer, sizeof(Buffer));
+    return RAK3172_LoRaWAN_Transmit(p_Device, Info.Port, Buffer, sizeof(Buffer));
 }
 
 #endif
\ No newline at end of file
@@ -25,8 +25,6 @@
 
 #include "rak3172.h"
 
-#include "../../Private/rak3172_tools.h"
-
 #include "../../../Arch/rak3172_arch.h"
 
 #include "Semtech/FragDecoder.h"
@@ -74,9 +72,9 @@ static int8_t _RAK3172_LoRaWAN_FUOTA_FragDecoderRead(uint32_t Addr, uint8_t* p_D
 
 RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_t* p_Group, uint32_t Timeout)
 {
-    uint8_t* FragMemory;
+    uint8_t* FragMemory = NULL;
     uint32_t Now;
-    RAK3172_Rx_t Message;
+    RAK3172_RxInfo_t Info;
     RAK3172_Error_t Error;
     RAK3172_FragSetup_t FragSetup;
     RAK3172_Class_t originalClass = p_Device.LoRaWAN.Class;
@@ -106,16 +104,21 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
         }
     }
 
-    FragMemory = NULL;
+    memset(&FragSetup, 0, sizeof(RAK3172_FragSetup_t));
+
     Now = RAK3172_Timer_GetMilliseconds();
     while(true)
     {
         uint8_t Command;
+        uint8_t* Data;
+        size_t DataLength;
+        uint8_t Payload[CONFIG_RAK3172_UART_RX_PAYLOAD_SIZE];
 
         //RAK3172_WDT_Reset();
 
         Command = 0xFF;
-        Message.Port = 0xFF;
+        Info.Port = 0xFF;
+        Info.Length = 0;
 
         if((RAK3172_Timer_GetMilliseconds() - Now) > (Timeout * 1000UL))
         {
@@ -123,24 +126,26 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
             goto RAK3172_LoRaWAN_FUOTA_Run_Exit;
         }
 
-        Error = RAK3172_LoRaWAN_Receive(p_Device, &Message, 1);
+        Error = RAK3172_LoRaWAN_ReceiveBinary(p_Device, Payload, sizeof(Payload), &Info, 1);
         if(Error != RAK3172_ERR_OK)
         {
             //ESP_LOGE(TAG, "Cannot receive message! Error: 0x%04X", static_cast<unsigned int>(Error));
         }
 
         // Check if the port is valid.
-        if(Message.Port != CONFIG_RAK3172_MODE_LORAWAN_FUOTA_PORT)
+        if(Info.Port != CONFIG_RAK3172_MODE_LORAWAN_FUOTA_PORT)
         {
             continue;
         }
 
-        // Only process the message when at least one byte (2 characters were received).
-        if(Message.Payload.size() > 2)
+        // Only process the message when at least one byte was received. The first byte is always the command.
+        Data = NULL;
+        DataLength = 0;
+        if(Info.Length > 0)
         {
-            // The first byte is always the command.
-            RAK3172_Tools_Hex2ASCII(Message.Payload.substr(0, 2), &Command);
-            Message.Payload.erase(0, 2);
+            Command = Payload[0];
+            Data = &Payload[1];
+            DataLength = Info.Length - 1;
         }
 
         switch(Command)
@@ -154,7 +159,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
                 Buffer[0] = RAK3172_FOTA_CID_PACKAGE_VERSION_ANS;
                 Buffer[1] = 3;
                 Buffer[2] = CONFIG_RAK3172_MODE_LORAWAN_FUOTA_PACKAGE_VERSION;
-                if(RAK3172_LoRaWAN_Transmit(p_Device, Message.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
+                if(RAK3172_LoRaWAN_Transmit(p_Device, Info.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
                 {
                     Error = RAK3172_ERR_FAIL;
                     goto RAK3172_LoRaWAN_FUOTA_Run_Exit;
@@ -171,7 +176,14 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
 
                 RAK3172_LOGI(TAG, "Received fragmentation setup request");
 
-                RAK3172_Tools_Hex2ASCII(Message.Payload, reinterpret_cast<uint8_t*>(&FragSetup));
+                if(DataLength < sizeof(RAK3172_FragSetup_t))
+                {
+                    RAK3172_LOGW(TAG, "Invalid fragmentation setup request length: %u", static_cast<unsigned int>(DataLength));
+
+                    break;
+                }
+
+                memcpy(&FragSetup, Data, sizeof(RAK3172_FragSetup_t));
 
                 RAK3172_LOGI(TAG, "Session setup received...");
                 RAK3172_LOGI(TAG, " FragSession: %i", static_cast<unsigned int>(FragSetup.FragSession.Raw));
@@ -214,7 +226,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
 
                 Buffer[0] = RAK3172_FOTA_CID_FRAG_SETUP_ANS;
                 Buffer[1] = StatusBitMask;
-                if(RAK3172_LoRaWAN_Transmit(p_Device, Message.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
+                if(RAK3172_LoRaWAN_Transmit(p_Device, Info.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
                 {
                     Error = RAK3172_ERR_FAIL;
                     goto RAK3172_LoRaWAN_FUOTA_Run_Exit;
@@ -230,7 +242,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
 
                 RAK3172_LOGI(TAG, "Received fragmentation delete request");
 
-                RAK3172_Tools_Hex2ASCII(Message.Payload, &Status);
+                Status = (DataLength > 0) ? Data[0] : 0;
 
                 RAK3172_LOGI(TAG, " Status: %u", static_cast<unsigned int>(Status));
 
@@ -240,7 +252,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
 
                 Buffer[0] = RAK3172_FOTA_CID_FRAG_DELETE_ANS;
                 Buffer[1] = StatusBitMask;
-                if(RAK3172_LoRaWAN_Transmit(p_Device, Message.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
+                if(RAK3172_LoRaWAN_Transmit(p_Device, Info.Port, Buffer, sizeof(Buffer)) != RAK3172_ERR_OK)
                 {
                     Error = RAK3172_ERR_FAIL;
                 }
@@ -256,17 +268,27 @@ RAK3172_Error_t RAK3172_LoRaWAN_FUOTA_Run(RAK3172_t& p_Device, RAK3172_MC_Group_
                 uint8_t FragIndex;
                 uint8_t Buffer[2];
                 uint16_t N;
-                std::string Index;
 
-                Index = Message.Payload.substr(0, 4);
-                Message.Payload.erase(0, 4);
+                if((FragMemory == NULL) || (DataLength < sizeof(Buffer)))
+                {
+                    break;
+                }
 
-                RAK3172_Tools_Hex2ASCII(Index, Buffer);
+                memcpy(Buffer, Data, sizeof(Buffer));
+                Data += sizeof(Buffer);
+                DataLength -= sizeof(Buffer);
 
                 FragIndex = (Buffer[0] >> 6) & 0x03;
                 N = ((static_cast<uint16_t>(Buffer[0] & 0x3F)) << 6) | Buffer[1];
 
-                RAK3172_Tools_Hex2ASCII(Message.Payload, &FragMemory[(N - 1) * FragSetup.FragSize]);
+                if((N == 0) || (N > FragSetup.NbFrag) || (DataLength > FragSetup.FragSize))
+                {
+                    RAK3172_LOGW(TAG, "Invalid data fragment %u", N);
+
+                    break;
+                }
+
+                memcpy(&FragMemory[(N - 1) * FragSetup.FragSize], Data, DataLength);
                 Status = FragDecoderProcess(N, &FragMemory[(N - 1) * FragSetup.FragSize]);
 
                 RAK3172_LOGI(TAG, "Received data fragment %u", N);
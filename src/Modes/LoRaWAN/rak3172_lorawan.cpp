@@ -21,15 +21,195 @@
 
 #ifdef CONFIG_RAK3172_MODE_WITH_LORAWAN
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "../../Arch/rak3172_arch.h"
 
 #include "rak3172.h"
 
+#include "../Private/rak3172_tools.h"
+#include "../Private/rak3172_settings.h"
+#include "../../Parser/rak3172_number.h"
+#include "../../Events/rak3172_events.h"
+
+/** @brief Period in milliseconds for calling the wait hook while a task is waiting for an event.
+ */
+#define RAK3172_LORAWAN_HOOK_PERIOD                             20
+
 static const char* TAG = "RAK3172_LoRaWAN";
 
+/** @brief LoRaWAN settings.
+ *         Command, mode, minimum, maximum, scale, shadow flag
+ */
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Retries                = { "AT+RETY=",     RAK_SETTING_LORAWAN, 0,         7,                   1,      RAK_SHADOW_RETRIES };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_PNM                    = { "AT+PNM=",      RAK_SETTING_LORAWAN, 0,         1,                   1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Confirmation           = { "AT+CFM=",      RAK_SETTING_LORAWAN, 0,         1,                   1,      RAK_SHADOW_CONFIRMATION };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_ConfirmationStatus     = { "AT+CFS=",      RAK_SETTING_LORAWAN, 0,         1,                   1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Band                   = { "AT+BAND=",     RAK_SETTING_LORAWAN, 0,         RAK_BAND_AS923,      1,      RAK_SHADOW_BAND };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_TxPwr                  = { "AT+TXP=",      RAK_SETTING_LORAWAN, 0,         15,                  1,      RAK_SHADOW_TX_PWR };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_DataRate               = { "AT+DR=",       RAK_SETTING_LORAWAN, 0,         RAK_DR_7,            1,      RAK_SHADOW_DATARATE };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_ADR                    = { "AT+ADR=",      RAK_SETTING_LORAWAN, 0,         1,                   1,      RAK_SHADOW_ADR };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_JoinMode               = { "AT+NJM=",      RAK_SETTING_LORAWAN, 0,         1,                   1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX2Freq                = { "AT+RX2FQ=",    RAK_SETTING_LORAWAN, 0,         UINT32_MAX,          1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_SNR                    = { "AT+SNR=",      RAK_SETTING_LORAWAN, INT8_MIN,  INT8_MAX,            1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RSSI                   = { "AT+RSSI=",     RAK_SETTING_LORAWAN, INT8_MIN,  INT8_MAX,            1,      0 };
+static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Duty                   = { "AT+DUTYTIME=", RAK_SETTING_LORAWAN, 0,         UINT8_MAX,           1,      0 };
+#ifdef CONFIG_RAK3172_USE_RUI3
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Join1Delay         = { "AT+JN1DL=",    RAK_SETTING_LORAWAN, 1,         14,                  1,      RAK_SHADOW_JOIN1_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Join2Delay         = { "AT+JN2DL=",    RAK_SETTING_LORAWAN, 2,         15,                  1,      RAK_SHADOW_JOIN2_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX1Delay           = { "AT+RX1DL=",    RAK_SETTING_LORAWAN, 1,         15,                  1,      RAK_SHADOW_RX1_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX2Delay           = { "AT+RX2DL=",    RAK_SETTING_LORAWAN, 2,         16,                  1,      RAK_SHADOW_RX2_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX2DataRate        = { "AT+RX2DR=",    RAK_SETTING_LORAWAN, 0,         15,                  1,      0 };
+#else
+    // The module firmware without RUI3 uses milliseconds for the delays.
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Join1Delay         = { "AT+JN1DL=",    RAK_SETTING_LORAWAN, 0,         UINT32_MAX / 1000,   1000,   RAK_SHADOW_JOIN1_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Join2Delay         = { "AT+JN2DL=",    RAK_SETTING_LORAWAN, 0,         UINT32_MAX / 1000,   1000,   RAK_SHADOW_JOIN2_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX1Delay           = { "AT+RX1DL=",    RAK_SETTING_LORAWAN, 0,         UINT32_MAX / 1000,   1000,   RAK_SHADOW_RX1_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX2Delay           = { "AT+RX2DL=",    RAK_SETTING_LORAWAN, 0,         UINT32_MAX / 1000,   1000,   RAK_SHADOW_RX2_DELAY };
+    static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_RX2DataRate        = { "AT+RX2DR=",    RAK_SETTING_LORAWAN, 0,         7,                   1,      0 };
+#endif
+
+/** @brief          Get the maximum time for waiting for an event.
+ *  @param on_Wait  Wait hook or NULL
+ *  @return         Wait time in ticks
+ */
+static inline TickType_t RAK3172_LoRaWAN_WaitTicks(RAK3172_Wait_t on_Wait)
+{
+    // The hook must be called periodically. Otherwise the task can block until the event arrives.
+    return (on_Wait == NULL) ? portMAX_DELAY : pdMS_TO_TICKS(RAK3172_LORAWAN_HOOK_PERIOD);
+}
+
+/** @brief          Block until the device leaves the busy state.
+ *  @param p_Device RAK3172 device object
+ *  @param on_Wait  Wait hook or NULL
+ */
+static void RAK3172_LoRaWAN_WaitIdle(RAK3172_t& p_Device, RAK3172_Wait_t on_Wait)
+{
+    while(p_Device.Internal.isBusy)
+    {
+        if(on_Wait != NULL)
+        {
+            on_Wait();
+        }
+
+        RAK3172_PwrMagnt_EnterLightSleep(p_Device);
+
+        RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_IDLE, RAK3172_LoRaWAN_WaitTicks(on_Wait));
+    }
+}
+
+/** @brief          Convert a transmit power into the transmit power index of the module.
+ *  @param Band     LoRaWAN frequency band
+ *  @param TxPwr    Tx power in dB
+ *  @return         Tx power index
+ */
+static uint8_t RAK3172_LoRaWAN_GetTxPwrIndex(RAK3172_Band_t Band, uint8_t TxPwr)
+{
+    uint8_t TxPwrIndex = 0;
+
+    // For EU868 the maximum transmit power is +16 dB EIRP.
+    if(Band == RAK_BAND_EU868)
+    {
+        const uint8_t EIRP = 16;
+
+        if(TxPwr >= EIRP)
+        {
+            TxPwrIndex = 0;
+        }
+        else if(TxPwr < (EIRP - 14))
+        {
+            TxPwrIndex = 10;
+        }
+        else
+        {
+            TxPwrIndex = static_cast<uint8_t>((EIRP - TxPwr) / 2);
+        }
+    }
+    // For US915 the maximum transmit power is +30 dBm conducted power.
+    else if(Band == RAK_BAND_US915)
+    {
+        const uint8_t MaxPwr = 30;
+
+        if(TxPwr >= MaxPwr)
+        {
+            TxPwrIndex = 0;
+        }
+        else if(TxPwr < 10)
+        {
+            TxPwrIndex = 10;
+        }
+        else
+        {
+            TxPwrIndex = static_cast<uint8_t>((MaxPwr - TxPwr) / 2);
+        }
+    }
+    else
+    {
+        RAK3172_LOGE(TAG, "Tx power is not implemented for the selected frequency band!");
+    }
+
+    return TxPwrIndex;
+}
+
+/** @brief          Switch the module into LoRaWAN mode and stop an ongoing joining process.
+ *  @param p_Device RAK3172 device object
+ *  @return         RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_LoRaWAN_Prepare(RAK3172_t& p_Device)
+{
+    RAK3172_ERROR_CHECK(RAK3172_SetMode(p_Device, RAK_MODE_LORAWAN));
+
+    // Stop an ongoing joining process.
+    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_StopJoin(p_Device));
+    p_Device.LoRaWAN.isJoined = RAK3172_LoRaWAN_isJoined(p_Device, true);
+
+    p_Device.Internal.isBusy = false;
+
+    return RAK3172_ERR_OK;
+}
+
+/** @brief          Compare a number returned by the module with the requested value.
+ *  @param Result   Result of the query
+ *  @param Value    Value returned by the module
+ *  @param Expected Requested value
+ *  @param Base     Number base of the returned value
+ *  @return         #true when the module uses the requested value
+ */
+static bool RAK3172_LoRaWAN_isValueEqual(RAK3172_Error_t Result, const std::string& Value, int64_t Expected, uint8_t Base = 10)
+{
+    int64_t Number;
+
+    return (Result == RAK3172_ERR_OK) && RAK3172_Number_Parse(Value, INT32_MIN, UINT32_MAX, &Number, Base) && (Number == Expected);
+}
+
+/** @brief          Compare a key returned by the module with a binary key.
+ *  @param Result   Result of the key query
+ *  @param Value    Value returned by the module
+ *  @param p_Key    Pointer to key
+ *  @param Length   Length of the key in bytes
+ *  @return         #true when the module uses the given key
+ */
+static bool RAK3172_LoRaWAN_isKeyEqual(RAK3172_Error_t Result, const std::string& Value, const uint8_t* p_Key, size_t Length)
+{
+    RAK3172_Command_t Key;
+    std::string_view Hex;
+
+    if(Result != RAK3172_ERR_OK)
+    {
+        return false;
+    }
+
+    RAK3172_Command_Build(Key, RAK3172_Command_Hex(p_Key, Length, true));
+    Hex = RAK3172_Command_View(Key);
+
+    return (Value.length() == Hex.length()) && (strncasecmp(Value.c_str(), Hex.data(), Hex.length()) == 0);
+}
+
 RAK3172_Error_t RAK3172_LoRaWAN_Init(RAK3172_t& p_Device, uint8_t TxPwr, RAK3172_JoinMode_t JoinMode, const uint8_t* const p_Key1, const uint8_t* const p_Key2, const uint8_t* const p_Key3, RAK3172_Class_t Class, RAK3172_Band_t Band, RAK3172_SubBand_t Subband, bool UseADR, uint32_t Timeout)
 {
-    std::string Command;
+    RAK3172_Command_t Commands[4];
+    RAK3172_Error_t Error;
 
     if(((Class != RAK_CLASS_A) && (Class != RAK_CLASS_B) && (Class != RAK_CLASS_C)) || (p_Key1 == NULL) || (p_Key2 == NULL) || (p_Key3 == NULL))
     {
@@ -41,99 +221,266 @@ RAK3172_Error_t RAK3172_LoRaWAN_Init(RAK3172_t& p_Device, uint8_t TxPwr, RAK3172
     }
 
     RAK3172_LOGI(TAG, "Initialize module in LoRaWAN mode...");
-    RAK3172_ERROR_CHECK(RAK3172_SetMode(p_Device, RAK_MODE_LORAWAN));
 
-    // Stop an ongoing joining process.
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_StopJoin(p_Device));
-    p_Device.LoRaWAN.isJoined = RAK3172_LoRaWAN_isJoined(p_Device, true);
+    // Keep the device locked for the whole configuration sequence.
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
 
-    p_Device.Internal.isBusy = false;
+    Error = RAK3172_LoRaWAN_Prepare(p_Device);
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_LoRaWAN_Init_Exit;
+    }
+
+    // The independent settings are transmitted as a single batch.
+    RAK3172_Command_Build(Commands[0], "AT+CLASS=", static_cast<char>(Class));
+    RAK3172_Command_Build(Commands[1], "AT+ADR=", UseADR);
+    RAK3172_Command_Build(Commands[2], "AT+BAND=", static_cast<uint8_t>(Band));
+    RAK3172_Command_Build(Commands[3], "AT+NJM=", JoinMode);
+    Error = RAK3172_SendCommands(p_Device, Commands, sizeof(Commands) / sizeof(Commands[0]));
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_LoRaWAN_Init_Exit;
+    }
 
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetClass(p_Device, Class));
-	RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetADR(p_Device, UseADR));
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetBand(p_Device, Band));
+    p_Device.LoRaWAN.Class = Class;
+    p_Device.Internal.Shadow.Band = Band;
+    p_Device.Internal.Shadow.ADR = UseADR;
+    p_Device.Internal.Shadow.Valid &= ~(RAK_SHADOW_SUB_BAND | RAK_SHADOW_DATARATE | RAK_SHADOW_TX_PWR);
+    p_Device.Internal.Shadow.Valid |= RAK_SHADOW_CLASS | RAK_SHADOW_ADR | RAK_SHADOW_BAND;
 
     if(Subband != RAK_SUB_BAND_NONE)
     {
-        RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetSubBand(p_Device, Subband))
+        Error = RAK3172_LoRaWAN_SetSubBand(p_Device, Subband);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_Init_Exit;
+        }
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetTxPwr(p_Device, TxPwr));
-    RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetJoinMode(p_Device, JoinMode));
+    Error = RAK3172_LoRaWAN_SetTxPwr(p_Device, TxPwr);
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_LoRaWAN_Init_Exit;
+    }
 
     p_Device.LoRaWAN.Join = JoinMode;
     if(p_Device.LoRaWAN.Join == RAK_JOIN_OTAA)
     {
         RAK3172_LOGI(TAG, "Using OTAA mode");
 
-        return RAK3172_LoRaWAN_SetOTAAKeys(p_Device, p_Key1, p_Key2, p_Key3);
+        Error = RAK3172_LoRaWAN_SetOTAAKeys(p_Device, p_Key1, p_Key2, p_Key3);
     }
     else
     {
         RAK3172_LOGI(TAG, "Using ABP mode");
 
-        return RAK3172_LoRaWAN_SetABPKeys(p_Device, p_Key1, p_Key2, p_Key3);
+        Error = RAK3172_LoRaWAN_SetABPKeys(p_Device, p_Key1, p_Key2, p_Key3);
     }
 
-    return RAK3172_ERR_INVALID_ARG;
+RAK3172_LoRaWAN_Init_Exit:
+    RAK3172_Release(p_Device);
+
+    return Error;
 }
 
-RAK3172_Error_t RAK3172_LoRaWAN_SetOTAAKeys(const RAK3172_t& p_Device, const uint8_t* const p_DEVEUI, const uint8_t* const p_APPEUI, const uint8_t* const p_APPKEY)
+RAK3172_Error_t RAK3172_LoRaWAN_InitDiff(RAK3172_t& p_Device, uint8_t TxPwr, RAK3172_JoinMode_t JoinMode, const uint8_t* const p_Key1, const uint8_t* const p_Key2, const uint8_t* const p_Key3, RAK3172_Class_t Class, RAK3172_Band_t Band, RAK3172_SubBand_t Subband, bool UseADR, uint32_t* const p_Changed)
 {
-    std::string AppEUIString;
-    std::string DevEUIString;
-    std::string AppKeyString;
-
-    if((p_DEVEUI == NULL) || (p_APPEUI == NULL) || (p_APPKEY == NULL))
+    RAK3172_Command_t Queries[9];
+    RAK3172_Error_t Results[9];
+    std::string Values[9];
+    RAK3172_Command_t Commands[7];
+    size_t Count;
+    uint32_t Changed;
+    RAK3172_Error_t Error;
+    const uint8_t KeyLength[2][3] = {
+        {16, 16, 4},    // ABP: APPSKEY, NWKSKEY, DEVADDR
+        {8, 8, 16},     // OTAA: DEVEUI, APPEUI, APPKEY
+    };
+    const char* KeyCommand[2][3] = {
+        {"AT+APPSKEY", "AT+NWKSKEY", "AT+DEVADDR"},
+        {"AT+DEVEUI", "AT+APPEUI", "AT+APPKEY"},
+    };
+    const uint8_t* const p_Keys[3] = {p_Key1, p_Key2, p_Key3};
+
+    if(((Class != RAK_CLASS_A) && (Class != RAK_CLASS_B) && (Class != RAK_CLASS_C)) || (JoinMode > RAK_JOIN_OTAA) || (p_Key1 == NULL) || (p_Key2 == NULL) || (p_Key3 == NULL))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.LoRaWAN.Join != RAK_JOIN_OTAA)
+    else if(p_Device.Internal.isInitialized == false)
     {
         return RAK3172_ERR_INVALID_STATE;
     }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
+
+    RAK3172_LOGI(TAG, "Initialize module in LoRaWAN mode with the stored configuration...");
+
+    // Keep the device locked between reading back and writing the configuration.
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    Error = RAK3172_LoRaWAN_Prepare(p_Device);
+    if(Error != RAK3172_ERR_OK)
     {
-        return RAK3172_ERR_INVALID_MODE;
+        goto RAK3172_LoRaWAN_InitDiff_Exit;
+    }
+
+    // Read back the current configuration with a single batch. Settings which can´t be read are written again.
+    RAK3172_Command_Build(Queries[0], "AT+CLASS=?");
+    RAK3172_Command_Build(Queries[1], "AT+ADR=?");
+    RAK3172_Command_Build(Queries[2], "AT+BAND=?");
+    RAK3172_Command_Build(Queries[3], "AT+NJM=?");
+    RAK3172_Command_Build(Queries[4], "AT+MASK=?");
+    RAK3172_Command_Build(Queries[5], "AT+TXP=?");
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        RAK3172_Command_Build(Queries[6 + i], KeyCommand[JoinMode][i], "=?");
+    }
+
+    if(RAK3172_SendCommands(p_Device, Queries, sizeof(Queries) / sizeof(Queries[0]), Results, Values) == RAK3172_ERR_TIMEOUT)
+    {
+        Error = RAK3172_ERR_TIMEOUT;
+        goto RAK3172_LoRaWAN_InitDiff_Exit;
+    }
+
+    Changed = 0;
+    if((Results[0] != RAK3172_ERR_OK) || Values[0].empty() || (Values[0].at(0) != static_cast<char>(Class)))
+    {
+        Changed |= RAK_SHADOW_CLASS;
+    }
+
+    if(RAK3172_LoRaWAN_isValueEqual(Results[1], Values[1], UseADR) == false)
+    {
+        Changed |= RAK_SHADOW_ADR;
+    }
+
+    // The module loads the default channel mask and transmit power when the band is changed.
+    if(RAK3172_LoRaWAN_isValueEqual(Results[2], Values[2], Band) == false)
+    {
+        Changed |= RAK_SHADOW_BAND | RAK_SHADOW_TX_PWR;
+        if(Subband != RAK_SUB_BAND_NONE)
+        {
+            Changed |= RAK_SHADOW_SUB_BAND;
+        }
+    }
+
+    if(RAK3172_LoRaWAN_isValueEqual(Results[3], Values[3], JoinMode) == false)
+    {
+        Changed |= RAK_SHADOW_JOIN_MODE;
+    }
+
+    if(Subband != RAK_SUB_BAND_NONE)
+    {
+        uint32_t Mask;
+
+        Mask = (Subband == RAK_SUB_BAND_ALL) ? 0 : (1 << (Subband - 2));
+        if(RAK3172_LoRaWAN_isValueEqual(Results[4], Values[4], Mask, 16) == false)
+        {
+            Changed |= RAK_SHADOW_SUB_BAND;
+        }
+    }
+
+    if(RAK3172_LoRaWAN_isValueEqual(Results[5], Values[5], RAK3172_LoRaWAN_GetTxPwrIndex(Band, TxPwr)) == false)
+    {
+        Changed |= RAK_SHADOW_TX_PWR;
+    }
+
+    // Write the settings which differ from the requested configuration.
+    Count = 0;
+    if(Changed & RAK_SHADOW_CLASS)
+    {
+        RAK3172_Command_Build(Commands[Count++], "AT+CLASS=", static_cast<char>(Class));
+    }
+
+    if(Changed & RAK_SHADOW_ADR)
+    {
+        RAK3172_Command_Build(Commands[Count++], "AT+ADR=", UseADR);
+    }
+
+    if(Changed & RAK_SHADOW_BAND)
+    {
+        RAK3172_Command_Build(Commands[Count++], "AT+BAND=", static_cast<uint8_t>(Band));
+    }
+
+    if(Changed & RAK_SHADOW_JOIN_MODE)
+    {
+        RAK3172_Command_Build(Commands[Count++], "AT+NJM=", JoinMode);
+    }
+
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        if(RAK3172_LoRaWAN_isKeyEqual(Results[6 + i], Values[6 + i], p_Keys[i], KeyLength[JoinMode][i]) == false)
+        {
+            RAK3172_Command_Build(Commands[Count++], KeyCommand[JoinMode][i], '=', RAK3172_Command_Hex(p_Keys[i], KeyLength[JoinMode][i], true));
+            Changed |= RAK_SHADOW_KEYS;
+        }
+    }
+
+    RAK3172_LOGI(TAG, "     Changed settings: 0x%08X", static_cast<unsigned int>(Changed));
+
+    if(Count > 0)
+    {
+        Error = RAK3172_SendCommands(p_Device, Commands, Count);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_InitDiff_Exit;
+        }
     }
 
-    // Copy the keys from the buffer into a string.
-    char Buffer[3];
-    for(uint8_t i = 0; i < 8; i++)
+    p_Device.LoRaWAN.Class = Class;
+    p_Device.LoRaWAN.Join = JoinMode;
+    p_Device.Internal.Shadow.Band = Band;
+    p_Device.Internal.Shadow.ADR = UseADR;
+    p_Device.Internal.Shadow.Valid &= ~(RAK_SHADOW_SUB_BAND | RAK_SHADOW_DATARATE | RAK_SHADOW_TX_PWR);
+    p_Device.Internal.Shadow.Valid |= RAK_SHADOW_CLASS | RAK_SHADOW_ADR | RAK_SHADOW_BAND;
+
+    if(Changed & RAK_SHADOW_SUB_BAND)
     {
-        sprintf(Buffer, "%02X", p_APPEUI[i]);
-        AppEUIString += std::string(Buffer);
+        Error = RAK3172_LoRaWAN_SetSubBand(p_Device, Subband);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_InitDiff_Exit;
+        }
+    }
+    else if(Subband != RAK_SUB_BAND_NONE)
+    {
+        p_Device.Internal.Shadow.SubBand = Subband;
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_SUB_BAND;
+    }
 
-        sprintf(Buffer, "%02X", p_DEVEUI[i]);
-        DevEUIString += std::string(Buffer);
+    if(Changed & RAK_SHADOW_TX_PWR)
+    {
+        Error = RAK3172_LoRaWAN_SetTxPwr(p_Device, TxPwr);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_InitDiff_Exit;
+        }
+    }
+    else
+    {
+        p_Device.Internal.Shadow.TxPwrIndex = RAK3172_LoRaWAN_GetTxPwrIndex(Band, TxPwr);
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_TX_PWR;
     }
 
-    for(uint8_t i = 0; i < 16; i++)
+    if(p_Changed != NULL)
     {
-        sprintf(Buffer, "%02X", p_APPKEY[i]);
-        AppKeyString += std::string(Buffer);
+        *p_Changed = Changed;
     }
 
-    RAK3172_LOGD(TAG, "DEVEUI: %s - Size: %u", DevEUIString.c_str(), DevEUIString.length());
-    RAK3172_LOGD(TAG, "APPEUI: %s - Size: %u", AppEUIString.c_str(), AppEUIString.length());
-    RAK3172_LOGD(TAG, "APPKEY: %s - Size: %u", AppKeyString.c_str(), AppKeyString.length());
+    Error = RAK3172_ERR_OK;
+
+RAK3172_LoRaWAN_InitDiff_Exit:
+    RAK3172_Release(p_Device);
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+DEVEUI=" + DevEUIString));
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+APPEUI=" + AppEUIString));
-    return RAK3172_SendCommand(p_Device, "AT+APPKEY=" + AppKeyString);
+    return Error;
 }
 
-RAK3172_Error_t RAK3172_LoRaWAN_SetABPKeys(const RAK3172_t& p_Device, const uint8_t* const p_APPSKEY, const uint8_t* const p_NWKSKEY, const uint8_t* const p_DEVADDR)
+RAK3172_Error_t RAK3172_LoRaWAN_SetOTAAKeys(const RAK3172_t& p_Device, const uint8_t* const p_DEVEUI, const uint8_t* const p_APPEUI, const uint8_t* const p_APPKEY)
 {
-    std::string AppSKEYString;
-    std::string NwkSKEYString;
-    std::string DevADDRString;
+    RAK3172_Command_t Commands[3];
 
-    if((p_APPSKEY == NULL) || (p_NWKSKEY == NULL) || (p_DEVADDR == NULL))
+    if((p_DEVEUI == NULL) || (p_APPEUI == NULL) || (p_APPKEY == NULL))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.LoRaWAN.Join != RAK_JOIN_ABP)
+    else if(p_Device.LoRaWAN.Join != RAK_JOIN_OTAA)
     {
         return RAK3172_ERR_INVALID_STATE;
     }
@@ -142,75 +489,106 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetABPKeys(const RAK3172_t& p_Device, const uint
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    // Copy the keys from the buffer into a string.
-    char Buffer[3];
-    for(uint8_t i = 0; i < 16; i++)
-    {
-        sprintf(Buffer, "%02X", p_APPSKEY[i]);
-        AppSKEYString += std::string(Buffer);
+    RAK3172_Command_Build(Commands[0], "AT+DEVEUI=", RAK3172_Command_Hex(p_DEVEUI, 8, true));
+    RAK3172_Command_Build(Commands[1], "AT+APPEUI=", RAK3172_Command_Hex(p_APPEUI, 8, true));
+    RAK3172_Command_Build(Commands[2], "AT+APPKEY=", RAK3172_Command_Hex(p_APPKEY, 16, true));
 
-        sprintf(Buffer, "%02X", p_NWKSKEY[i]);
-        NwkSKEYString += std::string(Buffer);
-    }
+    return RAK3172_SendCommands(p_Device, Commands, sizeof(Commands) / sizeof(Commands[0]));
+}
+
+RAK3172_Error_t RAK3172_LoRaWAN_SetABPKeys(const RAK3172_t& p_Device, const uint8_t* const p_APPSKEY, const uint8_t* const p_NWKSKEY, const uint8_t* const p_DEVADDR)
+{
+    RAK3172_Command_t Commands[3];
 
-    for(uint8_t i = 0; i < 4; i++)
+    if((p_APPSKEY == NULL) || (p_NWKSKEY == NULL) || (p_DEVADDR == NULL))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+    else if(p_Device.LoRaWAN.Join != RAK_JOIN_ABP)
+    {
+        return RAK3172_ERR_INVALID_STATE;
+    }
+    else if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
-        sprintf(Buffer, "%02X", p_DEVADDR[i]);
-        DevADDRString += std::string(Buffer);
+        return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_LOGD(TAG, "APPSKEY: %s - Size: %u", AppSKEYString.c_str(), AppSKEYString.length());
-    RAK3172_LOGD(TAG, "NWKSKEY: %s - Size: %u", NwkSKEYString.c_str(), NwkSKEYString.length());
-    RAK3172_LOGD(TAG, "DEVADDR: %s - Size: %u", DevADDRString.c_str(), DevADDRString.length());
+    RAK3172_Command_Build(Commands[0], "AT+APPSKEY=", RAK3172_Command_Hex(p_APPSKEY, 16, true));
+    RAK3172_Command_Build(Commands[1], "AT+NWKSKEY=", RAK3172_Command_Hex(p_NWKSKEY, 16, true));
+    RAK3172_Command_Build(Commands[2], "AT+DEVADDR=", RAK3172_Command_Hex(p_DEVADDR, 4, true));
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+APPSKEY=" + AppSKEYString));
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+NWKSKEY=" + NwkSKEYString));
-    return RAK3172_SendCommand(p_Device, "AT+DEVADDR=" + DevADDRString);
+    return RAK3172_SendCommands(p_Device, Commands, sizeof(Commands) / sizeof(Commands[0]));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_StartJoin(RAK3172_t& p_Device, uint8_t Attempts, uint32_t Timeout, bool Block, bool EnableAutoJoin, uint8_t Interval, RAK3172_Wait_t on_Wait)
 {
+    RAK3172_Error_t Error;
     #ifdef CONFIG_RAK3172_USE_RUI3
-        uint32_t TimeNow;
+        unsigned long Start;
     #endif
 
     if(((Attempts == 0) && (Block == true)) || (Interval < 7))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.Internal.isBusy)
+    #ifndef CONFIG_RAK3172_USE_RUI3
+        else if(Block == false)
+        {
+            return RAK3172_ERR_INVALID_ARG;
+        }
+    #endif
+
+    // Keep the device locked for the whole join, so that the busy state and the join settings can´t be changed by
+    // other tasks.
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    if(p_Device.Internal.isBusy)
     {
-        return RAK3172_ERR_BUSY;
+        Error = RAK3172_ERR_BUSY;
+        goto RAK3172_LoRaWAN_StartJoin_Exit;
     }
     else if(p_Device.LoRaWAN.isJoined)
     {
-        return RAK3172_ERR_OK;
+        Error = RAK3172_ERR_OK;
+        goto RAK3172_LoRaWAN_StartJoin_Exit;
     }
     else if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
-        return RAK3172_ERR_INVALID_MODE;
+        Error = RAK3172_ERR_INVALID_MODE;
+        goto RAK3172_LoRaWAN_StartJoin_Exit;
     }
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        else if(Block == false)
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+JOIN=1:" + std::to_string(EnableAutoJoin) + ":" + std::to_string(Interval) + ":" + std::to_string(Attempts)));
 
+    // Reset the state before the join is started, because the join result can be processed by the event task before
+    // the command returns.
     #ifndef CONFIG_RAK3172_USE_RUI3
         p_Device.Internal.isJoinEvent = false;
     #endif
-
     p_Device.LoRaWAN.AttemptCounter = Attempts;
+    RAK3172_Events_Clear(p_Device, RAK3172_EVENT_BIT_JOIN | RAK3172_EVENT_BIT_IDLE);
+
+    Error = RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+JOIN=1:", EnableAutoJoin, ':', Interval, ':', Attempts));
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_LoRaWAN_StartJoin_Exit;
+    }
+
     p_Device.Internal.isBusy = true;
 
+    // Take the join result into account when it was received before the busy flag was set.
+    if(RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_IDLE, 0) != 0)
+    {
+        p_Device.Internal.isBusy = false;
+    }
+
     #ifdef CONFIG_RAK3172_USE_RUI3
-        TimeNow = RAK3172_Timer_GetMilliseconds() / 1000ULL;
+        Start = RAK3172_Timer_GetMilliseconds();
         do
         {
-            if((Timeout > 0) && (((RAK3172_Timer_GetMilliseconds() / 1000ULL) - TimeNow) >= (Timeout * 1000ULL)))
+            TickType_t Ticks;
+            unsigned long Elapsed;
+
+            Elapsed = RAK3172_Timer_GetMilliseconds() - Start;
+            if((Timeout > 0) && (Elapsed >= (Timeout * 1000UL)))
             {
                 RAK3172_LOGE(TAG, "Join timeout!");
 
@@ -218,7 +596,8 @@ RAK3172_Error_t RAK3172_LoRaWAN_StartJoin(RAK3172_t& p_Device, uint8_t Attempts,
 
                 p_Device.Internal.isBusy = false;
 
-                return RAK3172_ERR_TIMEOUT;
+                Error = RAK3172_ERR_TIMEOUT;
+                goto RAK3172_LoRaWAN_StartJoin_Exit;
             }
 
             if(on_Wait != NULL)
@@ -234,15 +613,26 @@ RAK3172_Error_t RAK3172_LoRaWAN_StartJoin(RAK3172_t& p_Device, uint8_t Attempts,
                 break;
             }
 
+            if(Block == false)
+            {
+                break;
+            }
+
             RAK3172_PwrMagnt_EnterLightSleep(p_Device);
 
-            // We need this delay to prevent a task watchdog reset on ESP32.
-            vTaskDelay(20 / portTICK_PERIOD_MS);
-        } while((Block == true) && (p_Device.LoRaWAN.isJoined == false) && (p_Device.Internal.isBusy == true));
+            // Wake up for the next join result, the timeout or the next call of the wait hook.
+            Ticks = RAK3172_LoRaWAN_WaitTicks(on_Wait);
+            if((Timeout > 0) && (pdMS_TO_TICKS((Timeout * 1000UL) - Elapsed) < Ticks))
+            {
+                Ticks = pdMS_TO_TICKS((Timeout * 1000UL) - Elapsed) + 1;
+            }
+
+            RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_JOIN | RAK3172_EVENT_BIT_IDLE, Ticks);
+        } while((p_Device.LoRaWAN.isJoined == false) && (p_Device.Internal.isBusy == true));
 
         if((Block == true) && (p_Device.LoRaWAN.isJoined == false))
         {
-            return RAK3172_ERR_FAIL;
+            Error = RAK3172_ERR_FAIL;
         }
     #else
         do
@@ -250,8 +640,8 @@ RAK3172_Error_t RAK3172_LoRaWAN_StartJoin(RAK3172_t& p_Device, uint8_t Attempts,
             // Join event has occured and join was not successful. Start a new join.
             if((p_Device.Internal.isJoinEvent == true) && (p_Device.LoRaWAN.isJoined == false))
             {
-                RAK3172_SendCommand(p_Device, "AT+JOIN=1:" + std::to_string(EnableAutoJoin) + ":" + std::to_string(Interval) + ":" + std::to_string(Attempts));
                 p_Device.Internal.isJoinEvent = false;
+                RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+JOIN=1:", EnableAutoJoin, ':', Interval, ':', Attempts));
             }
             // Join event has occured and join was successful.
             else if((p_Device.Internal.isJoinEvent == true) && (p_Device.LoRaWAN.isJoined == true))
@@ -273,21 +663,30 @@ RAK3172_Error_t RAK3172_LoRaWAN_StartJoin(RAK3172_t& p_Device, uint8_t Attempts,
 
             RAK3172_PwrMagnt_EnterLightSleep(p_Device);
 
-            vTaskDelay(20 / portTICK_PERIOD_MS);
+            // The join event flag is checked before the task waits. So a join result which is processed in between sets
+            // the event bit again and the task doesn´t block.
+            if(p_Device.Internal.isJoinEvent == false)
+            {
+                RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_JOIN, RAK3172_LoRaWAN_WaitTicks(on_Wait));
+            }
         } while(p_Device.LoRaWAN.isJoined == false);
 
         if(p_Device.LoRaWAN.isJoined == false)
         {
-            return RAK3172_ERR_FAIL;
+            Error = RAK3172_ERR_FAIL;
         }
     #endif
 
-    return RAK3172_ERR_OK;
+RAK3172_LoRaWAN_StartJoin_Exit:
+    RAK3172_Release(p_Device);
+
+    return Error;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_StopJoin(RAK3172_t& p_Device)
 {
     p_Device.Internal.isBusy = false;
+    RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_IDLE);
 
     return RAK3172_SendCommand(p_Device, "AT+JOIN=0:0:7:0");
 }
@@ -322,123 +721,142 @@ bool RAK3172_LoRaWAN_isJoined(RAK3172_t& p_Device, bool Refresh)
 
 RAK3172_Error_t RAK3172_LoRaWAN_Transmit(RAK3172_t& p_Device, uint8_t Port, const void* p_Buffer, uint16_t Length, bool Confirmed, uint8_t Retries, bool WaitForTransmit, RAK3172_Wait_t Wait)
 {
-    std::string Payload;
     std::string Status;
-    char Buffer[3];
+    RAK3172_Error_t Error;
 
     if(((p_Buffer == NULL) && (Length == 0)) || (Length > 1000) || (Port == 0) || (Port > 233) || (Retries > 7))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.Internal.isBusy)
+
+    // Keep the device locked for the whole transmission, so that the busy state, the confirmation and the retries
+    // can´t be changed by other tasks.
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    Error = RAK3172_ERR_OK;
+    if(p_Device.Internal.isBusy)
     {
-        return RAK3172_ERR_BUSY;
+        Error = RAK3172_ERR_BUSY;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
     else if(p_Device.LoRaWAN.isJoined == false)
     {
-        return RAK3172_ERR_NOT_CONNECTED;
+        Error = RAK3172_ERR_NOT_CONNECTED;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
     else if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
-        return RAK3172_ERR_INVALID_MODE;
+        Error = RAK3172_ERR_INVALID_MODE;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
     else if(Length == 0)
     {
-        return RAK3172_ERR_OK;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
 
     if(Confirmed)
     {
-        RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetRetries(p_Device, Retries));
+        Error = RAK3172_LoRaWAN_SetRetries(p_Device, Retries);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_Transmit_Exit;
+        }
     }
 
-    // Encode the payload into an ASCII string.
-    for(uint16_t i = 0; i < Length; i++)
-    {
-        sprintf(Buffer, "%02x", ((uint8_t*)p_Buffer)[i]);
-        Payload += std::string(Buffer);
-    }
+    // Reset the state before the transmission is started, because the transmission can be finished by the event task
+    // before the command returns.
+    p_Device.LoRaWAN.ConfirmError = false;
+    RAK3172_Events_Clear(p_Device, RAK3172_EVENT_BIT_IDLE);
 
-    if(Payload.size() > 512)
+    // Encode the payload into hex notation. Long payloads don´t fit into a command object on the stack.
+    if(Length > 256)
     {
-        RAK3172_SendCommand(p_Device, "AT+LPSEND=" + std::to_string(Port) + ":" + std::to_string(Confirmed) + ":" + Payload, NULL, &Status);
+        RAK3172_LongPayloadCommand_t* Command;
+
+        Command = static_cast<RAK3172_LongPayloadCommand_t*>(malloc(sizeof(RAK3172_LongPayloadCommand_t)));
+        if(Command == NULL)
+        {
+            Error = RAK3172_ERR_NO_MEM;
+            goto RAK3172_LoRaWAN_Transmit_Exit;
+        }
+
+        RAK3172_SendCommand(p_Device, RAK3172_Command_Build(*Command, "AT+LPSEND=", Port, ':', Confirmed, ':', RAK3172_Command_Hex(p_Buffer, Length)), NULL, &Status);
+        free(Command);
     }
     else
     {
-        RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_SetConfirmation(p_Device, Confirmed));
-        RAK3172_SendCommand(p_Device, "AT+SEND=" + std::to_string(Port) + ":" + Payload, NULL, &Status);
+        RAK3172_PayloadCommand_t Command;
+
+        Error = RAK3172_LoRaWAN_SetConfirmation(p_Device, Confirmed);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_LoRaWAN_Transmit_Exit;
+        }
+
+        RAK3172_SendCommand(p_Device, RAK3172_Command_Build(Command, "AT+SEND=", Port, ':', RAK3172_Command_Hex(p_Buffer, Length)), NULL, &Status);
     }
 
     if(p_Device.Internal.isRestricted)
     {
-        return RAK3172_ERR_RESTRICTED;
+        Error = RAK3172_ERR_RESTRICTED;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
 
     p_Device.Internal.isBusy = true;
 
+    // Take the transmission result into account when it was received before the busy flag was set.
+    if(RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_IDLE, 0) != 0)
+    {
+        p_Device.Internal.isBusy = false;
+    }
+
     // The device is busy. Leave the function with an invalid state error.
     if(Status.find("AT_BUSY_ERROR") != std::string::npos)
     {
         p_Device.Internal.isBusy = false;
-        return RAK3172_ERR_BUSY;
+        Error = RAK3172_ERR_BUSY;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
     else if(Status.find("AT_NO_NETWORK_JOINED") != std::string::npos)
     {
         p_Device.Internal.isBusy = false;
-        return RAK3172_ERR_NOT_CONNECTED;
+        Error = RAK3172_ERR_NOT_CONNECTED;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
     // No transmission error and no confirmation needed.
     else if((Confirmed == false) && (Status.find("OK") != std::string::npos))
     {
         // Wait until the transmission is done.
-        do
+        if(WaitForTransmit)
         {
-            if(Wait)
-            {
-                Wait();
-            }
-
-            RAK3172_PwrMagnt_EnterLightSleep(p_Device);
-
-            // We need this delay to prevent a task watchdog reset on ESP32.
-            vTaskDelay(20 / portTICK_PERIOD_MS);
-        } while(p_Device.Internal.isBusy && (WaitForTransmit == true));
+            RAK3172_LoRaWAN_WaitIdle(p_Device, Wait);
+        }
 
-        return RAK3172_ERR_OK;
+        goto RAK3172_LoRaWAN_Transmit_Exit;
     }
 
-    p_Device.LoRaWAN.ConfirmError = false;
-
     // Wait for the confirmation if needed.
     if(Confirmed)
     {
-        do
-        {
-            if(Wait)
-            {
-                Wait();
-            }
-
-            RAK3172_PwrMagnt_EnterLightSleep(p_Device);
-
-            // We need this delay to prevent a task watchdog reset on ESP32.
-            vTaskDelay(20 / portTICK_PERIOD_MS);
-        } while(p_Device.Internal.isBusy);
+        RAK3172_LoRaWAN_WaitIdle(p_Device, Wait);
     }
 
     p_Device.Internal.isBusy = false;
 
     if(Confirmed && p_Device.LoRaWAN.ConfirmError)
     {
-        return RAK3172_ERR_INVALID_RESPONSE;
+        Error = RAK3172_ERR_INVALID_RESPONSE;
     }
 
-    return RAK3172_ERR_OK;
+RAK3172_LoRaWAN_Transmit_Exit:
+    RAK3172_Release(p_Device);
+
+    return Error;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* p_Message, uint32_t Timeout)
 {
-    RAK3172_Rx_t* FromQueue = NULL;
+    RAK3172_RxFrame_t Received;
 
     if(p_Message == NULL)
     {
@@ -453,145 +871,98 @@ RAK3172_Error_t RAK3172_LoRaWAN_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* p_Mes
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    if(xQueueReceive(p_Device.Internal.ReceiveQueue, &FromQueue, (Timeout * 1000UL) / portTICK_PERIOD_MS) != pdPASS)
+    if(xQueueReceive(p_Device.Internal.ReceiveQueue, &Received, (Timeout * 1000UL) / portTICK_PERIOD_MS) != pdPASS)
     {
         return RAK3172_ERR_TIMEOUT;
     }
 
-    p_Message->RSSI = FromQueue->RSSI;
-    p_Message->SNR = FromQueue->SNR;
-    p_Message->Port = FromQueue->Port;
-    p_Message->Payload = FromQueue->Payload;
-    p_Message->isMulticast = FromQueue->isMulticast;
-    p_Message->Group = FromQueue->Group;
-
-    delete FromQueue;
+    p_Message->RSSI = Received.Info.RSSI;
+    p_Message->SNR = Received.Info.SNR;
+    p_Message->Port = Received.Info.Port;
+    p_Message->isMulticast = Received.Info.isMulticast;
+    p_Message->Group = Received.Info.Group;
+    p_Message->Timestamp = Received.Info.Timestamp;
+    RAK3172_Tools_Bin2Hex(Received.Payload, Received.Info.Length, p_Message->Payload);
 
     return RAK3172_ERR_OK;
 }
 
-RAK3172_Error_t RAK3172_LoRaWAN_SetRetries(const RAK3172_t& p_Device, uint8_t Retries)
+RAK3172_Error_t RAK3172_LoRaWAN_ReceiveBinary(RAK3172_t& p_Device, uint8_t* const p_Buffer, size_t Size, RAK3172_RxInfo_t* const p_Info, uint32_t Timeout)
 {
-    if(Retries > 7)
+    RAK3172_RxFrame_t Received;
+
+    if((p_Buffer == NULL) || (p_Info == NULL))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
+    else if(p_Device.LoRaWAN.isJoined == false)
+    {
+        return RAK3172_ERR_NOT_CONNECTED;
+    }
     else if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+RETY=" + std::to_string(Retries));
-}
-
-RAK3172_Error_t RAK3172_LoRaWAN_GetRetries(const RAK3172_t& p_Device, uint8_t* const p_Retries)
-{
-    std::string Response;
-
-    if(p_Retries == NULL)
+    if(xQueueReceive(p_Device.Internal.ReceiveQueue, &Received, (Timeout * 1000UL) / portTICK_PERIOD_MS) != pdPASS)
     {
-        return RAK3172_ERR_INVALID_ARG;
+        return RAK3172_ERR_TIMEOUT;
     }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
+
+    *p_Info = Received.Info;
+    if(Received.Info.Length > Size)
     {
-        return RAK3172_ERR_INVALID_MODE;
+        return RAK3172_ERR_INVALID_SIZE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RETY=?", &Response));
-
-    *p_Retries = static_cast<uint8_t>(std::stoi(Response));
+    memcpy(p_Buffer, Received.Payload, Received.Info.Length);
 
     return RAK3172_ERR_OK;
 }
 
-RAK3172_Error_t RAK3172_LoRaWAN_SetPNM(const RAK3172_t& p_Device, bool Enable)
+RAK3172_Error_t RAK3172_LoRaWAN_SetRetries(const RAK3172_t& p_Device, uint8_t Retries)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+PNM=" + std::to_string(Enable));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_Retries, Retries, &p_Device.Internal.Shadow.Retries);
 }
 
-RAK3172_Error_t RAK3172_LoRaWAN_GetPNM(const RAK3172_t& p_Device, bool* const p_Enable)
+RAK3172_Error_t RAK3172_LoRaWAN_GetRetries(const RAK3172_t& p_Device, uint8_t* const p_Retries)
 {
-    std::string Response;
-
-    if(p_Enable == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PNM=?", &Response));
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Retries, p_Retries, &p_Device.Internal.Shadow.Retries);
+}
 
-    *p_Enable = static_cast<bool>(std::stoi(Response));
+RAK3172_Error_t RAK3172_LoRaWAN_SetPNM(const RAK3172_t& p_Device, bool Enable)
+{
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_PNM, Enable);
+}
 
-    return RAK3172_ERR_OK;
+RAK3172_Error_t RAK3172_LoRaWAN_GetPNM(const RAK3172_t& p_Device, bool* const p_Enable)
+{
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_PNM, p_Enable);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetConfirmation(const RAK3172_t& p_Device, bool Enable)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+CFM=" + std::to_string(Enable));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_Confirmation, Enable, &p_Device.Internal.Shadow.Confirmation);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetConfirmation(const RAK3172_t& p_Device, bool* const p_Enable)
 {
-    std::string Response;
-
-    if(p_Enable == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CFM=?", &Response));
-
-    *p_Enable = static_cast<bool>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Confirmation, p_Enable, &p_Device.Internal.Shadow.Confirmation);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetBand(const RAK3172_t& p_Device, RAK3172_Band_t Band)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
+    RAK3172_ERROR_CHECK(RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_Band, Band, &p_Device.Internal.Shadow.Band));
 
-    return RAK3172_SendCommand(p_Device, "AT+BAND=" + std::to_string(static_cast<uint8_t>(Band)));
+    // The module loads the default channel mask, data rate and transmit power of the new band.
+    p_Device.Internal.Shadow.Valid &= ~(RAK_SHADOW_SUB_BAND | RAK_SHADOW_DATARATE | RAK_SHADOW_TX_PWR);
+
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetBand(const RAK3172_t& p_Device, RAK3172_Band_t* const p_Band)
 {
-    std::string Response;
-
-    if(p_Band == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+BAND=?", &Response));
-
-    *p_Band = static_cast<RAK3172_Band_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Band, p_Band, &p_Device.Internal.Shadow.Band);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetSubBand(const RAK3172_t& p_Device, RAK3172_SubBand_t Band)
@@ -619,16 +990,21 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetSubBand(const RAK3172_t& p_Device, RAK3172_Su
 
         if(Band == RAK_SUB_BAND_ALL)
         {
-            return RAK3172_SendCommand(p_Device, "AT+MASK=0000");
+            RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+MASK=0000"));
         }
         else
         {
             char Temp[5];
 
             sprintf(Temp, "%04X", 1 << (Band - 2));
-    
-            return RAK3172_SendCommand(p_Device, "AT+MASK=" + std::string(Temp));
+
+            RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+MASK=", Temp)));
         }
+
+        p_Device.Internal.Shadow.SubBand = Band;
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_SUB_BAND;
+
+        return RAK3172_ERR_OK;
     }
 
     return RAK3172_ERR_FAIL;
@@ -639,7 +1015,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetSubBand(const RAK3172_t& p_Device, RAK3172_Su
     RAK3172_Band_t Dummy;
     std::string Response;
     uint32_t Mask;
-    uint8_t Shifts = 1;
+    uint8_t Shifts = 0;
 
     if(p_Band == NULL)
     {
@@ -659,311 +1035,111 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetSubBand(const RAK3172_t& p_Device, RAK3172_Su
         return RAK3172_ERR_OK;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+MASK=?", &Response));
-
-    Mask = std::stoi(Response);
-
-    if(Mask == 0)
+    if((p_Device.Internal.Shadow.Valid & RAK_SHADOW_SUB_BAND) == 0)
     {
-        *p_Band = RAK_SUB_BAND_ALL;
+        RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+MASK=?", &Response));
 
-        return RAK3172_ERR_OK;
-    }
-    else
-    {
-        while(Mask != 1)
+        // The channel mask is reported in hex notation.
+        if(RAK3172_Number_To(Response, &Mask, 16) == false)
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
+
+        if(Mask == 0)
         {
-            Mask >>= 1;
-            Shifts++;
+            p_Device.Internal.Shadow.SubBand = RAK_SUB_BAND_ALL;
         }
+        else
+        {
+            while(Mask != 1)
+            {
+                Mask >>= 1;
+                Shifts++;
+            }
 
-        *p_Band = static_cast<RAK3172_SubBand_t>(Shifts + 2);
+            p_Device.Internal.Shadow.SubBand = static_cast<RAK3172_SubBand_t>(Shifts + 2);
+        }
 
-        return RAK3172_ERR_OK;
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_SUB_BAND;
     }
+
+    *p_Band = p_Device.Internal.Shadow.SubBand;
+
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetTxPwr(const RAK3172_t& p_Device, uint8_t TxPwr)
 {
-    uint8_t TxPwrIndex = 0;
+    uint8_t TxPwrIndex;
     RAK3172_Band_t Band;
 
     RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_GetBand(p_Device, &Band));
 
     RAK3172_LOGD(TAG, "Set Tx power to: %u dBm", TxPwr);
 
-    // For EU868 the maximum transmit power is +16 dB EIRP.
-    if(Band == RAK_BAND_EU868)
-    {
-        const uint8_t EIRP = 16;
-
-        if(TxPwr >= EIRP)
-        {
-            TxPwrIndex = 0;
-        }
-        else if(TxPwr < (EIRP - 14))
-        {
-            TxPwrIndex = 10;
-        }
-        else
-        {
-            TxPwrIndex = static_cast<uint8_t>((EIRP - TxPwr) / 2);
-        }
-    }
-    // For US915 the maximum transmit power is +30 dBm conducted power.
-    else if(Band == RAK_BAND_US915)
-    {
-        const uint8_t MaxPwr = 30;
-
-        if(TxPwr >= MaxPwr)
-        {
-            TxPwrIndex = 0;
-        }
-        else if(TxPwr < 10)
-        {
-            TxPwrIndex = 10;
-        }
-        else
-        {
-            TxPwrIndex = static_cast<uint8_t>((MaxPwr - TxPwr) / 2);
-        }
-    }
-    else
-    {
-        RAK3172_LOGE(TAG, "Tx power is not implemented for the selected frequency band!");
-    }
+    TxPwrIndex = RAK3172_LoRaWAN_GetTxPwrIndex(Band, TxPwr);
 
     RAK3172_LOGD(TAG, "Set Tx power index: %u", TxPwrIndex);
 
-    return RAK3172_SendCommand(p_Device, "AT+TXP=" + std::to_string(TxPwrIndex));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_TxPwr, TxPwrIndex, &p_Device.Internal.Shadow.TxPwrIndex);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetJoin1Delay(const RAK3172_t& p_Device, uint32_t Delay)
 {
-    uint32_t Delay_Temp;
-
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if((Delay < 1) || (Delay > 14))
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    Delay_Temp = Delay;
-
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        Delay_Temp *= 1000;
-    #endif
-
-    return RAK3172_SendCommand(p_Device, "AT+JN1DL=" + std::to_string(Delay_Temp));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_Join1Delay, Delay, &p_Device.Internal.Shadow.Join1Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetJoin1Delay(const RAK3172_t& p_Device, uint32_t* const p_Delay)
 {
-    std::string Response;
-
-    if(p_Delay == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+JN1DL=?", &Response));
-
-    *p_Delay = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Join1Delay, p_Delay, &p_Device.Internal.Shadow.Join1Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetJoin2Delay(const RAK3172_t& p_Device, uint32_t Delay)
 {
-    uint32_t Delay_Temp;
-
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if((Delay < 2) || (Delay > 15))
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    Delay_Temp = Delay;
-
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        Delay_Temp *= 1000;
-    #endif
-
-    return RAK3172_SendCommand(p_Device, "AT+JN2DL=" + std::to_string(Delay_Temp));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_Join2Delay, Delay, &p_Device.Internal.Shadow.Join2Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetJoin2Delay(const RAK3172_t& p_Device, uint32_t* const p_Delay)
 {
-    std::string Response;
-
-    if(p_Delay == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+JN2DL=?", &Response));
-
-    *p_Delay = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Join2Delay, p_Delay, &p_Device.Internal.Shadow.Join2Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetRX1Delay(const RAK3172_t& p_Device, uint32_t Delay)
 {
-    uint32_t Delay_Temp;
-
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if((Delay < 1) || (Delay > 15))
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    Delay_Temp = Delay;
-
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        Delay_Temp *= 1000;
-    #endif
-
-    return RAK3172_SendCommand(p_Device, "AT+RX1DL=" + std::to_string(Delay_Temp));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_RX1Delay, Delay, &p_Device.Internal.Shadow.RX1Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRX1Delay(const RAK3172_t& p_Device, uint32_t* const p_Delay)
 {
-    std::string Response;
-
-    if(p_Delay == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RX1DL=?", &Response));
-
-    *p_Delay = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RX1Delay, p_Delay, &p_Device.Internal.Shadow.RX1Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetRX2Delay(const RAK3172_t& p_Device, uint32_t Delay)
 {
-    uint32_t Delay_Temp;
-
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if((Delay < 2) || (Delay > 16))
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    Delay_Temp = Delay;
-
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        Delay_Temp *= 1000;
-    #endif
-
-    return RAK3172_SendCommand(p_Device, "AT+RX2DL=" + std::to_string(Delay_Temp));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_RX2Delay, Delay, &p_Device.Internal.Shadow.RX2Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRX2Delay(const RAK3172_t& p_Device, uint32_t* const p_Delay)
 {
-    std::string Response;
-
-    if(p_Delay == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RX2DL=?", &Response));
-
-    *p_Delay = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RX2Delay, p_Delay, &p_Device.Internal.Shadow.RX2Delay);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetRX2Freq(const RAK3172_t& p_Device, uint32_t Frequency)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+RX2FQ=" + std::to_string(Frequency));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_RX2Freq, Frequency);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRX2Freq(const RAK3172_t& p_Device, uint32_t* const p_Frequency)
 {
-    std::string Response;
-
-    if(p_Frequency == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RX2FQ=?", &Response));
-
-    *p_Frequency = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RX2Freq, p_Frequency);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetRX2DataRate(const RAK3172_t& p_Device, uint8_t DataRate)
 {
     #ifdef CONFIG_RAK3172_USE_RUI3
         RAK3172_Band_t Band;
-    #endif
 
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-    #ifndef CONFIG_RAK3172_USE_RUI3
-        if(DataRate > 7)
-        {
-            return RAK3172_ERR_INVALID_ARG;
-        }
-    #endif
-
-    #ifdef CONFIG_RAK3172_USE_RUI3
+        // The valid data rates depend on the frequency band.
         RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_GetBand(p_Device, &Band));
 
         if((Band == RAK_BAND_EU433) || (Band == RAK_BAND_RU864) || (Band == RAK_BAND_IN865) || (Band == RAK_BAND_EU868) || (Band == RAK_BAND_CN470) || (Band == RAK_BAND_KR920))
@@ -989,72 +1165,26 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetRX2DataRate(const RAK3172_t& p_Device, uint8_
         }
     #endif
 
-    return RAK3172_SendCommand(p_Device, "AT+RX2DL=" + std::to_string(DataRate));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_RX2DataRate, DataRate);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRX2DataRate(const RAK3172_t& p_Device, uint32_t* const p_DataRate)
 {
-    std::string Response;
-
-    if(p_DataRate == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RX2DR=?", &Response));
-
-    *p_DataRate = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RX2DataRate, p_DataRate);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetSNR(const RAK3172_t& p_Device, int8_t* const p_SNR)
 {
-    std::string Response;
-
-    if(p_SNR == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+SNR=?", &Response));
-
-    *p_SNR = static_cast<int8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_SNR, p_SNR);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRSSI(const RAK3172_t& p_Device, int8_t* const p_RSSI)
 {
-    std::string Response;
-
-    if(p_RSSI == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RSSI=?", &Response));
-
-    *p_RSSI = static_cast<int8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RSSI, p_RSSI);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetDuty(const RAK3172_t& p_Device, uint8_t* const p_Duty)
 {
-    std::string Response;
     RAK3172_Band_t Band;
 
     RAK3172_ERROR_CHECK(RAK3172_LoRaWAN_GetBand(p_Device, &Band));
@@ -1063,126 +1193,89 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetDuty(const RAK3172_t& p_Device, uint8_t* cons
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+DUTYTIME=?", &Response));
 
-    *p_Duty = static_cast<uint8_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_Duty, p_Duty);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetDataRate(const RAK3172_t& p_Device, RAK3172_DataRate_t DR)
 {
-    if(DR > RAK_DR_7)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
+    RAK3172_ERROR_CHECK(RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_DataRate, DR));
+
+    // The data rate is changed by the module when ADR is enabled.
+    p_Device.Internal.Shadow.DataRate = DR;
+    if(((p_Device.Internal.Shadow.Valid & RAK_SHADOW_ADR) != 0) && (p_Device.Internal.Shadow.ADR == false))
     {
-        return RAK3172_ERR_INVALID_MODE;
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_DATARATE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+DR=" + std::to_string(DR));
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetDataRate(const RAK3172_t& p_Device, RAK3172_DataRate_t* const p_DR)
 {
-    std::string Response;
-
     if(p_DR == NULL)
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
+
+    if((p_Device.Internal.Shadow.Valid & RAK_SHADOW_DATARATE) == 0)
     {
-        return RAK3172_ERR_INVALID_MODE;
-    }
+        RAK3172_ERROR_CHECK(RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_DataRate, &p_Device.Internal.Shadow.DataRate));
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+DR=?", &Response));
+        // The data rate is changed by the module when ADR is enabled.
+        if(((p_Device.Internal.Shadow.Valid & RAK_SHADOW_ADR) != 0) && (p_Device.Internal.Shadow.ADR == false))
+        {
+            p_Device.Internal.Shadow.Valid |= RAK_SHADOW_DATARATE;
+        }
+    }
+    else
+    {
+        RAK3172_ERROR_CHECK(RAK3172_Setting_CheckMode(p_Device, _RAK3172_LoRaWAN_DataRate));
+    }
 
-    *p_DR = static_cast<RAK3172_DataRate_t>(std::stoi(Response));
+    *p_DR = p_Device.Internal.Shadow.DataRate;
 
     return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetADR(const RAK3172_t& p_Device, bool Enable)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
+    RAK3172_ERROR_CHECK(RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_ADR, Enable, &p_Device.Internal.Shadow.ADR));
+
+    if(Enable)
     {
-        return RAK3172_ERR_INVALID_MODE;
+        p_Device.Internal.Shadow.Valid &= ~RAK_SHADOW_DATARATE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+ADR=" + std::to_string(Enable));
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetADR(const RAK3172_t& p_Device, bool* const p_Enable)
 {
-    std::string Response;
-
-    if(p_Enable == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+ADR=?", &Response));
-
-    *p_Enable = static_cast<bool>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_ADR, p_Enable, &p_Device.Internal.Shadow.ADR);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetJoinMode(const RAK3172_t& p_Device, RAK3172_JoinMode_t Mode)
 {
-    if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+NJM=" + std::to_string(Mode));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_LoRaWAN_JoinMode, Mode);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetJoinMode(const RAK3172_t& p_Device, RAK3172_JoinMode_t* const p_Mode)
 {
-    std::string Response;
-
-    if(p_Mode == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+NJM=?", &Response));
-
-    *p_Mode = static_cast<RAK3172_JoinMode_t>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_JoinMode, p_Mode);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_SetClass(RAK3172_t& p_Device, RAK3172_Class_t Class)
 {
-    std::string Command;
-
     if(p_Device.Mode != RAK_MODE_LORAWAN)
     {
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    Command = "AT+CLASS=";
-    Command += Class;
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, Command));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+CLASS=", static_cast<char>(Class))));
 
     p_Device.LoRaWAN.Class = Class;
+    p_Device.Internal.Shadow.Valid |= RAK_SHADOW_CLASS;
 
     return RAK3172_ERR_OK;
 }
@@ -1200,78 +1293,37 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetClass(RAK3172_t& p_Device, RAK3172_Class_t* c
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CLASS=?", &Response));
-
-    if(Response.empty())
+    if((p_Device.Internal.Shadow.Valid & RAK_SHADOW_CLASS) == 0)
     {
-        return RAK3172_ERR_INVALID_RESPONSE;
-    }
+        RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CLASS=?", &Response));
 
-    *p_Class = static_cast<RAK3172_Class_t>(Response.at(0));
+        if(Response.empty())
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
+
+        p_Device.LoRaWAN.Class = static_cast<RAK3172_Class_t>(Response.at(0));
+        p_Device.Internal.Shadow.Valid |= RAK_SHADOW_CLASS;
+    }
 
-    p_Device.LoRaWAN.Class = *p_Class;
+    *p_Class = p_Device.LoRaWAN.Class;
 
     return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetRSSI(const RAK3172_t& p_Device, int* p_RSSI)
 {
-    std::string Response;
-
-    if(p_RSSI == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+RSSI=?", &Response));
-
-    *p_RSSI = std::stoi(Response);
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_RSSI, p_RSSI);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetSNR(const RAK3172_t& p_Device, int* p_SNR)
 {
-    std::string Response;
-
-    if(p_SNR == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+SNR=?", &Response));
-
-    *p_SNR = std::stoi(Response);
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_SNR, p_SNR);
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetConfirmationStatus(const RAK3172_t& p_Device, bool* p_Status)
 {
-    std::string Response;
-
-    if(p_Status == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if(p_Device.Mode != RAK_MODE_LORAWAN)
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CFS=?", &Response));
-
-    *p_Status = static_cast<bool>(std::stoi(Response));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_LoRaWAN_ConfirmationStatus, p_Status);
 }
 
 
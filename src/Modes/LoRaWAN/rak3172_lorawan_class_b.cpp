@@ -25,27 +25,27 @@
 
 #include "rak3172.h"
 
-/** @brief              Get a substring from the input string. The substring is delimited by the given delimiter.
+#include "../../Parser/rak3172_number.h"
+
+/** @brief              Parse the next number of a date or time string and remove it together with the trailing delimiter.
  *  @param p_Input      Pointer to input string
- *                      NOTE: The input string will be modified!
- *  @param Delimiter    Substring delimiter
- *  @return             Substring
+ *  @param Delimiter    Delimiter behind the number
+ *  @param p_Value      Pointer to value
+ *  @return             #true when successful
  */
-static std::string RAK3172_SubstringSplitErase(std::string* p_Input, std::string Delimiter)
+static bool RAK3172_LoRaWAN_NextField(std::string_view* p_Input, char Delimiter, int* p_Value)
 {
     size_t Index;
-    std::string Result = std::string();
-
-    assert(p_Input);
 
     Index = p_Input->find(Delimiter);
-    if(Index != std::string::npos)
+    if((Index == std::string_view::npos) || (RAK3172_Number_To(p_Input->substr(0, Index), p_Value) == false))
     {
-        Result = p_Input->substr(0, Index);
-        p_Input->erase(0, Index + 1);
+        return false;
     }
 
-    return Result;
+    p_Input->remove_prefix(Index + 1);
+
+    return true;
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetBeaconFrequency(RAK3172_t& p_Device, RAK3172_DataRate_t* p_Datarate, uint32_t* p_Frequency)
@@ -78,9 +78,11 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetBeaconFrequency(RAK3172_t& p_Device, RAK3172_
     #endif
 
     Index = Response.find(",");
-    *p_Datarate = static_cast<RAK3172_DataRate_t>(std::stoi(Response.substr(0, Index)));
-    Response.erase(0, Index + 1);
-    *p_Frequency = static_cast<uint32_t>(std::stoi(Response));
+    if((Index == std::string::npos) || (RAK3172_Number_To(std::string_view(Response).substr(0, Index), p_Datarate) == false) ||
+       (RAK3172_Number_To(std::string_view(Response).substr(Index + 1), p_Frequency) == false))
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -113,8 +115,10 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetBeaconFrequency(RAK3172_t& p_Device, RAK3172_
             return RAK3172_ERR_INVALID_RESPONSE;
         }
 
-        Response.erase(0, Index + std::string("BTIME: ").size());
-        *p_Time = static_cast<uint32_t>(std::stoi(Response));
+        if(RAK3172_Number_To(std::string_view(Response).substr(Index + std::string("BTIME: ").size()), p_Time) == false)
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
 
         return RAK3172_ERR_OK;
     }
@@ -141,7 +145,9 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetBeaconFrequency(RAK3172_t& p_Device, RAK3172_
 RAK3172_Error_t RAK3172_LoRaWAN_GetLocalTime(RAK3172_t& p_Device, struct tm* p_DateTime)
 {
     size_t Index;
+    int Year;
     std::string Response;
+    std::string_view Fields;
 
     if(p_DateTime == NULL)
     {
@@ -161,34 +167,47 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetLocalTime(RAK3172_t& p_Device, struct tm* p_D
 
     memset(p_DateTime, 0, sizeof(struct tm));
 
+    // Spaces in front of the numbers are ignored by the parser.
+    Fields = std::string_view(Response).substr(Index + std::string("LTIME:").size());
+
     #ifdef CONFIG_RAK3172_USE_RUI3
-        Response.erase(0, Index + std::string("LTIME: ").size());
-        Index = Response.find(" ");
-        Response.erase(Index, std::string(" ").size());
-
-        // We continue with a string with the format "00h37m58s2018-11-14" here.
-        p_DateTime->tm_hour = std::stoi(RAK3172_SubstringSplitErase(&Response, "h"));
-        p_DateTime->tm_min = std::stoi(RAK3172_SubstringSplitErase(&Response, "m"));
-        p_DateTime->tm_sec = std::stoi(RAK3172_SubstringSplitErase(&Response, "s"));
-        p_DateTime->tm_year = std::stoi(RAK3172_SubstringSplitErase(&Response, "-")) - 1900;
-        p_DateTime->tm_mon = std::stoi(RAK3172_SubstringSplitErase(&Response, "-"));
-        p_DateTime->tm_mday = std::stoi(Response);
+        // We continue with a string with the format "00h37m58s 2018-11-14" here.
+        if((RAK3172_LoRaWAN_NextField(&Fields, 'h', &p_DateTime->tm_hour) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, 'm', &p_DateTime->tm_min) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, 's', &p_DateTime->tm_sec) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, '-', &Year) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, '-', &p_DateTime->tm_mon) == false) ||
+           (RAK3172_Number_To(Fields, &p_DateTime->tm_mday) == false))
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
     #else
-        Response.erase(0, Index + std::string("LTIME:").size());
+        // We continue with a string with the format "00h37m58s on 14/11/2018" here.
+        if((RAK3172_LoRaWAN_NextField(&Fields, 'h', &p_DateTime->tm_hour) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, 'm', &p_DateTime->tm_min) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, 's', &p_DateTime->tm_sec) == false))
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
 
         // Remove the "on" string between the time and the date.
-        Index = Response.find(" on ");
-        Response.erase(Index, std::string(" on ").size());
-
-        // We continue with a string with the format "00h37m58s14-11-2018" here.
-        p_DateTime->tm_hour = std::stoi(RAK3172_SubstringSplitErase(&Response, "h"));
-        p_DateTime->tm_min = std::stoi(RAK3172_SubstringSplitErase(&Response, "m"));
-        p_DateTime->tm_sec = std::stoi(RAK3172_SubstringSplitErase(&Response, "s"));
-        p_DateTime->tm_mday = std::stoi(RAK3172_SubstringSplitErase(&Response, "/"));
-        p_DateTime->tm_mon = std::stoi(RAK3172_SubstringSplitErase(&Response, "/"));
-        p_DateTime->tm_year = std::stoi(Response) - 1900;
+        Index = Fields.find("on ");
+        if(Index == std::string_view::npos)
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
+        Fields.remove_prefix(Index + std::string_view("on ").size());
+
+        if((RAK3172_LoRaWAN_NextField(&Fields, '/', &p_DateTime->tm_mday) == false) ||
+           (RAK3172_LoRaWAN_NextField(&Fields, '/', &p_DateTime->tm_mon) == false) ||
+           (RAK3172_Number_To(Fields, &Year) == false))
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
     #endif
 
+    p_DateTime->tm_year = Year - 1900;
+
     return RAK3172_ERR_OK;
 }
 
@@ -203,7 +222,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetPeriodicity(RAK3172_t& p_Device, uint8_t Peri
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+PGSLOT=" + std::to_string(Periodicity));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PGSLOT=", Periodicity));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetPeriodicity(RAK3172_t& p_Device, uint8_t* p_Periodicity)
@@ -221,7 +240,10 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetPeriodicity(RAK3172_t& p_Device, uint8_t* p_P
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PGSLOT=?", &Response));
 
-    *p_Periodicity = static_cast<uint8_t>(std::stoi(Response));
+    if(RAK3172_Number_To(Response, p_Periodicity) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
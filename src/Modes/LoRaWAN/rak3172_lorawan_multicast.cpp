@@ -25,6 +25,8 @@
 
 #include "rak3172.h"
 
+#include "../../Parser/rak3172_number.h"
+
 RAK3172_Error_t RAK3172_LoRaWAN_MC_AddGroup(RAK3172_t& p_Device, RAK3172_MC_Group_t Group)
 {
     return RAK3172_LoRaWAN_MC_AddGroup(p_Device, Group.Class, Group.DevAddr, Group.NwkSKey, Group.AppSKey, Group.Frequency, Group.Datarate, Group.Periodicity);
@@ -32,8 +34,6 @@ RAK3172_Error_t RAK3172_LoRaWAN_MC_AddGroup(RAK3172_t& p_Device, RAK3172_MC_Grou
 
 RAK3172_Error_t RAK3172_LoRaWAN_MC_AddGroup(RAK3172_t& p_Device, RAK3172_Class_t Class, std::string DevAddr, std::string NwkSKey, std::string AppSKey, uint32_t Frequency, RAK3172_DataRate_t Datarate, uint8_t Periodicity)
 {
-    std::string Command;
-
     if(((Class != RAK_CLASS_B) && (Class != RAK_CLASS_C)) || (DevAddr.size() == 0) || (NwkSKey.size() == 0) || (AppSKey.size() == 0) || (Frequency < 150000000) || (Frequency > 960000000) || ((Class == RAK_CLASS_B) && (Periodicity > 7)))
     {
         return RAK3172_ERR_INVALID_ARG;
@@ -43,11 +43,8 @@ RAK3172_Error_t RAK3172_LoRaWAN_MC_AddGroup(RAK3172_t& p_Device, RAK3172_Class_t
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    Command = "AT+ADDMULC=";
-    Command += Class;
-    Command += ":" + DevAddr + ":" + NwkSKey + ":" + AppSKey + ":" + std::to_string(Frequency) + ":" + std::to_string(Datarate) + ":" + std::to_string(Periodicity);
-
-    return RAK3172_SendCommand(p_Device, Command);
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+ADDMULC=", static_cast<char>(Class), ':', DevAddr, ':', NwkSKey, ':', AppSKey, ':', Frequency, ':',
+                                                                Datarate, ':', Periodicity));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_MC_RemoveGroup(RAK3172_t& p_Device, RAK3172_MC_Group_t Group)
@@ -66,7 +63,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_MC_RemoveGroup(RAK3172_t& p_Device, std::string
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+RMVMULC=" + DevAddr);
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+RMVMULC=", DevAddr));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_MC_ListGroup(RAK3172_t& p_Device, RAK3172_MC_Group_t* p_Group)
@@ -96,7 +93,11 @@ RAK3172_Error_t RAK3172_LoRaWAN_MC_ListGroup(RAK3172_t& p_Device, RAK3172_MC_Gro
         }
     } while(Index != std::string::npos);
 
-    if(SubStrings.size() != 5)
+    // The data rate is the last field without a trailing delimiter.
+    SubStrings.push_back(Response);
+
+    if((SubStrings.size() != 6) || SubStrings.at(0).empty() || (RAK3172_Number_To(SubStrings.at(4), &p_Group->Frequency) == false) ||
+       (RAK3172_Number_To(SubStrings.at(5), &p_Group->Datarate) == false))
     {
         return RAK3172_ERR_INVALID_RESPONSE;
     }
@@ -105,8 +106,6 @@ RAK3172_Error_t RAK3172_LoRaWAN_MC_ListGroup(RAK3172_t& p_Device, RAK3172_MC_Gro
     p_Group->DevAddr = SubStrings.at(1);
     p_Group->NwkSKey = SubStrings.at(2);
     p_Group->AppSKey = SubStrings.at(3);
-    p_Group->Frequency = std::stoi(SubStrings.at(4));
-    p_Group->Datarate = static_cast<RAK3172_DataRate_t>(std::stoi(SubStrings.at(5)));
 
     return RAK3172_ERR_OK;
 }
@@ -23,6 +23,8 @@
 
 #include "rak3172.h"
 
+#include "../../Parser/rak3172_number.h"
+
 RAK3172_Error_t RAK3172_LoRaWAN_GetNetID(const RAK3172_t& p_Device, std::string* const p_ID)
 {
     if(p_ID == NULL)
@@ -52,7 +54,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetSingleChannelMode(const RAK3172_t& p_Device,
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+CHS=" + std::to_string(Enable));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+CHS=", Enable));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetSingleChannelMode(const RAK3172_t& p_Device, bool* const p_Enable)
@@ -70,7 +72,10 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetSingleChannelMode(const RAK3172_t& p_Device,
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CHS=?", &Value));
 
-    *p_Enable = static_cast<bool>(std::stoi(Value));
+    if(RAK3172_Number_To(Value, p_Enable) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -82,7 +87,7 @@ RAK3172_Error_t RAK3172_LoRaWAN_SetEightChannelMode(const RAK3172_t& p_Device, b
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+CHE=" + std::to_string(Enable));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+CHE=", Enable));
 }
 
 RAK3172_Error_t RAK3172_LoRaWAN_GetEightChannelMode(const RAK3172_t& p_Device, bool* const p_Enable)
@@ -100,7 +105,10 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetEightChannelMode(const RAK3172_t& p_Device, b
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+CHE=?", &Value));
 
-    *p_Enable = static_cast<bool>(std::stoi(Value));
+    if(RAK3172_Number_To(Value, p_Enable) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -123,10 +131,17 @@ RAK3172_Error_t RAK3172_LoRaWAN_GetChannelRSSI(const RAK3172_t& p_Device, std::v
 
     do
     {
+        int RSSI;
+
         Dummy = Value.substr(0, Value.find(","));
         Value.erase(0, Dummy.length() + 1);
 
-        p_RSSI->push_back(std::stoi(Dummy.substr(Dummy.find(":") + 1)));
+        if(RAK3172_Number_To(std::string_view(Dummy).substr(Dummy.find(":") + 1), &RSSI) == false)
+        {
+            return RAK3172_ERR_INVALID_RESPONSE;
+        }
+
+        p_RSSI->push_back(RSSI);
     } while(Value.length() > 0);
 
     return RAK3172_ERR_OK;
@@ -26,12 +26,33 @@
 #include <freertos/event_groups.h>
 #include <freertos/queue.h>
 
+#include <string.h>
+
 #include "../../Arch/rak3172_arch.h"
 
 #include "rak3172.h"
 
+#include "../Private/rak3172_tools.h"
+#include "../Private/rak3172_settings.h"
+#include "../../Events/rak3172_events.h"
+
 static const char* TAG = "RAK3172_P2P";
 
+/** @brief LoRa P2P settings.
+ *         Command, mode, minimum, maximum, scale, shadow flag
+ */
+static constexpr RAK3172_Setting_t _RAK3172_P2P_Frequency               = { "AT+PFREQ=",    RAK_SETTING_P2P,     150000000, 960000000,           1,      RAK_SHADOW_FREQUENCY };
+static constexpr RAK3172_Setting_t _RAK3172_P2P_Bandwidth               = { "AT+PBW=",      RAK_SETTING_P2P,     0,         467000,              1,      RAK_SHADOW_BANDWIDTH };
+static constexpr RAK3172_Setting_t _RAK3172_P2P_CodeRate                = { "AT+PCR=",      RAK_SETTING_P2P,     0,         RAK_CR_48,           1,      RAK_SHADOW_CODERATE };
+static constexpr RAK3172_Setting_t _RAK3172_P2P_Power                   = { "AT+PTP=",      RAK_SETTING_P2P,     5,         22,                  1,      RAK_SHADOW_POWER };
+#ifdef CONFIG_RAK3172_USE_RUI3
+    static constexpr RAK3172_Setting_t _RAK3172_P2P_Spreading           = { "AT+PSF=",      RAK_SETTING_P2P,     RAK_PSF_5, RAK_PSF_12,          1,      RAK_SHADOW_SPREADING };
+    static constexpr RAK3172_Setting_t _RAK3172_P2P_Preamble            = { "AT+PPL=",      RAK_SETTING_P2P,     5,         UINT16_MAX,          1,      RAK_SHADOW_PREAMBLE };
+#else
+    static constexpr RAK3172_Setting_t _RAK3172_P2P_Spreading           = { "AT+PSF=",      RAK_SETTING_P2P,     RAK_PSF_6, RAK_PSF_12,          1,      RAK_SHADOW_SPREADING };
+    static constexpr RAK3172_Setting_t _RAK3172_P2P_Preamble            = { "AT+PPL=",      RAK_SETTING_P2P,     2,         UINT16_MAX,          1,      RAK_SHADOW_PREAMBLE };
+#endif
+
 /** @brief          LoRa P2P receive task.
  *  @param p_Arg    Pointer to task arguments
  */
@@ -43,18 +64,23 @@ static void RAK3172_P2P_ReceiveTask(void* p_Arg)
 
     while(Device->P2P.Active)
     {
-        RAK3172_Rx_t* FromQueue = NULL;
+        RAK3172_RxFrame_t Received;
 
-        if(xQueueReceive(Device->Internal.ReceiveQueue, &FromQueue, 20 / portTICK_PERIOD_MS) == pdPASS)
+        if(xQueueReceive(Device->Internal.ReceiveQueue, &Received, 20 / portTICK_PERIOD_MS) == pdPASS)
         {
             if(Device->P2P.Timeout != RAK_REC_REPEAT)
             {
                 Device->P2P.isRxTimeout = true;
                 Device->Internal.isBusy = false;
                 Device->P2P.Active = false;
+
+                RAK3172_Events_Signal(*Device, RAK3172_EVENT_BIT_IDLE);
             }
 
-            xQueueSend(Device->P2P.ListenQueue, &FromQueue, 0);
+            if(xQueueSend(Device->P2P.ListenQueue, &Received, 0) != pdPASS)
+            {
+                Device->Internal.Stats.ReceiveDropped++;
+            }
         }
     }
 
@@ -112,7 +138,17 @@ RAK3172_Error_t RAK3172_P2P_Init(RAK3172_t& p_Device, uint32_t Frequency, RAK317
         RAK3172_ERROR_CHECK(RAK3172_P2P_isEncryptionEnabled(p_Device, &p_Device.P2P.isEncryptionEnabled));
     #endif
 
-    return RAK3172_SendCommand(p_Device, "AT+P2P=" + Value);
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+P2P=", Value)));
+
+    p_Device.Internal.Shadow.Frequency = Frequency;
+    p_Device.Internal.Shadow.Spreading = SF;
+    p_Device.Internal.Shadow.Bandwidth = Bandwidth;
+    p_Device.Internal.Shadow.CodeRate = CodeRate;
+    p_Device.Internal.Shadow.Preamble = Preamble;
+    p_Device.Internal.Shadow.Power = Power;
+    p_Device.Internal.Shadow.Valid |= RAK_SHADOW_FREQUENCY | RAK_SHADOW_SPREADING | RAK_SHADOW_BANDWIDTH | RAK_SHADOW_CODERATE | RAK_SHADOW_PREAMBLE | RAK_SHADOW_POWER;
+
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_P2P_GetConfig(const RAK3172_t& p_Device, std::string* const p_Config)
@@ -131,74 +167,22 @@ RAK3172_Error_t RAK3172_P2P_GetConfig(const RAK3172_t& p_Device, std::string* co
 
 RAK3172_Error_t RAK3172_P2P_SetFrequency(const RAK3172_t& p_Device, uint32_t Frequency)
 {
-    if((Frequency < 150000000) || (Frequency > 960000000))
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+PFREQ=" + std::to_string(Frequency));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_Frequency, Frequency, &p_Device.Internal.Shadow.Frequency);
 }
 
 RAK3172_Error_t RAK3172_P2P_GetFrequency(const RAK3172_t& p_Device, uint32_t* const p_Frequency)
 {
-    std::string Value;
-
-    if(p_Frequency == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PFREQ=?", &Value));
-
-    *p_Frequency = std::stoi(Value);
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_Frequency, p_Frequency, &p_Device.Internal.Shadow.Frequency);
 }
 
 RAK3172_Error_t RAK3172_P2P_SetSpreading(const RAK3172_t& p_Device, RAK3172_PSF_t SF)
 {
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if((SF > RAK_PSF_12) || (SF < RAK_PSF_5))
-    #else
-        if((SF > RAK_PSF_12) || (SF < RAK_PSF_6))
-    #endif
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+PSF=" + std::to_string(SF));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_Spreading, SF, &p_Device.Internal.Shadow.Spreading);
 }
 
 RAK3172_Error_t RAK3172_P2P_GetSpreading(const RAK3172_t& p_Device, RAK3172_PSF_t* const p_SF)
 {
-    std::string Value;
-
-    if(p_SF == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PSF=?", &Value));
-
-    *p_SF = static_cast<RAK3172_PSF_t>(std::stoi(Value));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_Spreading, p_SF, &p_Device.Internal.Shadow.Spreading);
 }
 
 RAK3172_Error_t RAK3172_P2P_SetBandwidth(const RAK3172_t& p_Device, uint32_t Bandwidth)
@@ -228,104 +212,49 @@ RAK3172_Error_t RAK3172_P2P_SetBandwidth(const RAK3172_t& p_Device, RAK3172_BW_t
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+PBW=" + std::to_string(Bandwidth));
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_Bandwidth, Bandwidth, &p_Device.Internal.Shadow.Bandwidth);
 }
 
 RAK3172_Error_t RAK3172_P2P_GetBandwidth(const RAK3172_t& p_Device, RAK3172_BW_t* const p_Bandwidth)
 {
-    std::string Value;
-
-    if(p_Bandwidth == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PBW=?", &Value));
-
-    *p_Bandwidth = static_cast<RAK3172_BW_t>(std::stoi(Value));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_Bandwidth, p_Bandwidth, &p_Device.Internal.Shadow.Bandwidth);
 }
 
 RAK3172_Error_t RAK3172_P2P_SetCodeRate(const RAK3172_t& p_Device, RAK3172_CR_t CodeRate)
 {
-    if(CodeRate > RAK_CR_48)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+PCR=" + std::to_string(CodeRate));  
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_CodeRate, CodeRate, &p_Device.Internal.Shadow.CodeRate);
 }
 
 RAK3172_Error_t RAK3172_P2P_GetCodeRate(const RAK3172_t& p_Device, RAK3172_CR_t* const p_CodeRate)
 {
-    std::string Value;
-
-    if(p_CodeRate == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PCR=?", &Value));
-
-    *p_CodeRate = static_cast<RAK3172_CR_t>(std::stoi(Value));
-
-    return RAK3172_ERR_OK;
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_CodeRate, p_CodeRate, &p_Device.Internal.Shadow.CodeRate);
 }
 
 RAK3172_Error_t RAK3172_P2P_SetPreamble(const RAK3172_t& p_Device, uint16_t Preamble)
 {
-    #ifdef CONFIG_RAK3172_USE_RUI3
-        if(Preamble < 5)
-    #else
-        if(Preamble < 2)
-    #endif
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+PPL=" + std::to_string(Preamble));  
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_Preamble, Preamble, &p_Device.Internal.Shadow.Preamble);
 }
 
 RAK3172_Error_t RAK3172_P2P_GetPreamble(const RAK3172_t& p_Device, uint16_t* const p_Preamble)
 {
-    std::string Value;
-
-    if(p_Preamble == NULL)
-    {
-        return RAK3172_ERR_INVALID_ARG;
-    }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PPL=?", &Value));
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_Preamble, p_Preamble, &p_Device.Internal.Shadow.Preamble);
+}
 
-    *p_Preamble = static_cast<uint16_t>(std::stoi(Value));
+RAK3172_Error_t RAK3172_P2P_SetPower(const RAK3172_t& p_Device, uint8_t Power)
+{
+    return RAK3172_Setting_Set(p_Device, _RAK3172_P2P_Power, Power, &p_Device.Internal.Shadow.Power);
+}
 
-    return RAK3172_ERR_OK;
+RAK3172_Error_t RAK3172_P2P_GetPower(const RAK3172_t& p_Device, uint8_t* const p_Power)
+{
+    return RAK3172_Setting_Get(p_Device, _RAK3172_P2P_Power, p_Power, &p_Device.Internal.Shadow.Power);
 }
 
-RAK3172_Error_t RAK3172_P2P_SetPower(const RAK3172_t& p_Device, uint8_t Power)
+RAK3172_Error_t RAK3172_P2P_Transmit(const RAK3172_t& p_Device, const uint8_t* const p_Buffer, uint8_t Length)
 {
-    if((Power < 5) || (Power > 22))
+    RAK3172_PayloadCommand_t Command;
+
+    if((p_Buffer == NULL) && (Length > 0))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
@@ -333,15 +262,23 @@ RAK3172_Error_t RAK3172_P2P_SetPower(const RAK3172_t& p_Device, uint8_t Power)
     {
         return RAK3172_ERR_INVALID_MODE;
     }
+    else if(Length == 0)
+    {
+        return RAK3172_ERR_OK;
+    }
 
-    return RAK3172_SendCommand(p_Device, "AT+PTP=" + std::to_string(Power));  
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Build(Command, "AT+PSEND=", RAK3172_Command_Hex(p_Buffer, Length)));
 }
 
-RAK3172_Error_t RAK3172_P2P_GetPower(const RAK3172_t& p_Device, uint8_t* const p_Power)
+/** @brief          Wait for a single P2P packet.
+ *  @param p_Device RAK3172 device object
+ *  @param p_Frame  Pointer to receive frame object
+ *  @param Timeout  Receive timeout in milliseconds
+ *  @return         RAK3172_ERR_OK when successful
+ */
+static RAK3172_Error_t RAK3172_P2P_WaitFrame(RAK3172_t& p_Device, RAK3172_RxFrame_t* const p_Frame, uint16_t Timeout)
 {
-    std::string Value;
-
-    if(p_Power == NULL)
+    if(Timeout > 65534)
     {
         return RAK3172_ERR_INVALID_ARG;
     }
@@ -350,73 +287,65 @@ RAK3172_Error_t RAK3172_P2P_GetPower(const RAK3172_t& p_Device, uint8_t* const p
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PTP=?", &Value));
+    // Reset the timeout flag before the receive window is opened, because the timeout can be processed by the event
+    // task before the command returns.
+    p_Device.P2P.isRxTimeout = false;
 
-    *p_Power = static_cast<uint8_t>(std::stoi(Value));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PRECV=", Timeout)));
+
+    while(xQueueReceive(p_Device.Internal.ReceiveQueue, p_Frame, 0) != pdPASS)
+    {
+        if(p_Device.P2P.isRxTimeout)
+        {
+            // A message can be received together with the timeout.
+            return (xQueueReceive(p_Device.Internal.ReceiveQueue, p_Frame, 0) == pdPASS) ? RAK3172_ERR_OK : RAK3172_ERR_TIMEOUT;
+        }
+
+        RAK3172_Events_Wait(p_Device, RAK3172_EVENT_BIT_RX | RAK3172_EVENT_BIT_RX_TIMEOUT, portMAX_DELAY);
+    }
 
     return RAK3172_ERR_OK;
 }
 
-RAK3172_Error_t RAK3172_P2P_Transmit(const RAK3172_t& p_Device, const uint8_t* const p_Buffer, uint8_t Length)
+RAK3172_Error_t RAK3172_P2P_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* const p_Message, uint16_t Timeout)
 {
-    std::string Payload;
+    RAK3172_RxFrame_t Received;
 
-    if((p_Buffer == NULL) && (Length > 0))
+    if(p_Message == NULL)
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
-    else if(Length == 0)
-    {
-        return RAK3172_ERR_OK;
-    }
 
-    // Encode the payload into an ASCII string.
-    for(uint8_t i = 0; i < Length; i++)
-    {
-        char Buffer[3];
+    RAK3172_ERROR_CHECK(RAK3172_P2P_WaitFrame(p_Device, &Received, Timeout));
 
-        sprintf(Buffer, "%02x", ((uint8_t*)p_Buffer)[i]);
-        Payload += std::string(Buffer);
-    }
+    p_Message->RSSI = Received.Info.RSSI;
+    p_Message->SNR = Received.Info.SNR;
+    p_Message->Timestamp = Received.Info.Timestamp;
+    RAK3172_Tools_Bin2Hex(Received.Payload, Received.Info.Length, p_Message->Payload);
 
-    return RAK3172_SendCommand(p_Device, "AT+PSEND=" + Payload);
+    return RAK3172_ERR_OK;
 }
 
-RAK3172_Error_t RAK3172_P2P_Receive(RAK3172_t& p_Device, RAK3172_Rx_t* const p_Message, uint16_t Timeout)
+RAK3172_Error_t RAK3172_P2P_ReceiveBinary(RAK3172_t& p_Device, uint8_t* const p_Buffer, size_t Size, RAK3172_RxInfo_t* const p_Info, uint16_t Timeout)
 {
-    RAK3172_Rx_t* FromQueue = NULL;
+    RAK3172_RxFrame_t Received;
 
-    if((p_Message == NULL) || (Timeout > 65534))
+    if((p_Buffer == NULL) || (p_Info == NULL))
     {
         return RAK3172_ERR_INVALID_ARG;
     }
-    else if((p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK))
-    {
-        return RAK3172_ERR_INVALID_MODE;
-    }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PRECV=" + std::to_string(Timeout)));
+    RAK3172_ERROR_CHECK(RAK3172_P2P_WaitFrame(p_Device, &Received, Timeout));
 
-    p_Device.P2P.isRxTimeout = false;
-    do
+    *p_Info = Received.Info;
+    if(Received.Info.Length > Size)
     {
-        if(xQueueReceive(p_Device.Internal.ReceiveQueue, &FromQueue, 20 / portTICK_PERIOD_MS) == pdPASS)
-        {
-            p_Message->RSSI = FromQueue->RSSI;
-            p_Message->SNR = FromQueue->SNR;
-            p_Message->Payload = FromQueue->Payload;
-
-            delete FromQueue;
+        return RAK3172_ERR_INVALID_SIZE;
+    }
 
-            return RAK3172_ERR_OK;
-        }
-    } while(p_Device.P2P.isRxTimeout == false);
+    memcpy(p_Buffer, Received.Payload, Received.Info.Length);
 
-    return RAK3172_ERR_TIMEOUT;
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_P2P_Listen(RAK3172_t& p_Device, uint16_t Timeout, uint8_t CoreID, uint8_t Priority, uint8_t QueueSize)
@@ -432,9 +361,9 @@ RAK3172_Error_t RAK3172_P2P_Listen(RAK3172_t& p_Device, uint16_t Timeout, uint8_
 
     p_Device.P2P.Timeout = Timeout;
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PRECV=" + std::to_string(p_Device.P2P.Timeout)));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PRECV=", p_Device.P2P.Timeout)));
 
-    p_Device.P2P.ListenQueue = xQueueCreate(QueueSize, sizeof(RAK3172_Rx_t*));
+    p_Device.P2P.ListenQueue = xQueueCreate(QueueSize, sizeof(RAK3172_RxFrame_t));
     if(p_Device.P2P.ListenQueue == NULL)
     {
         RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PRECV=0"));
@@ -465,7 +394,7 @@ RAK3172_Error_t RAK3172_P2P_Listen(RAK3172_t& p_Device, uint16_t Timeout, uint8_
 RAK3172_Error_t RAK3172_P2P_PopItem(const RAK3172_t& p_Device, RAK3172_Rx_t* p_Message)
 {
     uint8_t Items;
-    RAK3172_Rx_t* FromQueue;
+    RAK3172_RxFrame_t Received;
 
     if(p_Message == NULL)
     {
@@ -488,14 +417,15 @@ RAK3172_Error_t RAK3172_P2P_PopItem(const RAK3172_t& p_Device, RAK3172_Rx_t* p_M
         return RAK3172_ERR_FAIL;
     }
 
-    if(xQueueReceive(p_Device.P2P.ListenQueue, &FromQueue, 0) != pdPASS)
+    if(xQueueReceive(p_Device.P2P.ListenQueue, &Received, 0) != pdPASS)
     {
         return RAK3172_ERR_FAIL;
     }
 
-    *p_Message = *FromQueue;
-
-    delete FromQueue;
+    p_Message->RSSI = Received.Info.RSSI;
+    p_Message->SNR = Received.Info.SNR;
+    p_Message->Timestamp = Received.Info.Timestamp;
+    RAK3172_Tools_Bin2Hex(Received.Payload, Received.Info.Length, p_Message->Payload);
 
     return RAK3172_ERR_OK;
 }
@@ -511,10 +441,11 @@ RAK3172_Error_t RAK3172_P2P_Stop(RAK3172_t& p_Device)
         return RAK3172_ERR_OK;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+PRECV=" + std::to_string(RAK_REC_STOP)));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+PRECV=", RAK_REC_STOP)));
 
     p_Device.P2P.Active = false;
     p_Device.Internal.isBusy = false;
+    RAK3172_Events_Signal(p_Device, RAK3172_EVENT_BIT_IDLE);
 
     if(p_Device.P2P.ListenHandle != NULL)
     {
@@ -23,11 +23,10 @@
 
 #include "rak3172.h"
 
+#include "../../Parser/rak3172_number.h"
+
 RAK3172_Error_t RAK3172_P2P_EnableEncryption(RAK3172_t& p_Device, const RAK3172_EncryptKey_t p_Key)
 {
-    std::string Key;
-    char Buffer[3];
-
     if(p_Key == NULL)
     {
         return RAK3172_ERR_INVALID_ARG;
@@ -37,18 +36,11 @@ RAK3172_Error_t RAK3172_P2P_EnableEncryption(RAK3172_t& p_Device, const RAK3172_
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+ENCRY=" + std::to_string(true)));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+ENCRY=", true)));
 
     p_Device.P2P.isEncryptionEnabled = true;
 
-    // Encode the key into an ASCII string.
-    for(uint8_t i = 0; i < 8; i++)
-    {
-        sprintf(Buffer, "%02x", ((uint8_t*)p_Key)[i]);
-        Key += std::string(Buffer);
-    }
-
-    return RAK3172_SendCommand(p_Device, "AT+ENCKEY=" + Key, NULL, NULL);
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+ENCKEY=", RAK3172_Command_Hex(p_Key, 8)), NULL, NULL);
 }
 
 RAK3172_Error_t RAK3172_P2P_DisableEncryption(RAK3172_t& p_Device)
@@ -58,7 +50,7 @@ RAK3172_Error_t RAK3172_P2P_DisableEncryption(RAK3172_t& p_Device)
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+ENCRY=" + std::to_string(false)));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+ENCRY=", false)));
 
     p_Device.P2P.isEncryptionEnabled = false;
 
@@ -80,7 +72,10 @@ RAK3172_Error_t RAK3172_P2P_isEncryptionEnabled(const RAK3172_t& p_Device, bool*
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+ENCRY=?", &Value));
 
-    *p_Enabled = static_cast<bool>(std::stoi(Value));
+    if(RAK3172_Number_To(Value, p_Enabled) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
@@ -92,7 +87,7 @@ RAK3172_Error_t RAK3172_P2P_SetIQ(RAK3172_t& p_Device, bool Enable)
         return RAK3172_ERR_INVALID_MODE;
     }
 
-    return RAK3172_SendCommand(p_Device, "AT+IQINVER=" + std::to_string(Enable));
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+IQINVER=", Enable));
 }
 
 RAK3172_Error_t RAK3172_P2P_GetIQ(RAK3172_t& p_Device, bool* const p_Enable)
@@ -110,7 +105,10 @@ RAK3172_Error_t RAK3172_P2P_GetIQ(RAK3172_t& p_Device, bool* const p_Enable)
 
     RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+IQINVER=?", &Response));
 
-    *p_Enable = static_cast<bool>(std::stoi(Response));
+    if(RAK3172_Number_To(Response, p_Enable) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
 
     return RAK3172_ERR_OK;
 }
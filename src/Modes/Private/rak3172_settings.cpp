@@ -0,0 +1,69 @@
+ /*
+ * rak3172_settings.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Table driven module settings for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include "rak3172_settings.h"
+
+#include "../../Parser/rak3172_number.h"
+
+RAK3172_Error_t RAK3172_Setting_CheckMode(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting)
+{
+    if(((Setting.Mode == RAK_SETTING_LORAWAN) && (p_Device.Mode != RAK_MODE_LORAWAN)) ||
+       ((Setting.Mode == RAK_SETTING_P2P) && (p_Device.Mode != RAK_MODE_P2P) && (p_Device.Mode != RAK_MODE_P2P_FSK)))
+    {
+        return RAK3172_ERR_INVALID_MODE;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+RAK3172_Error_t RAK3172_Setting_Write(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, int64_t Value)
+{
+    if((Value < Setting.Min) || (Value > Setting.Max))
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    RAK3172_ERROR_CHECK(RAK3172_Setting_CheckMode(p_Device, Setting));
+
+    return RAK3172_SendCommand(p_Device, RAK3172_Command_Create(Setting.Command, Value * Setting.Scale));
+}
+
+RAK3172_Error_t RAK3172_Setting_Read(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, int64_t* const p_Value)
+{
+    int64_t Value;
+    std::string Response;
+
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create(Setting.Command, '?'), &Response));
+
+    if(RAK3172_Number_Parse(Response, INT32_MIN, UINT32_MAX, &Value) == false)
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
+
+    // The value is converted into the type of the setting and stored in the shadow, so it must not exceed the range of the setting.
+    Value /= Setting.Scale;
+    if((Value < Setting.Min) || (Value > Setting.Max))
+    {
+        return RAK3172_ERR_INVALID_RESPONSE;
+    }
+
+    *p_Value = Value;
+
+    return RAK3172_ERR_OK;
+}
@@ -0,0 +1,138 @@
+ /*
+ * rak3172_settings.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Table driven module settings for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_SETTINGS_H_
+#define RAK3172_SETTINGS_H_
+
+#include <stdint.h>
+
+#include "rak3172.h"
+
+/** @brief Device modes in which a setting is available.
+ */
+typedef enum
+{
+    RAK_SETTING_ANY         = 0,        /**< Setting is available in all modes. */
+    RAK_SETTING_LORAWAN,                /**< Setting is only available in LoRaWAN mode. */
+    RAK_SETTING_P2P,                    /**< Setting is only available in LoRa P2P or FSK P2P mode. */
+} RAK3172_SettingMode_t;
+
+/** @brief Module setting descriptor. A setting is defined with one line in the setting table of a mode.
+ *         Example: static constexpr RAK3172_Setting_t _RAK3172_LoRaWAN_Retries = { "AT+RETY=", RAK_SETTING_LORAWAN, 0, 7, 1, RAK_SHADOW_RETRIES };
+ */
+typedef struct
+{
+    const char* Command;                /**< Command with the trailing '='. The query command is created by appending '?'. */
+    RAK3172_SettingMode_t Mode;         /**< Required device mode. */
+    int64_t Min;                        /**< Minimum value in the unit of the driver. */
+    int64_t Max;                        /**< Maximum value in the unit of the driver. */
+    uint32_t Scale;                     /**< Factor between the unit of the driver and the unit of the module. */
+    uint32_t Flag;                      /**< Shadow flag of the setting or 0 when the setting isn´t stored in the shadow. */
+} RAK3172_Setting_t;
+
+/** @brief          Check if a setting is available in the current device mode.
+ *  @param p_Device RAK3172 device object
+ *  @param Setting  Setting descriptor
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_MODE when the setting isn´t available in the current mode
+ */
+RAK3172_Error_t RAK3172_Setting_CheckMode(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting);
+
+/** @brief          Check the range of a value and write it into the module.
+ *  @param p_Device RAK3172 device object
+ *  @param Setting  Setting descriptor
+ *  @param Value    Value in the unit of the driver
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_ARG when the value is out of range
+ *                  RAK3172_ERR_INVALID_MODE when the setting isn´t available in the current mode
+ */
+RAK3172_Error_t RAK3172_Setting_Write(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, int64_t Value);
+
+/** @brief          Read a setting from the module.
+ *  @param p_Device RAK3172 device object
+ *  @param Setting  Setting descriptor
+ *  @param p_Value  Pointer to value in the unit of the driver. The value is only changed when successful
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_RESPONSE when the response isn´t a number or when the value is out of range
+ */
+RAK3172_Error_t RAK3172_Setting_Read(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, int64_t* const p_Value);
+
+/** @brief          Write a setting into the module and update the configuration shadow.
+ *  @param p_Device RAK3172 device object
+ *  @param Setting  Setting descriptor
+ *  @param Value    New value
+ *  @param p_Shadow (Optional) Pointer to the shadow entry of the setting
+ *  @return         RAK3172_ERR_OK when successful
+ */
+template<typename T>
+inline RAK3172_Error_t RAK3172_Setting_Set(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, T Value, T* const p_Shadow = NULL)
+{
+    RAK3172_ERROR_CHECK(RAK3172_Setting_Write(p_Device, Setting, static_cast<int64_t>(Value)));
+
+    if(p_Shadow != NULL)
+    {
+        *p_Shadow = Value;
+        p_Device.Internal.Shadow.Valid |= Setting.Flag;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+/** @brief          Get a setting from the configuration shadow or from the module when the shadow entry isn´t valid.
+ *  @param p_Device RAK3172 device object
+ *  @param Setting  Setting descriptor
+ *  @param p_Value  Pointer to value
+ *  @param p_Shadow (Optional) Pointer to the shadow entry of the setting
+ *  @return         RAK3172_ERR_OK when successful
+ *                  RAK3172_ERR_INVALID_ARG when an invalid argument is passed into the function
+ *                  RAK3172_ERR_INVALID_RESPONSE when the module value isn´t a number or when it is out of range
+ */
+template<typename T>
+inline RAK3172_Error_t RAK3172_Setting_Get(const RAK3172_t& p_Device, const RAK3172_Setting_t& Setting, T* const p_Value, T* const p_Shadow = NULL)
+{
+    int64_t Value;
+
+    if(p_Value == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    RAK3172_ERROR_CHECK(RAK3172_Setting_CheckMode(p_Device, Setting));
+
+    if((p_Shadow != NULL) && ((p_Device.Internal.Shadow.Valid & Setting.Flag) != 0))
+    {
+        *p_Value = *p_Shadow;
+
+        return RAK3172_ERR_OK;
+    }
+
+    RAK3172_ERROR_CHECK(RAK3172_Setting_Read(p_Device, Setting, &Value));
+
+    *p_Value = static_cast<T>(Value);
+
+    if(p_Shadow != NULL)
+    {
+        *p_Shadow = *p_Value;
+        p_Device.Internal.Shadow.Valid |= Setting.Flag;
+    }
+
+    return RAK3172_ERR_OK;
+}
+
+#endif /* RAK3172_SETTINGS_H_ */
@@ -17,50 +17,108 @@
  * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
  */
 
+#include "rak3172_command.h"
+
 #include "rak3172_tools.h"
 
-void RAK3172_Tools_Hex2ASCII(std::string Hex, uint8_t* const p_Buffer)
+/** @brief Marker for invalid characters in the nibble table. The high bit survives the OR of any number of entries.
+ */
+#define RAK3172_TOOLS_NIBBLE_INVALID                    0xFF
+
+/** @brief Lookup table with the nibble value of each character.
+ */
+typedef struct
 {
-    size_t Offset;
-    uint8_t High = 0;
+    uint8_t Value[256];                     /**< Nibble value or #RAK3172_TOOLS_NIBBLE_INVALID. */
+} RAK3172_NibbleTable_t;
 
-    if((p_Buffer == NULL) || ((Hex.size() % 2) != 0))
-    {
-        return;
-    }
+/** @brief  Create the lookup table for the nibble values of hex characters.
+ *  @return Lookup table
+ */
+static constexpr RAK3172_NibbleTable_t RAK3172_Tools_NibbleTable(void)
+{
+    RAK3172_NibbleTable_t Table = {};
 
-    Offset = 0;
-    for(size_t i = 0; i < Hex.size(); i++)
+    for(size_t i = 0; i < 256; i++)
     {
-        uint8_t Temp = 0;
-
-        if((Hex.at(i) >= '0') && (Hex.at(i) <= '9'))
+        if((i >= '0') && (i <= '9'))
         {
-            Temp = static_cast<uint8_t>(Hex.at(i)) - 48;
+            Table.Value[i] = static_cast<uint8_t>(i - '0');
         }
-        else if((Hex.at(i) >= 'a') && (Hex.at(i) <= 'f'))
+        else if((i >= 'a') && (i <= 'f'))
         {
-            Temp = static_cast<uint8_t>(Hex.at(i)) - 'a' + 10;
+            Table.Value[i] = static_cast<uint8_t>(i - 'a' + 10);
         }
-        else if((Hex.at(i) >= 'A') && (Hex.at(i) <= 'F'))
+        else if((i >= 'A') && (i <= 'F'))
         {
-            Temp = static_cast<uint8_t>(Hex.at(i)) - 'A' + 10;
+            Table.Value[i] = static_cast<uint8_t>(i - 'A' + 10);
         }
         else
         {
-            // Invalid character – abort conversion
-            return;
+            Table.Value[i] = RAK3172_TOOLS_NIBBLE_INVALID;
         }
+    }
 
-        // Save the high byte.
-        if((i % 2) == 0)
-        {
-            High = Temp;
-        }
-        // Save the low byte and push the result to the string.
-        else
+    return Table;
+}
+
+static constexpr RAK3172_NibbleTable_t _RAK3172_Tools_Nibbles = RAK3172_Tools_NibbleTable();
+
+int RAK3172_Tools_Hex2Bin(const char* p_Hex, size_t Length, uint8_t* const p_Buffer, size_t Size)
+{
+    uint8_t Invalid;
+    const uint8_t* p_Input;
+
+    if(((p_Hex == NULL) && (Length > 0)) || ((p_Buffer == NULL) && (Length > 0)) || ((Length % 2) != 0) || ((Length / 2) > Size))
+    {
+        return -1;
+    }
+
+    // Byte i is written after the characters 2i and 2i + 1 are read, so the output can overwrite the input.
+    // The characters are validated once after the loop to keep the loop free of branches.
+    Invalid = 0;
+    p_Input = reinterpret_cast<const uint8_t*>(p_Hex);
+    for(size_t i = 0; i < (Length / 2); i++)
+    {
+        uint8_t High = _RAK3172_Tools_Nibbles.Value[p_Input[2 * i]];
+        uint8_t Low = _RAK3172_Tools_Nibbles.Value[p_Input[(2 * i) + 1]];
+
+        Invalid |= High | Low;
+        p_Buffer[i] = static_cast<uint8_t>((High << 0x04) | (Low & 0x0F));
+    }
+
+    if(Invalid & 0x80)
+    {
+        return -1;
+    }
+
+    return static_cast<int>(Length / 2);
+}
+
+size_t RAK3172_Tools_HexSpan(const char* p_Hex, size_t Length)
+{
+    size_t i;
+
+    for(i = 0; i < Length; i++)
+    {
+        if(_RAK3172_Tools_Nibbles.Value[static_cast<uint8_t>(p_Hex[i])] == RAK3172_TOOLS_NIBBLE_INVALID)
         {
-            *(p_Buffer + (Offset++)) = static_cast<uint8_t>((High << 0x04) + Temp);
+            break;
         }
     }
-}
\ No newline at end of file
+
+    return i;
+}
+
+void RAK3172_Tools_Bin2Hex(const uint8_t* const p_Buffer, size_t Length, std::string& p_Hex)
+{
+    if(p_Buffer == NULL)
+    {
+        p_Hex.clear();
+
+        return;
+    }
+
+    p_Hex.resize(Length * 2);
+    RAK3172_Command_EncodeHex(&p_Hex[0], p_Buffer, Length, true);
+}
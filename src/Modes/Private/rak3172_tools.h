@@ -21,14 +21,44 @@
 #define RAK3172_TOOLS_H_
 
 #include <string>
+#include <string_view>
 
 #include "rak3172_defs.h"
 
-/** @brief          Convert a hex string into a decimal buffer.
- *  @param Hex      Input hex string
+/** @brief          Convert a hex string into a binary buffer.
+ *                  NOTE: The output buffer can point to the hex characters to decode in place. The content of the output
+ *                  buffer is undefined when the input is invalid.
+ *  @param p_Hex    Pointer to hex characters
+ *  @param Length   Number of hex characters
  *  @param p_Buffer Output buffer
- *                  NOTE: The size of the buffer must be large enough to carry all values from the input string!
+ *  @param Size     Size of the output buffer in bytes
+ *  @return         Number of bytes written into the output buffer or -1 when the input is invalid or doesn´t fit into the buffer
  */
-void RAK3172_Tools_Hex2ASCII(std::string& Hex, uint8_t* const p_Buffer);
+int RAK3172_Tools_Hex2Bin(const char* p_Hex, size_t Length, uint8_t* const p_Buffer, size_t Size);
+
+/** @brief          Convert a hex string into a binary buffer.
+ *  @param Hex      Hex characters
+ *  @param p_Buffer Output buffer
+ *  @param Size     Size of the output buffer in bytes
+ *  @return         Number of bytes written into the output buffer or -1 when the input is invalid or doesn´t fit into the buffer
+ */
+inline int RAK3172_Tools_Hex2Bin(std::string_view Hex, uint8_t* const p_Buffer, size_t Size)
+{
+    return RAK3172_Tools_Hex2Bin(Hex.data(), Hex.size(), p_Buffer, Size);
+}
+
+/** @brief          Get the number of hex characters at the beginning of a string.
+ *  @param p_Hex    Pointer to characters
+ *  @param Length   Number of characters
+ *  @return         Number of characters before the first character that isn´t a hex character
+ */
+size_t RAK3172_Tools_HexSpan(const char* p_Hex, size_t Length);
+
+/** @brief          Convert a binary buffer into a hex string.
+ *  @param p_Buffer Input buffer
+ *  @param Length   Length of the input buffer in bytes
+ *  @param p_Hex    Output hex string with upper case characters
+ */
+void RAK3172_Tools_Bin2Hex(const uint8_t* const p_Buffer, size_t Length, std::string& p_Hex);
 
 #endif /* RAK3172_TOOLS_H_ */
\ No newline at end of file
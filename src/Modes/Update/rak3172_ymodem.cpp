@@ -368,12 +368,12 @@ RAK3172_Error_t RAK3172_RunUpdate(RAK3172_t& p_Device, const uint8_t* const p_Da
 		return RAK3172_ERR_BUSY;
 	}
 
-	vTaskSuspend(p_Device.Internal.Handle);
+	RAK3172_UART_SuspendEvents(p_Device);
 
 	Error = RAK3172_Ymodem_Transmit(p_Device, p_Data, Length, NULL, 0);
 
 	uart_flush(p_Device.UART.Interface);
-	vTaskResume(p_Device.Internal.Handle);
+	RAK3172_UART_ResumeEvents(p_Device);
 
 	// Leave DFU mode.
 	if(Error == RAK3172_ERR_OK)
@@ -0,0 +1,181 @@
+ /*
+ * rak3172_classifier.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Line classifier for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <array>
+
+#include "rak3172_classifier.h"
+
+/** @brief Event token object.
+ */
+typedef struct
+{
+    const char* Token;                  /**< Token without the "+EVT:" prefix. */
+    uint8_t Length;                     /**< Length of the token. */
+    RAK3172_Event_t Event;              /**< Event type for the token. */
+} RAK3172_Token_t;
+
+/** @brief Token bucket for all tokens with the same first character.
+ */
+typedef struct
+{
+    uint8_t First;                      /**< Index of the first token in the token table. */
+    uint8_t Count;                      /**< Number of tokens in the bucket. */
+} RAK3172_Bucket_t;
+
+#define RAK3172_TOKEN(Token, Event)             {Token, sizeof(Token) - 1, Event}
+
+#define RAK3172_EVENT_PREFIX                    "+EVT:"
+#define RAK3172_RESTRICTED_PREFIX               "Restricted_Wait"
+
+/** @brief Event tokens. The tokens must be sorted by the first character and a token must be placed in front of every
+ *         other token it starts with. A '_' in a token also matches a ' ', because firmware without RUI3 uses spaces.
+ */
+static constexpr RAK3172_Token_t _RAK3172_Tokens[] = {
+    RAK3172_TOKEN("JOINED",                 RAK_EVENT_JOINED),
+    RAK3172_TOKEN("JOIN_FAILED",            RAK_EVENT_JOIN_FAILED),
+    RAK3172_TOKEN("RXP2P_RECEIVE_TIMEOUT",  RAK_EVENT_P2P_RX_TIMEOUT),
+    RAK3172_TOKEN("RXP2P",                  RAK_EVENT_P2P_RX),
+    RAK3172_TOKEN("RX_",                    RAK_EVENT_RX),
+    RAK3172_TOKEN("SEND_CONFIRMED_OK",      RAK_EVENT_CONFIRMED_OK),
+    RAK3172_TOKEN("SEND_CONFIRMED_FAILED",  RAK_EVENT_CONFIRMED_FAILED),
+    RAK3172_TOKEN("TX_DONE",                RAK_EVENT_TX_DONE),
+};
+
+/** @brief          Generate the token buckets for the characters 'A' to 'Z'.
+ *  @return         Token buckets
+ */
+static constexpr std::array<RAK3172_Bucket_t, 26> RAK3172_Classifier_GetBuckets(void)
+{
+    std::array<RAK3172_Bucket_t, 26> Buckets = {};
+
+    for(uint8_t i = 0; i < (sizeof(_RAK3172_Tokens) / sizeof(_RAK3172_Tokens[0])); i++)
+    {
+        RAK3172_Bucket_t& Bucket = Buckets[_RAK3172_Tokens[i].Token[0] - 'A'];
+
+        if(Bucket.Count == 0)
+        {
+            Bucket.First = i;
+        }
+
+        Bucket.Count++;
+    }
+
+    return Buckets;
+}
+
+/** @brief          Check if the tokens are grouped by the first character.
+ *  @return         #true when the token table is valid
+ */
+static constexpr bool RAK3172_Classifier_isSorted(void)
+{
+    for(uint8_t i = 1; i < (sizeof(_RAK3172_Tokens) / sizeof(_RAK3172_Tokens[0])); i++)
+    {
+        if(_RAK3172_Tokens[i].Token[0] < _RAK3172_Tokens[i - 1].Token[0])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(RAK3172_Classifier_isSorted(), "Event tokens must be sorted by the first character!");
+
+static constexpr std::array<RAK3172_Bucket_t, 26> _RAK3172_Buckets = RAK3172_Classifier_GetBuckets();
+
+/** @brief          Check if a line starts with a token.
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ *  @param p_Token  Token
+ *  @param TokenLength Length of the token
+ *  @return         #true when the line starts with the token
+ */
+static inline bool RAK3172_Classifier_StartsWith(const char* p_Line, size_t Length, const char* p_Token, size_t TokenLength)
+{
+    if(Length < TokenLength)
+    {
+        return false;
+    }
+
+    for(size_t i = 0; i < TokenLength; i++)
+    {
+        if((p_Line[i] != p_Token[i]) && ((p_Token[i] != '_') || (p_Line[i] != ' ')))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+RAK3172_Event_t RAK3172_Classifier_Classify(const char* p_Line, size_t Length, size_t* const p_Offset)
+{
+    char First;
+    size_t Offset;
+    const RAK3172_Bucket_t* Bucket;
+
+    if((p_Line == NULL) || (Length == 0))
+    {
+        return RAK_EVENT_NONE;
+    }
+
+    if(p_Line[0] == 'R')
+    {
+        if(RAK3172_Classifier_StartsWith(p_Line, Length, RAK3172_RESTRICTED_PREFIX, sizeof(RAK3172_RESTRICTED_PREFIX) - 1))
+        {
+            return RAK_EVENT_RESTRICTED;
+        }
+
+        return RAK_EVENT_NONE;
+    }
+    else if((p_Line[0] != '+') || (RAK3172_Classifier_StartsWith(p_Line, Length, RAK3172_EVENT_PREFIX, sizeof(RAK3172_EVENT_PREFIX) - 1) == false))
+    {
+        return RAK_EVENT_NONE;
+    }
+
+    Offset = sizeof(RAK3172_EVENT_PREFIX) - 1;
+    if(Length == Offset)
+    {
+        return RAK_EVENT_UNKNOWN;
+    }
+
+    First = p_Line[Offset];
+    if((First < 'A') || (First > 'Z'))
+    {
+        return RAK_EVENT_UNKNOWN;
+    }
+
+    Bucket = &_RAK3172_Buckets[First - 'A'];
+    for(uint8_t i = Bucket->First; i < (Bucket->First + Bucket->Count); i++)
+    {
+        const RAK3172_Token_t* Token = &_RAK3172_Tokens[i];
+
+        if(RAK3172_Classifier_StartsWith(&p_Line[Offset], Length - Offset, Token->Token, Token->Length))
+        {
+            if(p_Offset != NULL)
+            {
+                *p_Offset = Offset + Token->Length;
+            }
+
+            return Token->Event;
+        }
+    }
+
+    return RAK_EVENT_UNKNOWN;
+}
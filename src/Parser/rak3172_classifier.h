@@ -0,0 +1,37 @@
+ /*
+ * rak3172_classifier.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Line classifier for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_CLASSIFIER_H_
+#define RAK3172_CLASSIFIER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rak3172_event_types.h"
+
+/** @brief          Classify a line received from the module.
+ *                  NOTE: The line is processed in a single pass and the spellings of RUI3 and older firmware are supported.
+ *  @param p_Line   Pointer to line without line ending
+ *  @param Length   Length of the line
+ *  @param p_Offset (Optional) Offset of the first character after the detected token
+ *  @return         Line type
+ */
+RAK3172_Event_t RAK3172_Classifier_Classify(const char* p_Line, size_t Length, size_t* const p_Offset = NULL);
+
+#endif /* RAK3172_CLASSIFIER_H_ */
@@ -0,0 +1,146 @@
+ /*
+ * rak3172_line_parser.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Stream line parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <string.h>
+
+#include "rak3172_line_parser.h"
+
+/** @brief          Append a line segment without line ending to the current line.
+ *  @param p_Parser Pointer to parser object
+ *  @param p_Data   Pointer to segment
+ *  @param Length   Length of the segment
+ */
+static void RAK3172_LineParser_Append(RAK3172_LineParser_t* const p_Parser, const char* p_Data, size_t Length)
+{
+    size_t Free;
+    char* Segment;
+    char* Return;
+
+    Free = p_Parser->Size - 1 - p_Parser->Length;
+    if(Length > Free)
+    {
+        Length = Free;
+        p_Parser->isTruncated = true;
+    }
+
+    Segment = &p_Parser->Buffer[p_Parser->Length];
+    memcpy(Segment, p_Data, Length);
+
+    // Remove the '\r' from the segment. Usually there is only one at the end of the line.
+    Return = static_cast<char*>(memchr(Segment, '\r', Length));
+    if(Return != NULL)
+    {
+        char* Write = Return;
+
+        for(const char* Read = Return + 1; Read < (Segment + Length); Read++)
+        {
+            if(*Read != '\r')
+            {
+                *Write++ = *Read;
+            }
+        }
+
+        Length = Write - Segment;
+    }
+
+    p_Parser->Length += Length;
+}
+
+void RAK3172_LineParser_Init(RAK3172_LineParser_t* const p_Parser, char* p_Buffer, size_t Size, RAK3172_LineParser_Callback_t Callback, void* p_Arg)
+{
+    if((p_Parser == NULL) || (p_Buffer == NULL) || (Size < 2))
+    {
+        return;
+    }
+
+    p_Parser->Buffer = p_Buffer;
+    p_Parser->Size = Size;
+    p_Parser->Truncated = 0;
+    p_Parser->Callback = Callback;
+    p_Parser->Arg = p_Arg;
+
+    RAK3172_LineParser_Reset(p_Parser, false);
+}
+
+void RAK3172_LineParser_Reset(RAK3172_LineParser_t* const p_Parser, bool Discard)
+{
+    if(p_Parser == NULL)
+    {
+        return;
+    }
+
+    p_Parser->Length = 0;
+    p_Parser->isTruncated = false;
+    p_Parser->isDiscarding = Discard;
+}
+
+size_t RAK3172_LineParser_Feed(RAK3172_LineParser_t* const p_Parser, const void* p_Data, size_t Length)
+{
+    size_t Lines;
+    const char* Data;
+    const char* End;
+
+    if((p_Parser == NULL) || (p_Data == NULL))
+    {
+        return 0;
+    }
+
+    Lines = 0;
+    Data = static_cast<const char*>(p_Data);
+    End = Data + Length;
+    while(Data < End)
+    {
+        const char* NewLine;
+
+        NewLine = static_cast<const char*>(memchr(Data, '\n', End - Data));
+
+        if(p_Parser->isDiscarding == false)
+        {
+            RAK3172_LineParser_Append(p_Parser, Data, ((NewLine != NULL) ? NewLine : End) - Data);
+        }
+
+        // The line continues with the next chunk.
+        if(NewLine == NULL)
+        {
+            break;
+        }
+
+        if(p_Parser->isDiscarding == false)
+        {
+            if(p_Parser->isTruncated)
+            {
+                p_Parser->Truncated++;
+            }
+
+            p_Parser->Buffer[p_Parser->Length] = '\0';
+            if(p_Parser->Callback != NULL)
+            {
+                p_Parser->Callback(p_Parser->Arg, p_Parser->Buffer, p_Parser->Length);
+            }
+
+            Lines++;
+        }
+
+        RAK3172_LineParser_Reset(p_Parser, false);
+
+        Data = NewLine + 1;
+    }
+
+    return Lines;
+}
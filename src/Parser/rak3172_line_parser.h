@@ -0,0 +1,73 @@
+ /*
+ * rak3172_line_parser.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Stream line parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_LINE_PARSER_H_
+#define RAK3172_LINE_PARSER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief          Line callback definition.
+ *  @param p_Arg    User argument of the parser
+ *  @param p_Line   Pointer to zero terminated line without line ending
+ *  @param Length   Length of the line
+ */
+typedef void (*RAK3172_LineParser_Callback_t)(void* p_Arg, char* p_Line, size_t Length);
+
+/** @brief Stream line parser object.
+ */
+typedef struct
+{
+    char* Buffer;                               /**< Line assembly buffer. */
+    size_t Size;                                /**< Size of the line assembly buffer including the string termination. */
+    size_t Length;                              /**< Length of the current line. */
+    bool isTruncated;                           /**< #true when the current line doesn´t fit into the buffer. */
+    bool isDiscarding;                          /**< #true when the current line is dropped until the next line ending. */
+    uint32_t Truncated;                         /**< Number of truncated lines. */
+    RAK3172_LineParser_Callback_t Callback;     /**< Callback for each complete line. */
+    void* Arg;                                  /**< User argument for the callback. */
+} RAK3172_LineParser_t;
+
+/** @brief          Initialize a stream line parser.
+ *  @param p_Parser Pointer to parser object
+ *  @param p_Buffer Pointer to line assembly buffer
+ *  @param Size     Size of the line assembly buffer in bytes
+ *                  NOTE: One byte is used for the string termination!
+ *  @param Callback Callback for each complete line
+ *  @param p_Arg    (Optional) User argument for the callback
+ */
+void RAK3172_LineParser_Init(RAK3172_LineParser_t* const p_Parser, char* p_Buffer, size_t Size, RAK3172_LineParser_Callback_t Callback, void* p_Arg = NULL);
+
+/** @brief          Drop the current line.
+ *  @param p_Parser Pointer to parser object
+ *  @param Discard  #true when all data until the next line ending should be dropped (i. e. after lost data)
+ */
+void RAK3172_LineParser_Reset(RAK3172_LineParser_t* const p_Parser, bool Discard);
+
+/** @brief          Process a chunk of received data. The callback is called for each line that is completed by the chunk.
+ *                  Lines can be split across any number of chunks. All '\r' are removed and '\n' terminates a line.
+ *                  NOTE: Lines which doesn´t fit into the buffer are truncated.
+ *  @param p_Parser Pointer to parser object
+ *  @param p_Data   Pointer to received data
+ *  @param Length   Length of the received data
+ *  @return         Number of completed lines
+ */
+size_t RAK3172_LineParser_Feed(RAK3172_LineParser_t* const p_Parser, const void* p_Data, size_t Length);
+
+#endif /* RAK3172_LINE_PARSER_H_ */
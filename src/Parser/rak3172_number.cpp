@@ -0,0 +1,112 @@
+ /*
+ * rak3172_number.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Exception free number parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include "rak3172_number.h"
+
+bool RAK3172_Number_Parse(std::string_view Text, int64_t Min, int64_t Max, int64_t* const p_Value, uint8_t Base)
+{
+    size_t Start;
+    size_t End;
+    bool isNegative;
+    int64_t Result;
+    uint64_t Value;
+    uint64_t Limit;
+
+    if((p_Value == NULL) || ((Base != 10) && (Base != 16)))
+    {
+        return false;
+    }
+
+    Start = 0;
+    End = Text.size();
+    while((Start < End) && (Text[Start] == ' '))
+    {
+        Start++;
+    }
+
+    while((End > Start) && (Text[End - 1] == ' '))
+    {
+        End--;
+    }
+
+    isNegative = false;
+    if((Start < End) && ((Text[Start] == '-') || (Text[Start] == '+')))
+    {
+        isNegative = (Text[Start] == '-');
+        Start++;
+    }
+
+    if(Start == End)
+    {
+        return false;
+    }
+
+    // Largest magnitude which is allowed by the range. Larger values are rejected before they can overflow.
+    Limit = isNegative ? ((Min < 0) ? (static_cast<uint64_t>(-(Min + 1)) + 1) : 0) : ((Max < 0) ? 0 : static_cast<uint64_t>(Max));
+
+    Value = 0;
+    for(size_t i = Start; i < End; i++)
+    {
+        char Character = Text[i];
+        uint8_t Digit;
+
+        if((Character >= '0') && (Character <= '9'))
+        {
+            Digit = Character - '0';
+        }
+        else if((Base == 16) && (Character >= 'a') && (Character <= 'f'))
+        {
+            Digit = Character - 'a' + 10;
+        }
+        else if((Base == 16) && (Character >= 'A') && (Character <= 'F'))
+        {
+            Digit = Character - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+
+        if((Digit > Limit) || (Value > ((Limit - Digit) / Base)))
+        {
+            return false;
+        }
+
+        Value = (Value * Base) + Digit;
+    }
+
+    if(isNegative)
+    {
+        Result = (Value == 0) ? 0 : -static_cast<int64_t>(Value - 1) - 1;
+    }
+    else
+    {
+        Result = static_cast<int64_t>(Value);
+    }
+
+    // A positive minimum isn´t covered by the magnitude limit.
+    if(Result < Min)
+    {
+        return false;
+    }
+
+    *p_Value = Result;
+
+    return true;
+}
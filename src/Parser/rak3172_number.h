@@ -0,0 +1,63 @@
+ /*
+ * rak3172_number.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Exception free number parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_NUMBER_H_
+#define RAK3172_NUMBER_H_
+
+#include <limits>
+#include <stdint.h>
+#include <string_view>
+#include <type_traits>
+
+/** @brief          Parse an integer value from a module response. Leading and trailing spaces are ignored.
+ *  @param Text     Response text
+ *  @param Min      Minimum value
+ *  @param Max      Maximum value
+ *  @param p_Value  Pointer to value
+ *  @param Base     Number base (10 or 16). Hexadecimal values are parsed without prefix
+ *  @return         #true when the text is a number in the range [Min, Max]
+ */
+bool RAK3172_Number_Parse(std::string_view Text, int64_t Min, int64_t Max, int64_t* const p_Value, uint8_t Base = 10);
+
+/** @brief          Parse an integer, boolean or enum value from a module response. The range is limited by the output type.
+ *                  Example: if(RAK3172_Number_To(Response, &Band) == false) { return RAK3172_ERR_INVALID_RESPONSE; }
+ *  @param Text     Response text
+ *  @param p_Value  Pointer to value. The value is only changed when successful
+ *  @param Base     Number base (10 or 16)
+ *  @return         #true when successful
+ */
+template<typename T>
+inline bool RAK3172_Number_To(std::string_view Text, T* const p_Value, uint8_t Base = 10)
+{
+    typedef typename std::conditional<std::is_enum<T>::value, std::underlying_type<T>, std::common_type<T>>::type::type Type;
+    int64_t Value;
+
+    static_assert(std::is_integral<Type>::value && ((sizeof(Type) < sizeof(int64_t)) || std::is_signed<Type>::value), "Unsupported type!");
+
+    if(RAK3172_Number_Parse(Text, std::numeric_limits<Type>::min(), std::numeric_limits<Type>::max(), &Value, Base) == false)
+    {
+        return false;
+    }
+
+    *p_Value = static_cast<T>(Value);
+
+    return true;
+}
+
+#endif /* RAK3172_NUMBER_H_ */
@@ -0,0 +1,200 @@
+ /*
+ * rak3172_rx.cpp
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Receive event parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "rak3172_rx.h"
+
+#include "../Modes/Private/rak3172_tools.h"
+
+#define RAK3172_RX_EVENT_PREFIX                 "+EVT"
+
+/** @brief          Check if the line contains a keyword at the given offset and skip it.
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ *  @param p_Offset Pointer to parser offset
+ *  @param p_Keyword Keyword
+ *  @return         #true when the keyword was skipped
+ */
+static bool RAK3172_Rx_SkipKeyword(const char* p_Line, size_t Length, size_t* const p_Offset, const char* p_Keyword)
+{
+    size_t KeywordLength = strlen(p_Keyword);
+
+    if(((Length - *p_Offset) < KeywordLength) || (memcmp(&p_Line[*p_Offset], p_Keyword, KeywordLength) != 0))
+    {
+        return false;
+    }
+
+    *p_Offset += KeywordLength;
+
+    return true;
+}
+
+/** @brief          Skip all field separators and "+EVT" prefixes.
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ *  @param p_Offset Pointer to parser offset
+ */
+static void RAK3172_Rx_SkipSeparators(const char* p_Line, size_t Length, size_t* const p_Offset)
+{
+    while(*p_Offset < Length)
+    {
+        char Character = p_Line[*p_Offset];
+
+        if((Character == ':') || (Character == ',') || (Character == ' '))
+        {
+            (*p_Offset)++;
+        }
+        else if(RAK3172_Rx_SkipKeyword(p_Line, Length, p_Offset, RAK3172_RX_EVENT_PREFIX) == false)
+        {
+            break;
+        }
+    }
+}
+
+/** @brief          Parse a signed decimal value.
+ *  @param p_Line   Pointer to line
+ *  @param Length   Length of the line
+ *  @param p_Offset Pointer to parser offset
+ *  @param p_Value  Pointer to value
+ *  @return         #true when at least one digit was parsed
+ */
+static bool RAK3172_Rx_ParseInt(const char* p_Line, size_t Length, size_t* const p_Offset, int32_t* const p_Value)
+{
+    bool isNegative;
+    size_t Start;
+    int32_t Value;
+
+    isNegative = false;
+    if((*p_Offset < Length) && ((p_Line[*p_Offset] == '-') || (p_Line[*p_Offset] == '+')))
+    {
+        isNegative = (p_Line[*p_Offset] == '-');
+        (*p_Offset)++;
+    }
+
+    Value = 0;
+    Start = *p_Offset;
+    while((*p_Offset < Length) && (p_Line[*p_Offset] >= '0') && (p_Line[*p_Offset] <= '9') && (Value < 100000))
+    {
+        Value = (Value * 10) + (p_Line[*p_Offset] - '0');
+        (*p_Offset)++;
+    }
+
+    if(*p_Offset == Start)
+    {
+        return false;
+    }
+
+    *p_Value = isNegative ? -Value : Value;
+
+    return true;
+}
+
+bool RAK3172_Rx_ParseHeader(const char* p_Line, size_t Length, size_t* const p_Offset, RAK3172_RxInfo_t* const p_Info)
+{
+    int32_t RSSI;
+    int32_t SNR;
+
+    if((p_Line == NULL) || (p_Offset == NULL) || (p_Info == NULL) || (*p_Offset > Length))
+    {
+        return false;
+    }
+
+    // Formats:
+    //  RUI3        <Group>:<RSSI>:<SNR>
+    //  FW 1.03     <Group>, RSSI <RSSI>, SNR <SNR>
+    RAK3172_Rx_SkipSeparators(p_Line, Length, p_Offset);
+    RAK3172_Rx_SkipKeyword(p_Line, Length, p_Offset, "RSSI");
+    RAK3172_Rx_SkipSeparators(p_Line, Length, p_Offset);
+    if(RAK3172_Rx_ParseInt(p_Line, Length, p_Offset, &RSSI) == false)
+    {
+        return false;
+    }
+
+    RAK3172_Rx_SkipSeparators(p_Line, Length, p_Offset);
+    RAK3172_Rx_SkipKeyword(p_Line, Length, p_Offset, "SNR");
+    RAK3172_Rx_SkipSeparators(p_Line, Length, p_Offset);
+    if(RAK3172_Rx_ParseInt(p_Line, Length, p_Offset, &SNR) == false)
+    {
+        return false;
+    }
+
+    p_Info->RSSI = static_cast<int8_t>(RSSI);
+    p_Info->SNR = static_cast<int8_t>(SNR);
+
+    return true;
+}
+
+bool RAK3172_Rx_ParsePayload(const char* p_Line, size_t Length, size_t Offset, bool hasPort, RAK3172_RxFrame_t* const p_Frame)
+{
+    int Bytes;
+    size_t Start;
+
+    if((p_Line == NULL) || (p_Frame == NULL) || (Offset > Length))
+    {
+        return false;
+    }
+
+    // Formats:
+    //  RUI3        :UNICAST:<Port>:<Payload> or :MULCAST:<Port>:<Payload>
+    //  FW 1.03     +EVT:<Port>:<Payload>
+    //  P2P         :<Payload>
+    RAK3172_Rx_SkipSeparators(p_Line, Length, &Offset);
+    if(hasPort)
+    {
+        int32_t Port;
+
+        // Skip the cast type. RUI3 uses "UNICAST" and "MULCAST", but any word in front of the port is accepted.
+        Start = Offset;
+        while((Offset < Length) && isalpha(static_cast<unsigned char>(p_Line[Offset])))
+        {
+            Offset++;
+        }
+
+        p_Frame->Info.isMulticast = ((Offset - Start) >= 3) && (memcmp(&p_Line[Start], "MUL", 3) == 0);
+
+        RAK3172_Rx_SkipSeparators(p_Line, Length, &Offset);
+        if((RAK3172_Rx_ParseInt(p_Line, Length, &Offset, &Port) == false) || (Port < 0) || (Port > 255))
+        {
+            return false;
+        }
+
+        p_Frame->Info.Port = static_cast<uint8_t>(Port);
+        RAK3172_Rx_SkipSeparators(p_Line, Length, &Offset);
+    }
+
+    // The payload must run to the end of the line and must contain an even number of hex characters.
+    Start = Offset;
+    Offset += RAK3172_Tools_HexSpan(&p_Line[Start], Length - Start);
+    if(((Offset - Start) & 0x01) || ((Offset < Length) && (p_Line[Offset] != '\r') && (p_Line[Offset] != '\n')))
+    {
+        return false;
+    }
+
+    Bytes = RAK3172_Tools_Hex2Bin(&p_Line[Start], Offset - Start, p_Frame->Payload, sizeof(p_Frame->Payload));
+    if(Bytes < 0)
+    {
+        return false;
+    }
+
+    p_Frame->Info.Length = static_cast<uint16_t>(Bytes);
+
+    return true;
+}
@@ -0,0 +1,48 @@
+ /*
+ * rak3172_rx.h
+ *
+ *  Copyright (C) Daniel Kampert, 2025
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Receive event parser for the RAK3172 driver.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de.
+ */
+
+#ifndef RAK3172_RX_H_
+#define RAK3172_RX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rak3172_defs.h"
+
+/** @brief          Parse the RSSI and the SNR of a receive event.
+ *                  NOTE: The separators and the "RSSI" and "SNR" keywords of RUI3 and older firmware are supported.
+ *  @param p_Line   Pointer to line without line ending
+ *  @param Length   Length of the line
+ *  @param p_Offset Pointer to parser offset. The offset points to the first character after the SNR value when successful
+ *  @param p_Info   Pointer to receive information object
+ *  @return         #true when successful
+ */
+bool RAK3172_Rx_ParseHeader(const char* p_Line, size_t Length, size_t* const p_Offset, RAK3172_RxInfo_t* const p_Info);
+
+/** @brief          Parse the cast type, the port and the payload of a receive event and decode the payload into a binary buffer.
+ *  @param p_Line   Pointer to line without line ending
+ *  @param Length   Length of the line
+ *  @param Offset   Offset of the first character after the header
+ *  @param hasPort  #true when the payload is preceded by the cast type and the port (LoRaWAN)
+ *  @param p_Frame  Pointer to receive frame object. The length of the payload is stored in the frame information
+ *  @return         #true when successful. #false when the payload has an odd length or contains a non hex character
+ */
+bool RAK3172_Rx_ParsePayload(const char* p_Line, size_t Length, size_t Offset, bool hasPort, RAK3172_RxFrame_t* const p_Frame);
+
+#endif /* RAK3172_RX_H_ */
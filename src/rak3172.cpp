@@ -18,12 +18,17 @@
  */
 
 #include <algorithm>
+#include <string.h>
 
 #include <sdkconfig.h>
 
 #include "rak3172.h"
 
 #include "Arch/rak3172_arch.h"
+#include "Commands/rak3172_lock.h"
+#include "Commands/rak3172_trace.h"
+#include "Arch/UART/rak3172_capture.h"
+#include "Commands/rak3172_commands_async.h"
 
 static const char* TAG      = "RAK3172";
 
@@ -34,7 +39,7 @@ static const char* TAG      = "RAK3172";
  */
 static RAK3172_Error_t RAK3172_ReceiveSplashScreen(RAK3172_t& p_Device, uint16_t Timeout = 1000)
 {
-    std::string* Response = NULL;
+    RAK3172_Line_t* Response = NULL;
 
     do
     {
@@ -47,33 +52,82 @@ static RAK3172_Error_t RAK3172_ReceiveSplashScreen(RAK3172_t& p_Device, uint16_t
             return RAK3172_ERR_TIMEOUT;
         }
 
-        RAK3172_LOGD(TAG, "Response: %s", Response->c_str());
+        RAK3172_LOGD(TAG, "Response: %s", Response->Data);
 
         // The driver was compiled for RUI3, but an older splash screen was received (version 1.4.0 and below).
         #ifdef CONFIG_RAK3172_USE_RUI3
-            if(Response->find("Version.") != std::string::npos)
+            if(strstr(Response->Data, "Version.") != NULL)
             {
                 RAK3172_LOGE(TAG, "Firmware compiled for RUI3, but module firmware does not support RUI3!");
 
+                RAK3172_UART_ReleaseLine(p_Device, Response);
                 p_Device.Internal.isBusy = false;
 
                 return RAK3172_ERR_INVALID_RESPONSE;
             }
         #endif
 
-        if((Response->find("LoRaWAN.") != std::string::npos) || (Response->find("LoRa P2P.") != std::string::npos))
+        if((strstr(Response->Data, "LoRaWAN.") != NULL) || (strstr(Response->Data, "LoRa P2P.") != NULL))
         {
             p_Device.Internal.isBusy = false;
         }
 
-        delete Response;
+        RAK3172_UART_ReleaseLine(p_Device, Response);
     } while(p_Device.Internal.isBusy);
 
     return RAK3172_ERR_OK;
 }
 
+/** @brief          Release the serial interface and the queues, buffers and events created by the UART initialization.
+ *  @param p_Device RAK3172 device object
+ */
+static void RAK3172_FreeResources(RAK3172_t& p_Device)
+{
+    RAK3172_UART_Deinit(p_Device);
+
+    if(p_Device.Internal.MessageQueue != NULL)
+    {
+        vQueueDelete(p_Device.Internal.MessageQueue);
+        p_Device.Internal.MessageQueue = NULL;
+    }
+
+    if(p_Device.Internal.ReceiveQueue != NULL)
+    {
+        vQueueDelete(p_Device.Internal.ReceiveQueue);
+        p_Device.Internal.ReceiveQueue = NULL;
+    }
+
+    if(p_Device.Internal.RxBuffer != NULL)
+    {
+        free(p_Device.Internal.RxBuffer);
+        p_Device.Internal.RxBuffer = NULL;
+    }
+
+    if(p_Device.Internal.LineFreeQueue != NULL)
+    {
+        vQueueDelete(p_Device.Internal.LineFreeQueue);
+        p_Device.Internal.LineFreeQueue = NULL;
+    }
+
+    if(p_Device.Internal.LinePool != NULL)
+    {
+        free(p_Device.Internal.LinePool);
+        p_Device.Internal.LinePool = NULL;
+    }
+
+    if(p_Device.Internal.EventGroup != NULL)
+    {
+        vEventGroupDelete(p_Device.Internal.EventGroup);
+        p_Device.Internal.EventGroup = NULL;
+    }
+
+    p_Device.Internal.isInitialized = false;
+    p_Device.Internal.isBusy = false;
+}
+
 RAK3172_Error_t RAK3172_Init(RAK3172_t& p_Device)
 {
+    RAK3172_Error_t Error;
     std::string Response;
 
     #ifdef CONFIG_RAK3172_RESET_USE_HW
@@ -131,35 +185,71 @@ RAK3172_Error_t RAK3172_Init(RAK3172_t& p_Device)
         RAK3172_LOGI(TAG, "     [x] Software reset");
     #endif
 
-    RAK3172_ERROR_CHECK(RAK3172_UART_Init(p_Device));
+    RAK3172_ERROR_CHECK(RAK3172_Lock_Init(p_Device));
+
+    Error = RAK3172_Trace_Init(p_Device);
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_Init_Error_1;
+    }
+
+    Error = RAK3172_UART_Init(p_Device);
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_Init_Error_2;
+    }
+
+    #ifdef CONFIG_RAK3172_COMMAND_ASYNC
+        Error = RAK3172_Commands_StartAsync(p_Device);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_Init_Error_3;
+        }
+    #endif
 
     #ifdef CONFIG_RAK3172_RESET_USE_HW
-        RAK3172_ERROR_CHECK(RAK3172_HardReset(p_Device));
+        Error = RAK3172_HardReset(p_Device);
     #else
-        RAK3172_ERROR_CHECK(RAK3172_SoftReset(p_Device));
+        Error = RAK3172_SoftReset(p_Device);
     #endif
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_Init_Error_3;
+    }
 
     vTaskDelay(500 / portTICK_PERIOD_MS);
 
     // Firmware without RUI3 will produce a MIC mismatch when using a factory reset during the initialization.
     #if((defined CONFIG_RAK3172_FACTORY_RESET) && (defined CONFIG_RAK3172_USE_RUI3))
-        RAK3172_ERROR_CHECK(RAK3172_FactoryReset(p_Device));
+        Error = RAK3172_FactoryReset(p_Device);
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_Init_Error_3;
+        }
+
         vTaskDelay(500 / portTICK_PERIOD_MS);
     #endif
 
     // Check if echo mode is enabled.
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT", NULL, &Response));
+    Error = RAK3172_SendCommand(p_Device, "AT", NULL, &Response);
+    if(Error != RAK3172_ERR_OK)
+    {
+        goto RAK3172_Init_Error_3;
+    }
+
     RAK3172_LOGD(TAG, "Response from 'AT': %s", Response.c_str());
     if(Response.find("OK") == std::string::npos)
     {
-        std::string* Dummy;
+        RAK3172_Line_t* Dummy;
+        constexpr std::string_view Command = "ATE\r\n";
 
         // Echo mode is enabled. Need to receive one more line.
         if(xQueueReceive(p_Device.Internal.MessageQueue, &Dummy, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
         {
-            return RAK3172_ERR_TIMEOUT;
+            Error = RAK3172_ERR_TIMEOUT;
+            goto RAK3172_Init_Error_3;
         }
-        delete Dummy;
+        RAK3172_UART_ReleaseLine(p_Device, Dummy);
 
         RAK3172_LOGD(TAG, "Echo mode enabled. Disabling echo mode...");
 
@@ -168,76 +258,101 @@ RAK3172_Error_t RAK3172_Init(RAK3172_t& p_Device)
         //  -> Receive the echo
         //  -> Receive the value
         //  -> Receive the status
-        RAK3172_UART_WriteBytes(p_Device, "ATE\r\n", std::string("ATE\r\n").length());
+        RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size());
         if(xQueueReceive(p_Device.Internal.MessageQueue, &Dummy, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
         {
-            return RAK3172_ERR_TIMEOUT;
+            Error = RAK3172_ERR_TIMEOUT;
+            goto RAK3172_Init_Error_3;
         }
-        delete Dummy;
+        RAK3172_UART_ReleaseLine(p_Device, Dummy);
 
         #ifndef CONFIG_RAK3172_USE_RUI3
             if(xQueueReceive(p_Device.Internal.MessageQueue, &Dummy, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
             {
-                return RAK3172_ERR_TIMEOUT;
+                Error = RAK3172_ERR_TIMEOUT;
+                goto RAK3172_Init_Error_3;
             }
-            delete Dummy;
+            RAK3172_UART_ReleaseLine(p_Device, Dummy);
         #endif
 
         if(xQueueReceive(p_Device.Internal.MessageQueue, &Dummy, RAK3172_DEFAULT_WAIT_TIMEOUT / portTICK_PERIOD_MS) != pdPASS)
         {
-            return RAK3172_ERR_TIMEOUT;
+            Error = RAK3172_ERR_TIMEOUT;
+            goto RAK3172_Init_Error_3;
         }
 
         // Error during initialization when everything else except 'OK' is received.
-        if(Dummy->find("OK") == std::string::npos)
+        if(strstr(Dummy->Data, "OK") == NULL)
         {
-            return RAK3172_ERR_TIMEOUT;
+            RAK3172_UART_ReleaseLine(p_Device, Dummy);
+
+            Error = RAK3172_ERR_TIMEOUT;
+            goto RAK3172_Init_Error_3;
         }
-        delete Dummy;
+        RAK3172_UART_ReleaseLine(p_Device, Dummy);
     }
 
     if(p_Device.Info != NULL)
     {
-        RAK3172_ERROR_CHECK(RAK3172_GetFWVersion(p_Device, &p_Device.Info->Firmware) | RAK3172_GetSerialNumber(p_Device, &p_Device.Info->Serial));
+        Error = static_cast<RAK3172_Error_t>(RAK3172_GetFWVersion(p_Device, &p_Device.Info->Firmware) | RAK3172_GetSerialNumber(p_Device, &p_Device.Info->Serial));
 
         #ifdef CONFIG_RAK3172_USE_RUI3
-            RAK3172_ERROR_CHECK(RAK3172_GetCLIVersion(p_Device, &p_Device.Info->CLI) | RAK3172_GetAPIVersion(p_Device, &p_Device.Info->API) |
-                                RAK3172_GetModel(p_Device, &p_Device.Info->Model) | RAK3172_GetHWID(p_Device, &p_Device.Info->HWID) |
-                                RAK3172_GetBuildTime(p_Device, &p_Device.Info->BuildTime) | RAK3172_GetRepoInfo(p_Device, &p_Device.Info->RepoInfo));
+            Error = static_cast<RAK3172_Error_t>(Error | RAK3172_GetCLIVersion(p_Device, &p_Device.Info->CLI) | RAK3172_GetAPIVersion(p_Device, &p_Device.Info->API) |
+                                                 RAK3172_GetModel(p_Device, &p_Device.Info->Model) | RAK3172_GetHWID(p_Device, &p_Device.Info->HWID) |
+                                                 RAK3172_GetBuildTime(p_Device, &p_Device.Info->BuildTime) | RAK3172_GetRepoInfo(p_Device, &p_Device.Info->RepoInfo));
         #endif
-    }
 
-    return RAK3172_GetMode(p_Device);
-}
+        if(Error != RAK3172_ERR_OK)
+        {
+            goto RAK3172_Init_Error_3;
+        }
+    }
 
-void RAK3172_Deinit(RAK3172_t& p_Device)
-{
-    if(p_Device.Internal.Handle != NULL)
+    Error = RAK3172_GetMode(p_Device);
+    if(Error != RAK3172_ERR_OK)
     {
-        vTaskSuspend(p_Device.Internal.Handle);
-        vTaskDelete(p_Device.Internal.Handle);
+        goto RAK3172_Init_Error_3;
     }
 
-    RAK3172_UART_Deinit(p_Device);
+    return RAK3172_ERR_OK;
 
-    if(p_Device.Internal.MessageQueue != NULL)
-    {
-        vQueueDelete(p_Device.Internal.MessageQueue);
-    }
+    // Release the resources of the previous steps in the reverse order, so that a new initialization starts from scratch.
+RAK3172_Init_Error_3:
+    #ifdef CONFIG_RAK3172_COMMAND_ASYNC
+        RAK3172_Commands_StopAsync(p_Device);
+    #endif
+    RAK3172_FreeResources(p_Device);
 
-    if(p_Device.Internal.ReceiveQueue != NULL)
-    {
-        vQueueDelete(p_Device.Internal.ReceiveQueue);
-    }
+RAK3172_Init_Error_2:
+    RAK3172_Trace_Deinit(p_Device);
 
-    if(p_Device.Internal.RxBuffer != NULL)
+RAK3172_Init_Error_1:
+    RAK3172_Lock_Deinit(p_Device);
+
+    return Error;
+}
+
+RAK3172_Error_t RAK3172_Deinit(RAK3172_t& p_Device)
+{
+    #ifdef CONFIG_RAK3172_COMMAND_ASYNC
+        RAK3172_ERROR_CHECK(RAK3172_Commands_StopAsync(p_Device));
+    #endif
+
+    // Wait for the command of another task before the resources are released. The lock must not be deleted while
+    // another task holds it.
+    if(RAK3172_Acquire(p_Device) != RAK3172_ERR_OK)
     {
-        free(p_Device.Internal.RxBuffer);
-        p_Device.Internal.RxBuffer = NULL;
+        return RAK3172_ERR_INVALID_STATE;
     }
 
-    p_Device.Internal.isInitialized = false;
-    p_Device.Internal.isBusy = false;
+    RAK3172_FreeResources(p_Device);
+
+    RAK3172_Release(p_Device);
+    RAK3172_Lock_Deinit(p_Device);
+    RAK3172_Trace_Deinit(p_Device);
+    RAK3172_Capture_Deinit(p_Device);
+
+    return RAK3172_ERR_OK;
 }
 
 RAK3172_Error_t RAK3172_SetBaudrate(RAK3172_t& p_Device, RAK3172_Baud_t Baudrate)
@@ -247,7 +362,7 @@ RAK3172_Error_t RAK3172_SetBaudrate(RAK3172_t& p_Device, RAK3172_Baud_t Baudrate
         return RAK3172_ERR_OK;
     }
 
-    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, "AT+BAUD=" + std::to_string(Baudrate)));
+    RAK3172_ERROR_CHECK(RAK3172_SendCommand(p_Device, RAK3172_Command_Create("AT+BAUD=", Baudrate)));
 
     return RAK3172_UART_SetBaudrate(p_Device, Baudrate);
 }
@@ -272,7 +387,8 @@ RAK3172_Error_t RAK3172_WakeUp(RAK3172_t& p_Device)
 
 RAK3172_Error_t RAK3172_FactoryReset(RAK3172_t& p_Device)
 {
-    std::string Command;
+    RAK3172_Error_t Result;
+    constexpr std::string_view Command = "ATR\r\n";
 
     if(p_Device.Internal.isInitialized == false)
     {
@@ -281,10 +397,17 @@ RAK3172_Error_t RAK3172_FactoryReset(RAK3172_t& p_Device)
 
     RAK3172_LOGI(TAG, "Perform factory reset...");
 
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    RAK3172_InvalidateShadow(p_Device);
+
     p_Device.Internal.isBusy = true;
-    Command = "ATR\r\n";
-    RAK3172_UART_WriteBytes(p_Device, Command.c_str(), Command.length());
-    RAK3172_ERROR_CHECK(RAK3172_ReceiveSplashScreen(p_Device, RAK3172_DEFAULT_WAIT_TIMEOUT));
+    RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size());
+    Result = RAK3172_ReceiveSplashScreen(p_Device, RAK3172_DEFAULT_WAIT_TIMEOUT);
+
+    RAK3172_Release(p_Device);
+
+    RAK3172_ERROR_CHECK(Result);
 
     RAK3172_LOGI(TAG, "     Successful!");
 
@@ -293,7 +416,8 @@ RAK3172_Error_t RAK3172_FactoryReset(RAK3172_t& p_Device)
 
 RAK3172_Error_t RAK3172_SoftReset(RAK3172_t& p_Device, uint32_t Timeout)
 {
-    std::string Command;
+    RAK3172_Error_t Result;
+    constexpr std::string_view Command = "ATZ\r\n";
 
 	if(p_Device.Internal.isInitialized == false)
 	{
@@ -302,13 +426,20 @@ RAK3172_Error_t RAK3172_SoftReset(RAK3172_t& p_Device, uint32_t Timeout)
 
     RAK3172_LOGI(TAG, "Perform software reset...");
 
+    RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+    RAK3172_InvalidateShadow(p_Device);
+
     p_Device.Internal.isBusy = true;
 
     // Reset the module and read back the slash screen because the current state is unclear.
-    Command = "ATZ\r\n";
-    RAK3172_UART_WriteBytes(p_Device, Command.c_str(), Command.length());
+    RAK3172_UART_WriteBytes(p_Device, Command.data(), Command.size());
+
+    Result = RAK3172_ReceiveSplashScreen(p_Device, Timeout * 1000UL);
+
+    RAK3172_Release(p_Device);
 
-    RAK3172_ERROR_CHECK(RAK3172_ReceiveSplashScreen(p_Device, Timeout * 1000UL));
+    RAK3172_ERROR_CHECK(Result);
 
     RAK3172_LOGI(TAG, "     Successful!");
 
@@ -318,16 +449,51 @@ RAK3172_Error_t RAK3172_SoftReset(RAK3172_t& p_Device, uint32_t Timeout)
 #ifdef CONFIG_RAK3172_RESET_USE_HW
     RAK3172_Error_t RAK3172_HardReset(RAK3172_t& p_Device, uint32_t Timeout)
     {
+        RAK3172_Error_t Result;
+
         RAK3172_LOGI(TAG, "Perform hardware reset...");
 
-        RAK3172_ERROR_CHECK(RAK3172_GPIO_HardwareReset(p_Device));
+        RAK3172_ERROR_CHECK(RAK3172_Acquire(p_Device));
+
+        RAK3172_InvalidateShadow(p_Device);
+
+        Result = RAK3172_GPIO_HardwareReset(p_Device);
 
         #ifdef CONFIG_RAK3172_USE_RUI3
-            RAK3172_ERROR_CHECK(RAK3172_ReceiveSplashScreen(p_Device, Timeout * 1000UL));
+            if(Result == RAK3172_ERR_OK)
+            {
+                Result = RAK3172_ReceiveSplashScreen(p_Device, Timeout * 1000UL);
+            }
         #endif
 
+        RAK3172_Release(p_Device);
+
+        RAK3172_ERROR_CHECK(Result);
+
         RAK3172_LOGI(TAG, "     Successful!");
 
         return RAK3172_ERR_OK;
     }
 #endif
+
+RAK3172_Error_t RAK3172_GetStats(const RAK3172_t& p_Device, RAK3172_Stats_t* p_Stats)
+{
+    if(p_Stats == NULL)
+    {
+        return RAK3172_ERR_INVALID_ARG;
+    }
+
+    memcpy(p_Stats, &p_Device.Internal.Stats, sizeof(RAK3172_Stats_t));
+
+    return RAK3172_ERR_OK;
+}
+
+void RAK3172_ResetStats(RAK3172_t& p_Device)
+{
+    memset(&p_Device.Internal.Stats, 0, sizeof(RAK3172_Stats_t));
+}
+
+void RAK3172_InvalidateShadow(const RAK3172_t& p_Device)
+{
+    p_Device.Internal.Shadow.Valid = 0;
+}